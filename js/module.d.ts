@@ -249,12 +249,14 @@ export declare const enum ERenderingMode {
 }
 export declare const Global: IGlobal;
 export declare const Video: IVideo;
+export declare const Profiler: IProfiler;
 export declare const OutputFactory: IOutputFactory;
 export declare const AudioEncoderFactory: IAudioEncoderFactory;
 export declare const VideoEncoderFactory: IVideoEncoderFactory;
 export declare const ServiceFactory: IServiceFactory;
 export declare const InputFactory: IInputFactory;
 export declare const SceneFactory: ISceneFactory;
+export declare const SceneItemFactory: ISceneItemFactory;
 export declare const FilterFactory: IFilterFactory;
 export declare const TransitionFactory: ITransitionFactory;
 export declare const DisplayFactory: IDisplayFactory;
@@ -494,6 +496,7 @@ export interface IInputFactory extends IFactoryTypes {
     createPrivate(id: string, name: string, settings?: ISettings): IInput;
     fromName(name: string): IInput;
     getPublicSources(): IInput[];
+    findSources(id?: string, flags?: ESourceOutputFlags): IInput[];
 }
 export const enum EInteractionFlags {
     None         = 0,
@@ -554,6 +557,61 @@ export interface ISceneFactory {
     create(name: string): IScene;
     createPrivate(name: string): IScene;
     fromName(name: string): IScene;
+    loadCollection(collection: ISceneCollectionInfo): ILoadedSceneCollection;
+}
+export interface ICollectionFilterInfo {
+    id: string;
+    name: string;
+    settings?: ISettings;
+    enabled?: boolean;
+}
+export interface ICollectionInputInfo {
+    id: string;
+    name: string;
+    settings?: ISettings;
+    hotkeys?: ISettings;
+    volume?: number;
+    muted?: boolean;
+    enabled?: boolean;
+    syncOffset?: number;
+    audioMixers?: number;
+    monitoringType?: EMonitoringType;
+    deinterlaceMode?: EDeinterlaceMode;
+    deinterlaceFieldOrder?: EDeinterlaceFieldOrder;
+    filters?: ICollectionFilterInfo[];
+}
+export interface ICollectionSceneItemInfo {
+    source?: string;
+    scene?: string;
+    x?: number;
+    y?: number;
+    scaleX?: number;
+    scaleY?: number;
+    rotation?: number;
+    visible?: boolean;
+    crop?: ICropInfo;
+    streamVisible?: boolean;
+    recordingVisible?: boolean;
+}
+export interface ICollectionSceneInfo {
+    name: string;
+    filters?: ICollectionFilterInfo[];
+    items?: ICollectionSceneItemInfo[];
+}
+export interface ISceneCollectionInfo {
+    inputs?: ICollectionInputInfo[];
+    scenes?: ICollectionSceneInfo[];
+}
+export interface ILoadedSceneCollection {
+    inputs: {
+        input: IInput;
+        filters: IFilter[];
+    }[];
+    scenes: {
+        scene: IScene;
+        filters: IFilter[];
+        items: ISceneItem[];
+    }[];
 }
 export interface IScene extends ISource {
     duplicate(name: string, type: ESceneDupType): IScene;
@@ -594,6 +652,20 @@ export interface ISceneItem {
     deferUpdateBegin(): void;
     deferUpdateEnd(): void;
 }
+export interface ISceneItemTransform {
+    readonly item: ISceneItem;
+    readonly position?: IVec2;
+    readonly scale?: IVec2;
+    readonly rotation?: number;
+    readonly crop?: ICropInfo;
+    readonly bounds?: IVec2;
+    readonly alignment?: EAlignment;
+    readonly boundsAlignment?: number;
+    readonly boundsType?: EBoundsType;
+}
+export interface ISceneItemFactory {
+    applyTransforms(transforms: ISceneItemTransform[]): Required<ISceneItemTransform>[];
+}
 export interface ITransitionFactory extends IFactoryTypes {
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): ITransition;
     createPrivate(id: string, name: string, settings?: ISettings): ITransition;
@@ -672,6 +744,20 @@ export interface IVideo {
     readonly encodedFrames: number;	
 }
 
+export interface ISourceCost {
+    readonly name: string;
+    readonly id: string;
+    readonly type: ESourceType;
+    readonly samples: number;
+    readonly min: number;
+    readonly avg: number;
+    readonly p99: number;
+}
+export interface IProfiler {
+    getSourceCosts(): ISourceCost[];
+    reset(): void;
+    enabled: boolean;
+}
 export interface IAudio {
 }
 export interface IAudioFactory {
@@ -728,4 +814,7 @@ export interface ISourceSize {
     outputFlags: number;
 }
 export declare function getSourcesSize(sourcesNames: string[]): ISourceSize[];
+export declare function setDisplayRenderBudget(key: string, targetFps: number, skipUnchanged?: boolean): void;
+export declare function setDisplayPaused(key: string, paused: boolean): void;
+export declare function markDisplayDirty(key: string): void;
 export declare const NodeObs: any;
@@ -18,6 +18,7 @@ exports.VideoEncoderFactory = obs.VideoEncoder;
 exports.ServiceFactory = obs.Service;
 exports.InputFactory = obs.Input;
 exports.SceneFactory = obs.Scene;
+exports.SceneItemFactory = obs.SceneItem;
 exports.FilterFactory = obs.Filter;
 exports.TransitionFactory = obs.Transition;
 exports.DisplayFactory = obs.Display;
@@ -25,6 +26,7 @@ exports.VolmeterFactory = obs.Volmeter;
 exports.FaderFactory = obs.Fader;
 exports.AudioFactory = obs.Audio;
 exports.Video = obs.Video;
+exports.Profiler = obs.Profiler;
 exports.ModuleFactory = obs.Module;
 exports.IPC = obs.IPC;
 var EDelayFlags;
@@ -86,6 +88,18 @@ function getSourcesSize(sourcesNames) {
     return sourcesSize;
 }
 exports.getSourcesSize = getSourcesSize;
+function setDisplayRenderBudget(key, targetFps, skipUnchanged = false) {
+    obs.OBS_content_setDisplayRenderBudget(key, targetFps, skipUnchanged);
+}
+exports.setDisplayRenderBudget = setDisplayRenderBudget;
+function setDisplayPaused(key, paused) {
+    obs.OBS_content_setDisplayPaused(key, paused);
+}
+exports.setDisplayPaused = setDisplayPaused;
+function markDisplayDirty(key) {
+    obs.OBS_content_markDisplayDirty(key);
+}
+exports.markDisplayDirty = markDisplayDirty;
 if (fs.existsSync(path.resolve(__dirname, `obs64`).replace('app.asar', 'app.asar.unpacked'))) {
     obs.IPC.setServerPath(path.resolve(__dirname, `obs64`).replace('app.asar', 'app.asar.unpacked'), path.resolve(__dirname).replace('app.asar', 'app.asar.unpacked'));
 }
@@ -335,12 +335,14 @@ export const enum ERenderingMode {
 
 export const Global: IGlobal = obs.Global;
 export const Video: IVideo = obs.Video;
+export const Profiler: IProfiler = obs.Profiler;
 export const OutputFactory: IOutputFactory = obs.Output;
 export const AudioEncoderFactory: IAudioEncoderFactory = obs.AudioEncoder;
 export const VideoEncoderFactory: IVideoEncoderFactory = obs.VideoEncoder;
 export const ServiceFactory: IServiceFactory = obs.Service;
 export const InputFactory: IInputFactory = obs.Input;
 export const SceneFactory: ISceneFactory = obs.Scene;
+export const SceneItemFactory: ISceneItemFactory = obs.SceneItem;
 export const FilterFactory: IFilterFactory = obs.Filter;
 export const TransitionFactory: ITransitionFactory = obs.Transition;
 export const DisplayFactory: IDisplayFactory = obs.Display;
@@ -919,6 +921,14 @@ export interface IInputFactory extends IFactoryTypes {
      * Fetches a list of all public input sources available.
      */
     getPublicSources(): IInput[];
+
+    /**
+     * Fetches the public input sources matching a filter, without
+     * fetching the whole set first.
+     * @param id - Optional, only return inputs of this type
+     * @param flags - Optional, only return inputs having all of these output flags
+     */
+    findSources(id?: string, flags?: ESourceOutputFlags): IInput[];
 }
 
 
@@ -1071,6 +1081,81 @@ export interface ISceneFactory {
      * @returns - Returns the instance or null on failure to find the scene
      */
     fromName(name: string): IScene;
+
+    /**
+     * Create every input, filter, scene and scene item of a collection
+     * with a single request to the server
+     * @param collection - Description of the collection to create
+     * @returns - Returns the created objects or null on failure
+     */
+    loadCollection(collection: ISceneCollectionInfo): ILoadedSceneCollection;
+}
+
+/**
+ * Description of a filter created by ISceneFactory.loadCollection
+ */
+export interface ICollectionFilterInfo {
+    id: string;
+    name: string;
+    settings?: ISettings;
+    enabled?: boolean;
+}
+
+/**
+ * Description of an input created by ISceneFactory.loadCollection
+ */
+export interface ICollectionInputInfo {
+    id: string;
+    name: string;
+    settings?: ISettings;
+    hotkeys?: ISettings;
+    volume?: number;
+    muted?: boolean;
+    enabled?: boolean;
+    syncOffset?: number;
+    audioMixers?: number;
+    monitoringType?: EMonitoringType;
+    deinterlaceMode?: EDeinterlaceMode;
+    deinterlaceFieldOrder?: EDeinterlaceFieldOrder;
+    filters?: ICollectionFilterInfo[];
+}
+
+/**
+ * Description of a scene item. Use source to reference an input by name and scene
+ * to reference a scene; a source that names no input falls back to the scenes.
+ */
+export interface ICollectionSceneItemInfo {
+    source?: string;
+    scene?: string;
+    x?: number;
+    y?: number;
+    scaleX?: number;
+    scaleY?: number;
+    rotation?: number;
+    visible?: boolean;
+    crop?: ICropInfo;
+    streamVisible?: boolean;
+    recordingVisible?: boolean;
+}
+
+export interface ICollectionSceneInfo {
+    name: string;
+    filters?: ICollectionFilterInfo[];
+    items?: ICollectionSceneItemInfo[];
+}
+
+export interface ISceneCollectionInfo {
+    inputs?: ICollectionInputInfo[];
+    scenes?: ICollectionSceneInfo[];
+}
+
+/**
+ * Result of ISceneFactory.loadCollection, in description order.
+ * Entries that failed to be created are null.
+ */
+export interface ILoadedSceneCollection {
+    inputs: { input: IInput, filters: IFilter[] }[];
+    scenes: { scene: IScene, filters: IFilter[], items: ISceneItem[] }[];
 }
 
 /**
@@ -1240,6 +1325,32 @@ export interface ISceneItem {
     deferUpdateEnd(): void;
 }
 
+/**
+ * Transform written by {@link ISceneItemFactory.applyTransforms}.
+ * Only the fields that are set are applied to the item.
+ */
+export interface ISceneItemTransform {
+    readonly item: ISceneItem;
+    readonly position?: IVec2;
+    readonly scale?: IVec2;
+    readonly rotation?: number;
+    readonly crop?: ICropInfo;
+    readonly bounds?: IVec2;
+    readonly alignment?: EAlignment;
+    readonly boundsAlignment?: number;
+    readonly boundsType?: EBoundsType;
+}
+
+export interface ISceneItemFactory {
+    /**
+     * Apply the transforms of several items as one update, in a single call.
+     * Items are only re-rendered once every transform is written.
+     * @param transforms - Fields to change, per item
+     * @returns - The resolved transform of each item, in the same order
+     */
+    applyTransforms(transforms: ISceneItemTransform[]): Required<ISceneItemTransform>[];
+}
+
 export interface ITransitionFactory extends IFactoryTypes {
     /**
      * Create a new instance of an ObsTransition
@@ -1534,6 +1645,47 @@ export interface IVideo {
     readonly encodedFrames: number;
 }
 
+/**
+ * Render cost of a source or filter over the last samples, in milliseconds.
+ * Filters include everything they render below them. This is the CPU time
+ * spent submitting the draw calls, the GPU execution time is not measured.
+ */
+export interface ISourceCost {
+    readonly name: string;
+    /**
+     * Empty for the libobs graphics thread scopes, which are reported with the scene type
+     */
+    readonly id: string;
+    readonly type: ESourceType;
+    readonly samples: number;
+    readonly min: number;
+    readonly avg: number;
+    readonly p99: number;
+}
+
+/**
+ * Times the real tick and render paths, nothing is rendered twice, so it is
+ * enabled by default. libobs has no scope per source: tick_sources covers the
+ * video_tick of every source and render_main_texture the canvas with its
+ * scenes, items and filters. Sources drawn by a display are timed on their
+ * own over their last 128 renders. Timings are CPU time on the graphics
+ * thread, not GPU time.
+ */
+export interface IProfiler {
+    /**
+     * Costs of every timed source and scope, most expensive first. Scopes
+     * cover the frames since the previous call or reset.
+     */
+    getSourceCosts(): ISourceCost[];
+
+    /**
+     * Drops every sample taken so far
+     */
+    reset(): void;
+
+    enabled: boolean;
+}
+
 /**
  * This represents a audio_t structure from within libobs
  * For now, only the global context functions are implemented
@@ -1641,6 +1793,35 @@ export function getSourcesSize(sourcesNames: string[]): ISourceSize[] {
     return sourcesSize;
 }
 
+/**
+ * Limits how often a display is redrawn.
+ * @param key Key the display was created with
+ * @param targetFps Frames per second to draw at most, 0 to follow the canvas
+ * @param skipUnchanged Source displays are only redrawn when something visible changed,
+ * and at least once per second for content that can't be observed
+ *
+ * On Windows, displays in a minimized or hidden window also stop rendering.
+ * Other platforms have no occlusion detection, use setDisplayPaused there.
+ */
+export function setDisplayRenderBudget(key: string, targetFps: number, skipUnchanged: boolean = false): void {
+    obs.OBS_content_setDisplayRenderBudget(key, targetFps, skipUnchanged);
+}
+
+/**
+ * Stops or resumes rendering a display, a paused display keeps its last frame.
+ */
+export function setDisplayPaused(key: string, paused: boolean): void {
+    obs.OBS_content_setDisplayPaused(key, paused);
+}
+
+/**
+ * Forces the next redraw of a display that skips unchanged frames,
+ * for changes the display can't observe such as source settings updates.
+ */
+export function markDisplayDirty(key: string): void {
+    obs.OBS_content_markDisplayDirty(key);
+}
+
 // Initialization and other stuff which needs local data.
 if (fs.existsSync(path.resolve(__dirname, `obs64`).replace('app.asar', 'app.asar.unpacked'))) {
     obs.IPC.setServerPath(path.resolve(__dirname, `obs64`).replace('app.asar', 'app.asar.unpacked'), path.resolve(__dirname).replace('app.asar', 'app.asar.unpacked'));
@@ -39,8 +39,8 @@ struct SourceDataInfo
 	std::string setting         = "";
 	bool        settingsChanged = true;
 
-	osn::property_map_t properties;
-	bool                propertiesChanged = true;
+	osn::property_snapshot_t properties;
+	bool                     propertiesChanged = true;
 
 	uint32_t audioMixers        = UINT32_MAX;
 	bool     audioMixersChanged = true;
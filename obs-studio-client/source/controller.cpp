@@ -34,12 +34,21 @@ std::wstring utfWorkingDir = L"";
 #include <psapi.h>
 #include <wchar.h>
 #include <windows.h>
-#else
+#elif defined(__APPLE__)
 #include <signal.h>
 #include <libproc.h>
 #include <iostream>
 #include <spawn.h>
 extern char **environ;
+#else
+#include <climits>
+#include <cstring>
+#include <cstdlib>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char **environ;
 #endif
 
 #ifdef _WIN32
@@ -232,6 +241,53 @@ static void write_pid_file(std::string& pid_path, uint64_t pid)
 	pid_file.write(reinterpret_cast<char*>(&pid), sizeof(pid));
 }
 
+#elif !defined(__APPLE__)
+static std::string get_runtime_directory()
+{
+	const char* runtime = getenv("XDG_RUNTIME_DIR");
+	return (runtime && runtime[0]) ? runtime : "/tmp";
+}
+
+// Relative socket names live in the per-user runtime directory instead of a shared /tmp.
+static std::string get_socket_path(const std::string& uri)
+{
+	if (!uri.empty() && uri[0] == '/')
+		return uri;
+	return get_runtime_directory() + "/" + uri;
+}
+
+// Only a server this client spawned before is killed, never other processes with the same name.
+static void check_pid_file(const std::string& pid_path)
+{
+	std::ifstream pid_file(pid_path, std::ios::binary);
+	pid_t         pid = 0;
+
+	if (!pid_file || !pid_file.read(reinterpret_cast<char*>(&pid), sizeof(pid)) || pid <= 0)
+		return;
+
+	char exe_path[PATH_MAX];
+	std::string link = "/proc/" + std::to_string(pid) + "/exe";
+	ssize_t     len  = readlink(link.c_str(), exe_path, sizeof(exe_path) - 1);
+	if (len <= 0)
+		return;
+	exe_path[len] = '\0';
+
+	char server_path[PATH_MAX];
+	if (realpath(serverBinaryPath.c_str(), server_path) && strcmp(exe_path, server_path) == 0)
+		kill(pid, SIGKILL);
+}
+
+static void write_pid_file(const std::string& pid_path, pid_t pid)
+{
+	std::ofstream pid_file(pid_path, std::ios::binary | std::ios::trunc);
+	if (pid_file)
+		pid_file.write(reinterpret_cast<const char*>(&pid), sizeof(pid));
+}
+
+static bool is_process_alive(pid_t pid)
+{
+	return waitpid(pid, nullptr, WNOHANG) == 0;
+}
 #endif
 
 Controller::Controller() {}
@@ -278,7 +334,7 @@ std::shared_ptr<ipc::client> Controller::host(const std::string& uri)
 		kill(procId, 0, exitcode);
 		return nullptr;
 	}
-#else
+#elif defined(__APPLE__)
 	g_util_osx->setServerWorkingDirectoryPath(workingDirectory);
     pid_t pids[2048];
     int bytes = proc_listpids(PROC_ALL_PIDS, 0, pids, sizeof(pids));
@@ -309,6 +365,38 @@ std::shared_ptr<ipc::client> Controller::host(const std::string& uri)
         kill(pid, SIGKILL);
         return nullptr;
     }
+#else
+	std::string pid_path    = get_runtime_directory() + "/osn-server.pid";
+	std::string socket_path = get_socket_path(uri);
+	check_pid_file(pid_path);
+	remove(socket_path.c_str());
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	if (!workingDirectory.empty())
+		posix_spawn_file_actions_addchdir_np(&actions, workingDirectory.c_str());
+
+	pid_t             pid;
+	std::vector<char> binary_str(serverBinaryPath.c_str(), serverBinaryPath.c_str() + serverBinaryPath.size() + 1);
+	std::vector<char> socket_str(socket_path.c_str(), socket_path.c_str() + socket_path.size() + 1);
+	char*             argv[] = {binary_str.data(), socket_str.data(), NULL};
+
+	int ret = posix_spawn(&pid, serverBinaryPath.c_str(), &actions, NULL, argv, environ);
+	posix_spawn_file_actions_destroy(&actions);
+	if (ret != 0)
+		return nullptr;
+
+	procId = ProcessInfo(uint64_t(pid), uint64_t(pid));
+	write_pid_file(pid_path, pid);
+
+	// Connect
+	std::shared_ptr<ipc::client> cl = connect(socket_path);
+	if (!cl) { // Assume the server broke or was not allowed to run.
+		disconnect();
+		kill(pid, SIGKILL);
+		waitpid(pid, nullptr, 0);
+		return nullptr;
+	}
 #endif
     
 	m_isServer = true;
@@ -332,8 +420,10 @@ std::shared_ptr<ipc::client> Controller::connect(
 			std::string path;
 #ifdef WIN32
 			path = uri;
-#else
+#elif defined(__APPLE__)
 			path = "/tmp/" + uri;
+#else
+			path = get_socket_path(uri);
 #endif
 			cl = ipc::client::create(path);
 		} catch (...) {
@@ -348,6 +438,10 @@ std::shared_ptr<ipc::client> Controller::connect(
 			if (!is_process_alive(procId)) {
 				break;
 			}
+#elif !defined(__APPLE__)
+			if (!is_process_alive(pid_t(procId.id))) {
+				break;
+			}
 #endif
 		}
 
@@ -363,6 +457,7 @@ std::shared_ptr<ipc::client> Controller::connect(
 
 void Controller::disconnect()
 {
+	WriteBehind::GetInstance().stop();
 	if (m_isServer) {
 		m_connection->call_synchronous_helper("System", "Shutdown", {});
 		m_isServer = false;
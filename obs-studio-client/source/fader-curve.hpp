@@ -0,0 +1,188 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Client copy of the fader curves in libobs' obs-audio-controls.c and media-io/audio-math.h.
+// Every step is done in single precision with the same expressions, so the results are
+// bit-exact with what obs_fader_* would return in the server process.
+namespace osn
+{
+	enum class FaderType : int32_t
+	{
+		Cubic = 0,
+		IEC   = 1,
+		Log   = 2,
+	};
+
+	namespace fader_curve
+	{
+		static const float minus_infinity = -std::numeric_limits<float>::infinity();
+
+		static const float log_offset_db  = 6.0f;
+		static const float log_range_db   = 96.0f;
+		static const float log_offset_val = -0.77815125038364363f; // -log10f(log_offset_db)
+		static const float log_range_val  = -2.00860017176191756f; // -log10f(log_range_db + log_offset_db)
+
+		inline float mul_to_db(const float mul)
+		{
+			return (mul == 0.0f) ? minus_infinity : (20.0f * log10f(mul));
+		}
+
+		inline float db_to_mul(const float db)
+		{
+			return std::isfinite((double)db) ? powf(10.0f, db / 20.0f) : 0.0f;
+		}
+
+		inline float cubic_def_to_db(const float def)
+		{
+			if (def == 1.0f)
+				return 0.0f;
+			else if (def <= 0.0f)
+				return minus_infinity;
+
+			return mul_to_db(def * def * def);
+		}
+
+		inline float cubic_db_to_def(const float db)
+		{
+			if (db == 0.0f)
+				return 1.0f;
+			else if (db == minus_infinity)
+				return 0.0f;
+
+			return cbrtf(db_to_mul(db));
+		}
+
+		inline float iec_def_to_db(const float def)
+		{
+			if (def == 1.0f)
+				return 0.0f;
+			else if (def <= 0.0f)
+				return minus_infinity;
+
+			float db;
+			if (def >= 0.75f)
+				db = (def - 1.0f) / 0.25f * 9.0f;
+			else if (def >= 0.5f)
+				db = (def - 0.75f) / 0.25f * 11.0f - 9.0f;
+			else if (def >= 0.3f)
+				db = (def - 0.5f) / 0.2f * 10.0f - 20.0f;
+			else if (def >= 0.15f)
+				db = (def - 0.3f) / 0.15f * 10.0f - 30.0f;
+			else if (def >= 0.075f)
+				db = (def - 0.15f) / 0.075f * 10.0f - 40.0f;
+			else if (def >= 0.025f)
+				db = (def - 0.075f) / 0.05f * 10.0f - 50.0f;
+			else if (def >= 0.001f)
+				db = (def - 0.025f) / 0.025f * 90.0f - 60.0f;
+			else
+				db = minus_infinity;
+
+			return db;
+		}
+
+		inline float iec_db_to_def(const float db)
+		{
+			if (db == 0.0f)
+				return 1.0f;
+			else if (db == minus_infinity)
+				return 0.0f;
+
+			float def;
+			if (db >= -9.0f)
+				def = (db + 9.0f) / 9.0f * 0.25f + 0.75f;
+			else if (db >= -20.0f)
+				def = (db + 20.0f) / 11.0f * 0.25f + 0.5f;
+			else if (db >= -30.0f)
+				def = (db + 30.0f) / 10.0f * 0.2f + 0.3f;
+			else if (db >= -40.0f)
+				def = (db + 40.0f) / 10.0f * 0.15f + 0.15f;
+			else if (db >= -50.0f)
+				def = (db + 50.0f) / 10.0f * 0.075f + 0.075f;
+			else if (db >= -60.0f)
+				def = (db + 60.0f) / 10.0f * 0.05f + 0.025f;
+			else if (db >= -114.0f)
+				def = (db + 150.0f) / 90.0f * 0.025f;
+			else
+				def = 0.0f;
+
+			return def;
+		}
+
+		inline float log_def_to_db(const float def)
+		{
+			if (def >= 1.0f)
+				return 0.0f;
+			else if (def <= 0.0f)
+				return minus_infinity;
+
+			return -(log_range_db + log_offset_db) * powf((log_range_db + log_offset_db) / log_offset_db, -def)
+			       + log_offset_db;
+		}
+
+		inline float log_db_to_def(const float db)
+		{
+			if (db >= 0.0f)
+				return 1.0f;
+			else if (db <= -96.0f)
+				return 0.0f;
+
+			return (-log10f(-db + log_offset_db) - log_range_val) / (log_offset_val - log_range_val);
+		}
+
+		inline float def_to_db(FaderType type, const float def)
+		{
+			switch (type) {
+			case FaderType::IEC:
+				return iec_def_to_db(def);
+			case FaderType::Log:
+				return log_def_to_db(def);
+			default:
+				return cubic_def_to_db(def);
+			}
+		}
+
+		inline float db_to_def(FaderType type, const float db)
+		{
+			switch (type) {
+			case FaderType::IEC:
+				return iec_db_to_def(db);
+			case FaderType::Log:
+				return log_db_to_def(db);
+			default:
+				return cubic_db_to_def(db);
+			}
+		}
+
+		// Same clamping as obs_fader_set_db, anything below the curve's range is silence.
+		inline float clamp_db(FaderType type, const float db)
+		{
+			const float min_db = (type == FaderType::Log) ? -96.0f : minus_infinity;
+
+			if (db > 0.0f)
+				return 0.0f;
+			if (db < min_db)
+				return minus_infinity;
+			return db;
+		}
+	} // namespace fader_curve
+} // namespace osn
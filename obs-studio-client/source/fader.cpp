@@ -18,13 +18,144 @@
 
 #include "fader.hpp"
 #include <iterator>
+#include <map>
+#include <set>
 #include <vector>
 #include "controller.hpp"
 #include "error.hpp"
 #include "input.hpp"
 #include "shared.hpp"
+#include "write-behind.hpp"
 #include <iostream>
 
+struct FaderChange
+{
+	uint64_t uid;
+	float    db;
+};
+
+// Faders by attached source, only touched from the JS thread.
+static std::map<uint64_t, std::set<osn::Fader*>> attachedFaders;
+
+// Live faders by uid, only touched from the JS thread. Changes queued by a worker name the fader by uid, so a
+// change that is delivered after the fader was destroyed finds nothing instead of a dangling pointer.
+static std::map<uint64_t, osn::Fader*> liveFaders;
+
+static void detachFader(osn::Fader* fader)
+{
+	auto iter = attachedFaders.find(fader->sourceId);
+	if (iter != attachedFaders.end()) {
+		iter->second.erase(fader);
+		if (iter->second.empty())
+			attachedFaders.erase(iter);
+	}
+	fader->sourceId = UINT64_MAX;
+}
+
+void osn::Fader::SourceVolumeChanged(uint64_t sourceId, float mul, osn::Fader* origin)
+{
+	auto iter = attachedFaders.find(sourceId);
+	if (iter == attachedFaders.end())
+		return;
+
+	// The fader that set the volume ignores its own signal, see obs_fader_set_db
+	const float db = fader_curve::mul_to_db(mul);
+	for (osn::Fader* fader : iter->second) {
+		if (fader != origin)
+			fader->db = db;
+	}
+}
+
+void osn::Fader::set_db(float value)
+{
+	this->db = fader_curve::clamp_db(this->type, value);
+
+	WriteBehind::GetInstance().set("Fader", "SetDeziBel", this->uid, {ipc::value(this->uid), ipc::value(this->db)});
+
+	if (this->sourceId != UINT64_MAX)
+		SourceVolumeChanged(this->sourceId, fader_curve::db_to_mul(this->db), this);
+}
+
+void osn::Fader::start_worker(napi_env env, Napi::Function async_callback)
+{
+	if (!worker_stop)
+		return;
+
+	worker_stop = false;
+	js_thread = Napi::ThreadSafeFunction::New(
+      env,
+      async_callback,
+      "Fader",
+      0,
+      1,
+      []( Napi::Env ) {} );
+	worker_thread = new std::thread(&osn::Fader::worker, this);
+}
+
+void osn::Fader::stop_worker(void)
+{
+	if (worker_stop != false)
+		return;
+
+	worker_stop = true;
+	if (worker_thread->joinable()) {
+		worker_thread->join();
+	}
+	delete worker_thread;
+	worker_thread = nullptr;
+}
+
+void osn::Fader::worker()
+{
+	// Runs on the JS thread, so the mirrored value is only ever written from there
+	auto callback = []( Napi::Env env, Napi::Function jsCallback, FaderChange* data ) {
+		auto iter = liveFaders.find(data->uid);
+		if (iter != liveFaders.end()) {
+			iter->second->db = data->db;
+			jsCallback.Call({ Napi::Number::New(env, data->db) });
+		}
+		delete data;
+	};
+	uint64_t sequence     = 0;
+	size_t   totalSleepMS = 0;
+
+	while (!worker_stop) {
+		auto tp_start = std::chrono::high_resolution_clock::now();
+
+		auto conn = Controller::GetInstance().GetConnection();
+		if (!conn) {
+			goto do_sleep;
+		}
+
+		try {
+			std::vector<ipc::value> response = conn->call_synchronous_helper(
+			    "Fader",
+			    "Query",
+			    {
+			        ipc::value(this->uid),
+			    });
+			if (response.size() < 3 || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok) {
+				goto do_sleep;
+			}
+
+			// Volume changes made by anything other than this fader bump the sequence
+			if (response[1].value_union.ui64 != sequence) {
+				sequence = response[1].value_union.ui64;
+				js_thread.BlockingCall(new FaderChange{this->uid, response[2].value_union.fp32}, callback);
+			}
+		} catch (std::exception e) {
+			goto do_sleep;
+		}
+
+	do_sleep:
+		auto tp_end  = std::chrono::high_resolution_clock::now();
+		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
+		totalSleepMS = dur.count() < sleepIntervalMS ? sleepIntervalMS - dur.count() : 0;
+		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
+	}
+	js_thread.Release();
+}
+
 Napi::FunctionReference osn::Fader::constructor;
 
 Napi::Object osn::Fader::Init(Napi::Env env, Napi::Object exports) {
@@ -56,12 +187,24 @@ osn::Fader::Fader(const Napi::CallbackInfo& info)
 	Napi::HandleScope scope(env);
 	int length = info.Length();
 
-	if (length <= 0 || !info[0].IsNumber()) {
+	if (length <= 1 || !info[0].IsNumber() || !info[1].IsNumber()) {
 		Napi::TypeError::New(env, "Number expected").ThrowAsJavaScriptException();
 		return;
 	}
 
-	this->uid = (uint64_t)info[0].ToNumber().Int64Value();
+	this->uid  = (uint64_t)info[0].ToNumber().Int64Value();
+	this->type = (FaderType)info[1].ToNumber().Int32Value();
+	liveFaders[this->uid] = this;
+}
+
+osn::Fader::~Fader()
+{
+	stop_worker();
+	detachFader(this);
+
+	auto iter = liveFaders.find(this->uid);
+	if (iter != liveFaders.end() && iter->second == this)
+		liveFaders.erase(iter);
 }
 
 Napi::Value osn::Fader::Create(const Napi::CallbackInfo& info)
@@ -84,7 +227,8 @@ Napi::Value osn::Fader::Create(const Napi::CallbackInfo& info)
 
 	auto instance =
 		osn::Fader::constructor.New({
-			Napi::Number::New(info.Env(), response[1].value_union.ui64)
+			Napi::Number::New(info.Env(), response[1].value_union.ui64),
+			Napi::Number::New(info.Env(), fader_type)
 			});
 
 	return instance;
@@ -92,92 +236,32 @@ Napi::Value osn::Fader::Create(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Fader::GetDeziBel(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-		"Fader",
-		"GetDeziBel",
-		{
-			ipc::value(this->uid),
-		});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	return Napi::Number::New(Env(), response[1].value_union.fp32);
+	return Napi::Number::New(Env(), this->db);
 }
 
 void osn::Fader::SetDezibel(const Napi::CallbackInfo& info, const Napi::Value &value)
 {
-	float_t db = value.ToNumber().FloatValue();
-
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("Fader", "SetDeziBel", {ipc::value(this->uid), ipc::value(db)});
+	set_db(value.ToNumber().FloatValue());
 }
 
 Napi::Value osn::Fader::GetDeflection(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-		"Fader",
-		"GetDeflection",
-		{
-			ipc::value(this->uid),
-		});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-    return Napi::Number::New(Env(), response[1].value_union.fp32);
+	return Napi::Number::New(Env(), fader_curve::db_to_def(this->type, this->db));
 }
 
 void osn::Fader::SetDeflection(const Napi::CallbackInfo& info, const Napi::Value &value)
 {
-	float_t deflection = value.ToNumber().FloatValue();
-
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("Fader", "SetDeflection", {ipc::value(this->uid), ipc::value(deflection)});
+	set_db(fader_curve::def_to_db(this->type, value.ToNumber().FloatValue()));
 }
 
 Napi::Value osn::Fader::GetMultiplier(const Napi::CallbackInfo& info)
 {
-    auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-		"Fader",
-		"GetMultiplier",
-		{
-			ipc::value(this->uid),
-		});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-    return Napi::Number::New(Env(), response[1].value_union.fp32);
+	return Napi::Number::New(Env(), fader_curve::db_to_mul(this->db));
 }
 
 void osn::Fader::SetMultiplier(const Napi::CallbackInfo& info, const Napi::Value &value)
 {
-	float_t mul = value.ToNumber().FloatValue();
-
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("Fader", "SetMultiplier", {ipc::value(this->uid), ipc::value(mul)});
+	set_db(fader_curve::mul_to_db(value.ToNumber().FloatValue()));
 }
 
 Napi::Value osn::Fader::Attach(const Napi::CallbackInfo& info)
@@ -194,6 +278,12 @@ Napi::Value osn::Fader::Attach(const Napi::CallbackInfo& info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
+	// Attaching takes over the volume of the source
+	detachFader(this);
+	this->db       = response[1].value_union.fp32;
+	this->sourceId = input->sourceId;
+	attachedFaders[this->sourceId].insert(this);
+
 	return info.Env().Undefined();
 }
 
@@ -209,43 +299,45 @@ Napi::Value osn::Fader::Detach(const Napi::CallbackInfo& info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
+	detachFader(this);
 	return info.Env().Undefined();
 }
 
 Napi::Value osn::Fader::AddCallback(const Napi::CallbackInfo& info)
 {
-	//obs::fader &handle = Fader::Object::GetHandle(info.Holder());
-	//Fader* binding = Nan::ObjectWrap::Unwrap<Fader>(info.Holder());
+	Napi::Function async_callback = info[0].As<Napi::Function>();
 
-	//ASSERT_INFO_LENGTH(info, 1);
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
 
-	//v8::Local<v8::Function> callback;
-	//ASSERT_GET_VALUE(info[0], callback);
+	std::vector<ipc::value> response =
+		conn->call_synchronous_helper("Fader", "AddCallback", {ipc::value(this->uid)});
 
-	//FaderCallback *cb_binding =
-	//	new FaderCallback(binding, Fader::Callback, callback);
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
 
-	//handle.add_callback(fader_cb_wrapper, cb_binding);
+	start_worker(info.Env(), async_callback);
+	isWorkerRunning = true;
 
-	//auto object = FaderCallback::Object::GenerateObject(cb_binding);
-	//cb_binding->obj_ref.Reset(object);
-	//info.GetReturnValue().Set(object);
-    return info.Env().Undefined();
+	return Napi::Boolean::New(info.Env(), true);
 }
 
 Napi::Value osn::Fader::RemoveCallback(const Napi::CallbackInfo& info)
 {
-	//obs::fader &handle = Fader::Object::GetHandle(info.Holder());
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
 
-	//v8::Local<v8::Object> cb_object;
-	//ASSERT_GET_VALUE(info[0], cb_object);
+	std::vector<ipc::value> response =
+		conn->call_synchronous_helper("Fader", "RemoveCallback", {ipc::value(this->uid)});
 
-	//FaderCallback *cb_binding =
-	//	FaderCallback::Object::GetHandle(cb_object);
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
 
-	//cb_binding->stopped = true;
+	if (isWorkerRunning)
+		stop_worker();
+	isWorkerRunning = false;
 
-	//handle.remove_callback(fader_cb_wrapper, cb_binding);
-	//cb_binding->obj_ref.Reset();
-    return info.Env().Undefined();
-}
\ No newline at end of file
+	return Napi::Boolean::New(info.Env(), true);
+}
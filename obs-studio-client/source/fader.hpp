@@ -18,6 +18,7 @@
 
 #pragma once
 #include <napi.h>
+#include "fader-curve.hpp"
 #include "utility.hpp"
 #include <thread>
 
@@ -28,10 +29,31 @@ namespace osn
 		public:
 		uint64_t uid;
 
+		// Mirror of the server fader, conversions are done locally and only the resulting dB is sent
+		FaderType type;
+		float     db       = 0.0f;
+		uint64_t  sourceId = UINT64_MAX;
+
+		bool                     isWorkerRunning = false;
+		bool                     worker_stop     = true;
+		uint32_t                 sleepIntervalMS = 33;
+		std::thread*             worker_thread   = nullptr;
+		Napi::ThreadSafeFunction js_thread;
+
+		void worker(void);
+		void start_worker(napi_env env, Napi::Function async_callback);
+		void stop_worker(void);
+
+		void set_db(float value);
+
 		public:
 		static Napi::FunctionReference constructor;
 		static Napi::Object Init(Napi::Env env, Napi::Object exports);
 		Fader(const Napi::CallbackInfo& info);
+		~Fader();
+
+		// Updates the mirrored dB of every fader attached to the source, like the "volume" signal does.
+		static void SourceVolumeChanged(uint64_t sourceId, float mul, osn::Fader* origin = nullptr);
 
 		static Napi::Value Create(const Napi::CallbackInfo& info);
 
@@ -24,6 +24,7 @@
 #include <iterator>
 #include "controller.hpp"
 #include "error.hpp"
+#include "fader.hpp"
 #include "filter.hpp"
 #include "ipc-value.hpp"
 #include "shared.hpp"
@@ -42,6 +43,7 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports) {
 			StaticMethod("createPrivate", &osn::Input::CreatePrivate),
 			StaticMethod("fromName", &osn::Input::FromName),
 			StaticMethod("getPublicSources", &osn::Input::GetPublicSources),
+			StaticMethod("findSources", &osn::Input::FindSources),
 
 			InstanceMethod("duplicate", &osn::Input::Duplicate),
 			InstanceMethod("addFilter", &osn::Input::AddFilter),
@@ -278,13 +280,48 @@ Napi::Value osn::Input::GetPublicSources(const Napi::CallbackInfo& info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	Napi::Array arr = Napi::Array::New(info.Env(), int(response.size() - 1));
-	for (size_t idx = 1; idx < response.size(); idx++) {
+	const std::vector<char>& ids   = response[1].value_bin;
+	const uint64_t*          uids  = reinterpret_cast<const uint64_t*>(ids.data());
+	size_t                   count = ids.size() / sizeof(uint64_t);
+
+	Napi::Array arr = Napi::Array::New(info.Env(), count);
+	for (size_t idx = 0; idx < count; idx++) {
 		auto object =
 			osn::Input::constructor.New({
-				Napi::Number::New(info.Env(), response[idx - 1].value_union.ui64)
+				Napi::Number::New(info.Env(), uids[idx])
 				});
-		arr[uint32_t(idx)] = object;
+		arr.Set(uint32_t(idx), object);
+	}
+
+	return arr;
+}
+
+Napi::Value osn::Input::FindSources(const Napi::CallbackInfo& info)
+{
+	std::string id    = info.Length() > 0 && info[0].IsString() ? info[0].ToString().Utf8Value() : "";
+	uint32_t    flags = info.Length() > 1 && info[1].IsNumber() ? info[1].ToNumber().Uint32Value() : 0;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Input", "FindSources", {ipc::value(id), ipc::value(flags)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	const std::vector<char>& ids   = response[1].value_bin;
+	const uint64_t*          uids  = reinterpret_cast<const uint64_t*>(ids.data());
+	size_t                   count = ids.size() / sizeof(uint64_t);
+
+	Napi::Array arr = Napi::Array::New(info.Env(), count);
+	for (size_t idx = 0; idx < count; idx++) {
+		auto object =
+			osn::Input::constructor.New({
+				Napi::Number::New(info.Env(), uids[idx])
+				});
+		arr.Set(uint32_t(idx), object);
 	}
 
 	return arr;
@@ -403,11 +440,15 @@ Napi::Value osn::Input::GetVolume(const Napi::CallbackInfo& info)
 
 void osn::Input::SetVolume(const Napi::CallbackInfo& info, const Napi::Value &value)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
+	float_t volume = value.ToNumber().FloatValue();
 
-	conn->call("Input", "SetVolume", {ipc::value((uint64_t)this->sourceId), ipc::value(value.ToNumber().FloatValue())});
+	WriteBehind::GetInstance().set(
+	    "Input",
+	    "SetVolume",
+	    this->sourceId,
+	    {ipc::value((uint64_t)this->sourceId), ipc::value(volume)});
+
+	osn::Fader::SourceVolumeChanged(this->sourceId, volume);
 }
 
 Napi::Value osn::Input::GetSyncOffset(const Napi::CallbackInfo& info)
@@ -595,18 +636,22 @@ Napi::Value osn::Input::Filters(const Napi::CallbackInfo& info)
 		filters->clear();
 	}
 
-	Napi::Array array = Napi::Array::New(info.Env(), response.size() - 1);
-	for (size_t idx = 1; idx < response.size(); idx++) {
+	const std::vector<char>& ids   = response[1].value_bin;
+	const uint64_t*          uids  = reinterpret_cast<const uint64_t*>(ids.data());
+	size_t                   count = ids.size() / sizeof(uint64_t);
+
+	Napi::Array array = Napi::Array::New(info.Env(), count);
+	for (size_t idx = 0; idx < count; idx++) {
 		auto instance =
 			osn::Filter::constructor.New({
-				Napi::Number::New(info.Env(), response[idx].value_union.ui64)
+				Napi::Number::New(info.Env(), uids[idx])
 				});
-		array.Set(uint32_t(idx) - 1, instance);
-
-		if (sdi)
-			filters->push_back(response[idx].value_union.ui64);
+		array.Set(uint32_t(idx), instance);
 	}
 
+	if (sdi)
+		filters->assign(uids, uids + count);
+
 	if (sdi)
 		sdi->filtersOrderChanged = false;
 
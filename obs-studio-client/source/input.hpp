@@ -38,6 +38,7 @@ namespace osn
 		static Napi::Value CreatePrivate(const Napi::CallbackInfo& info);
 		static Napi::Value FromName(const Napi::CallbackInfo& info);
 		static Napi::Value GetPublicSources(const Napi::CallbackInfo& info);
+		static Napi::Value FindSources(const Napi::CallbackInfo& info);
 
 		Napi::Value Duplicate(const Napi::CallbackInfo& info);
 		Napi::Value AddFilter(const Napi::CallbackInfo& info);
@@ -74,9 +74,9 @@ Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t
 	SourceDataInfo* sdi =
 		CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
 
-	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0) {
-		std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(sdi->properties);
-		auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
+	if (sdi && !sdi->propertiesChanged && sdi->properties && sdi->properties->size() > 0) {
+		// The constructor takes its own reference to the shared snapshot
+		auto prop_ptr = Napi::External<property_snapshot_t>::New(info.Env(), &sdi->properties);
 		auto instance =
 			osn::Properties::constructor.New({
 				prop_ptr,
@@ -98,7 +98,7 @@ Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t
 	if (response.size() == 1)
 		return info.Env().Null();
 
-	osn::property_map_t pmap;
+	auto pmap = std::make_shared<osn::property_map_t>();
 	for (size_t idx = 1; idx < response.size(); ++idx) {
 		auto raw_property = obs::Property::deserialize(response[idx].value_bin);
 
@@ -266,16 +266,16 @@ Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t
 			pr->enabled          = raw_property->enabled;
 			pr->visible          = raw_property->visible;
 
-			pmap.emplace(idx - 1, pr);
+			pmap->emplace(idx - 1, pr);
 		}
 	}
 
+	property_snapshot_t snapshot = std::move(pmap);
 	if (sdi) {
-		sdi->properties        = pmap;
+		sdi->properties        = snapshot;
 		sdi->propertiesChanged = false;
 	}
-	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
+	auto prop_ptr = Napi::External<property_snapshot_t>::New(info.Env(), &snapshot);
 	auto instance =
 		osn::Properties::constructor.New({
 			prop_ptr,
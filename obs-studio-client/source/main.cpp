@@ -29,6 +29,7 @@
 #include "input.hpp"
 #include "module.hpp"
 #include "nodeobs_api.hpp"
+#include "profiler.hpp"
 #include "properties.hpp"
 #include "scene.hpp"
 #include "sceneitem.hpp"
@@ -98,6 +99,7 @@ Napi::Object main_node(Napi::Env env, Napi::Object exports) {
 	osn::PropertyObject::Init(env, exports);
 	osn::Filter::Init(env, exports);
 	osn::Global::Init(env, exports);
+	osn::Profiler::Init(env, exports);
 	osn::Scene::Init(env, exports);
 	osn::SceneItem::Init(env, exports);
 	osn::Transition::Init(env, exports);
@@ -19,6 +19,7 @@
 #include "controller.hpp"
 #include "error.hpp"
 #include "nodeobs_api.hpp"
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include "shared.hpp"
@@ -136,9 +137,178 @@ Napi::Value api::OBS_API_getPerformanceStatistics(const Napi::CallbackInfo& info
 		Napi::String::New(info.Env(), "diskSpaceAvailable"),
 		Napi::String::New(info.Env(),diskSpaceAvailable));
 
+	if (response.size() >= 17) {
+		statistics.Set(
+			Napi::String::New(info.Env(), "recordingStarts"),
+			Napi::Number::New(info.Env(), double(response[12].value_union.ui64)));
+		statistics.Set(
+			Napi::String::New(info.Env(), "recordingWarmStarts"),
+			Napi::Number::New(info.Env(), double(response[13].value_union.ui64)));
+		statistics.Set(
+			Napi::String::New(info.Env(), "recordingStartTime"),
+			Napi::Number::New(info.Env(), response[14].value_union.fp64));
+		statistics.Set(
+			Napi::String::New(info.Env(), "recordingStartTimeAverage"),
+			Napi::Number::New(info.Env(), response[15].value_union.fp64));
+		statistics.Set(
+			Napi::String::New(info.Env(), "recordingStartTimeMax"),
+			Napi::Number::New(info.Env(), response[16].value_union.fp64));
+	}
+
 	return statistics;
 }
 
+Napi::Value api::OBS_API_getPerformanceSamples(const Napi::CallbackInfo& info)
+{
+	uint64_t sequence = 0;
+	if (info.Length() > 0 && info[0].IsNumber())
+		sequence = uint64_t(info[0].ToNumber().Int64Value());
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("API", "OBS_API_getPerformanceSamples", {ipc::value(sequence)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	static const size_t fields = 13;
+	uint32_t            count  = response[2].value_union.ui32;
+	if (response.size() < 3 + count * fields)
+		return info.Env().Undefined();
+
+	Napi::Array samples = Napi::Array::New(info.Env(), count);
+	for (uint32_t idx = 0; idx < count; idx++) {
+		const ipc::value* values = &response[3 + idx * fields];
+		Napi::Object      sample = Napi::Object::New(info.Env());
+
+		sample.Set("sequence", Napi::Number::New(info.Env(), double(values[0].value_union.ui64)));
+		sample.Set("timestamp", Napi::Number::New(info.Env(), double(values[1].value_union.ui64) / 1000000.0));
+		sample.Set("CPU", Napi::Number::New(info.Env(), values[2].value_union.fp64));
+		sample.Set("numberDroppedFrames", Napi::Number::New(info.Env(), values[3].value_union.i32));
+		sample.Set("percentageDroppedFrames", Napi::Number::New(info.Env(), values[4].value_union.fp64));
+		sample.Set("streamingBandwidth", Napi::Number::New(info.Env(), values[5].value_union.fp64));
+		sample.Set("streamingDataOutput", Napi::Number::New(info.Env(), values[6].value_union.fp64));
+		sample.Set("recordingBandwidth", Napi::Number::New(info.Env(), values[7].value_union.fp64));
+		sample.Set("recordingDataOutput", Napi::Number::New(info.Env(), values[8].value_union.fp64));
+		sample.Set("frameRate", Napi::Number::New(info.Env(), values[9].value_union.fp64));
+		sample.Set("averageTimeToRenderFrame", Napi::Number::New(info.Env(), values[10].value_union.fp64));
+		sample.Set("memoryUsage", Napi::Number::New(info.Env(), values[11].value_union.fp64));
+		sample.Set("diskSpaceAvailable", Napi::Number::New(info.Env(), double(values[12].value_union.ui64)));
+		samples.Set(idx, sample);
+	}
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("sequence", Napi::Number::New(info.Env(), double(response[1].value_union.ui64)));
+	result.Set("samples", samples);
+	return result;
+}
+
+Napi::Value api::OBS_API_getOutputSamples(const Napi::CallbackInfo& info)
+{
+	uint64_t sequence = 0;
+	if (info.Length() > 0 && info[0].IsNumber())
+		sequence = uint64_t(info[0].ToNumber().Int64Value());
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("API", "OBS_API_getOutputSamples", {ipc::value(sequence)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	// Same order as the outputs reported by the server
+	static const char*  names[]       = {"streaming", "recording", "replayBuffer", "virtualWebcam"};
+	static const size_t output_fields = 10;
+
+	uint32_t count   = response[2].value_union.ui32;
+	uint32_t outputs = std::min<uint32_t>(response[3].value_union.ui32, sizeof(names) / sizeof(names[0]));
+	size_t   fields  = 2 + response[3].value_union.ui32 * output_fields;
+	if (response.size() < 4 + count * fields)
+		return info.Env().Undefined();
+
+	Napi::Array samples = Napi::Array::New(info.Env(), count);
+	for (uint32_t idx = 0; idx < count; idx++) {
+		const ipc::value* values = &response[4 + idx * fields];
+		Napi::Object      sample = Napi::Object::New(info.Env());
+
+		sample.Set("sequence", Napi::Number::New(info.Env(), double(values[0].value_union.ui64)));
+		sample.Set("timestamp", Napi::Number::New(info.Env(), double(values[1].value_union.ui64) / 1000000.0));
+
+		for (uint32_t out = 0; out < outputs; out++) {
+			const ipc::value* stats  = &values[2 + out * output_fields];
+			Napi::Object      output = Napi::Object::New(info.Env());
+
+			output.Set("active", Napi::Boolean::New(info.Env(), stats[0].value_union.ui32));
+			output.Set("reconnecting", Napi::Boolean::New(info.Env(), stats[1].value_union.ui32));
+			output.Set("bytes", Napi::Number::New(info.Env(), double(stats[2].value_union.ui64)));
+			output.Set("bitrate", Napi::Number::New(info.Env(), stats[3].value_union.fp64));
+			output.Set("droppedFrames", Napi::Number::New(info.Env(), stats[4].value_union.i32));
+			output.Set("totalFrames", Napi::Number::New(info.Env(), stats[5].value_union.i32));
+			output.Set("congestion", Napi::Number::New(info.Env(), stats[6].value_union.fp64));
+			output.Set("connectTime", Napi::Number::New(info.Env(), stats[7].value_union.i32));
+			output.Set("reconnects", Napi::Number::New(info.Env(), stats[8].value_union.ui32));
+			output.Set("skippedFrames", Napi::Number::New(info.Env(), stats[9].value_union.ui32));
+			sample.Set(names[out], output);
+		}
+		samples.Set(idx, sample);
+	}
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("sequence", Napi::Number::New(info.Env(), double(response[1].value_union.ui64)));
+	result.Set("samples", samples);
+	return result;
+}
+
+Napi::Value api::OBS_API_getMediaCacheStats(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_getMediaCacheStats", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object stats = Napi::Object::New(info.Env());
+
+	stats.Set(
+		Napi::String::New(info.Env(), "totalMemory"),
+		Napi::Number::New(info.Env(), double(response[1].value_union.ui64)));
+	stats.Set(
+		Napi::String::New(info.Env(), "availableMemory"),
+		Napi::Number::New(info.Env(), double(response[2].value_union.ui64)));
+	stats.Set(
+		Napi::String::New(info.Env(), "processMemory"),
+		Napi::Number::New(info.Env(), double(response[3].value_union.ui64)));
+	stats.Set(
+		Napi::String::New(info.Env(), "cacheBudget"),
+		Napi::Number::New(info.Env(), double(response[4].value_union.ui64)));
+	stats.Set(
+		Napi::String::New(info.Env(), "cachedSize"),
+		Napi::Number::New(info.Env(), double(response[5].value_union.ui64)));
+	stats.Set(
+		Napi::String::New(info.Env(), "trackedSources"),
+		Napi::Number::New(info.Env(), response[6].value_union.ui32));
+	stats.Set(
+		Napi::String::New(info.Env(), "cachedSources"),
+		Napi::Number::New(info.Env(), response[7].value_union.ui32));
+	stats.Set(
+		Napi::String::New(info.Env(), "evictions"),
+		Napi::Number::New(info.Env(), double(response[8].value_union.ui64)));
+	stats.Set(
+		Napi::String::New(info.Env(), "readmissions"),
+		Napi::Number::New(info.Env(), double(response[9].value_union.ui64)));
+
+	return stats;
+}
+
 Napi::Value api::SetWorkingDirectory(const Napi::CallbackInfo& info)
 {
 	std::string path = info[0].ToString().Utf8Value();
@@ -314,6 +484,9 @@ void api::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(Napi::String::New(env, "OBS_API_initAPI"), Napi::Function::New(env, api::OBS_API_initAPI));
 	exports.Set(Napi::String::New(env, "OBS_API_destroyOBS_API"), Napi::Function::New(env, api::OBS_API_destroyOBS_API));
 	exports.Set(Napi::String::New(env, "OBS_API_getPerformanceStatistics"), Napi::Function::New(env, api::OBS_API_getPerformanceStatistics));
+	exports.Set(Napi::String::New(env, "OBS_API_getPerformanceSamples"), Napi::Function::New(env, api::OBS_API_getPerformanceSamples));
+	exports.Set(Napi::String::New(env, "OBS_API_getOutputSamples"), Napi::Function::New(env, api::OBS_API_getOutputSamples));
+	exports.Set(Napi::String::New(env, "OBS_API_getMediaCacheStats"), Napi::Function::New(env, api::OBS_API_getMediaCacheStats));
 	exports.Set(Napi::String::New(env, "SetWorkingDirectory"), Napi::Function::New(env, api::SetWorkingDirectory));
 	exports.Set(Napi::String::New(env, "InitShutdownSequence"), Napi::Function::New(env, api::InitShutdownSequence));
 	exports.Set(Napi::String::New(env, "OBS_API_QueryHotkeys"), Napi::Function::New(env, api::OBS_API_QueryHotkeys));
@@ -34,6 +34,9 @@ namespace api
 	Napi::Value OBS_API_initAPI(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_destroyOBS_API(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_getPerformanceStatistics(const Napi::CallbackInfo& info);
+	Napi::Value OBS_API_getPerformanceSamples(const Napi::CallbackInfo& info);
+	Napi::Value OBS_API_getOutputSamples(const Napi::CallbackInfo& info);
+	Napi::Value OBS_API_getMediaCacheStats(const Napi::CallbackInfo& info);
 	Napi::Value SetWorkingDirectory(const Napi::CallbackInfo& info);
 	Napi::Value InitShutdownSequence(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_QueryHotkeys(const Napi::CallbackInfo& info);
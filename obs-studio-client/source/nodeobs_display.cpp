@@ -22,11 +22,23 @@
 #include "utility-v8.hpp"
 
 #include <node.h>
+#include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include "shared-frame.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
+// Displays rendered into shared memory, mapped in this process. The ArrayBuffers handed to JS
+// keep their mapping alive until they are collected, even once the display is destroyed.
+struct SharedDisplay
+{
+	shared_frame::mapping memory;
+	shared_frame::reader  reader;
+};
+static std::map<std::string, std::shared_ptr<SharedDisplay>> sharedDisplays;
+
 #ifdef WIN32
 static BOOL CALLBACK EnumChromeWindowsProc(HWND hwnd, LPARAM lParam)
 {
@@ -83,6 +95,7 @@ Napi::Value display::OBS_content_destroyDisplay(const Napi::CallbackInfo& info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	sharedDisplays.erase(key);
     conn->call("Display", "OBS_content_destroyDisplay", {ipc::value(key)});
 	return info.Env().Undefined();
 }
@@ -155,11 +168,8 @@ Napi::Value display::OBS_content_resizeDisplay(const Napi::CallbackInfo& info)
 	uint32_t width = info[1].ToNumber().Uint32Value();
 	uint32_t height = info[2].ToNumber().Uint32Value();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	conn->call("Display", "OBS_content_resizeDisplay", {ipc::value(key), ipc::value(width), ipc::value(height)});
+	WriteBehind::GetInstance().set(
+	    "Display", "OBS_content_resizeDisplay", key, {ipc::value(key), ipc::value(width), ipc::value(height)});
 
 	return info.Env().Undefined();
 }
@@ -170,11 +180,8 @@ Napi::Value display::OBS_content_moveDisplay(const Napi::CallbackInfo& info)
 	uint32_t x = info[1].ToNumber().Uint32Value();
 	uint32_t y = info[2].ToNumber().Uint32Value();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	conn->call("Display", "OBS_content_moveDisplay", {ipc::value(key), ipc::value(x), ipc::value(y)});
+	WriteBehind::GetInstance().set(
+	    "Display", "OBS_content_moveDisplay", key, {ipc::value(key), ipc::value(x), ipc::value(y)});
 	return info.Env().Undefined();
 }
 
@@ -257,6 +264,49 @@ Napi::Value display::OBS_content_setDrawGuideLines(const Napi::CallbackInfo& inf
 	return info.Env().Undefined();
 }
 
+Napi::Value display::OBS_content_setDisplayRenderBudget(const Napi::CallbackInfo& info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+	uint32_t targetFps = info[1].ToNumber().Uint32Value();
+	bool skipUnchanged = false;
+
+	if (info.Length() > 2)
+		skipUnchanged = info[2].ToBoolean().Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Display", "OBS_content_setDisplayRenderBudget",
+	    {ipc::value(key), ipc::value(targetFps), ipc::value(skipUnchanged)});
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_setDisplayPaused(const Napi::CallbackInfo& info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+	bool paused = info[1].ToBoolean().Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Display", "OBS_content_setDisplayPaused", {ipc::value(key), ipc::value(paused)});
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_markDisplayDirty(const Napi::CallbackInfo& info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Display", "OBS_content_markDisplayDirty", {ipc::value(key)});
+	return info.Env().Undefined();
+}
+
 Napi::Value display::OBS_content_createIOSurface(const Napi::CallbackInfo& info)
 {
 	std::string key = info[0].ToString().Utf8Value();
@@ -274,6 +324,78 @@ Napi::Value display::OBS_content_createIOSurface(const Napi::CallbackInfo& info)
 	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
 }
 
+Napi::Value display::OBS_content_createSharedMemoryDisplay(const Napi::CallbackInfo& info)
+{
+	std::string key        = info[0].ToString().Utf8Value();
+	uint32_t    maxWidth   = info[1].ToNumber().Uint32Value();
+	uint32_t    maxHeight  = info[2].ToNumber().Uint32Value();
+	int32_t     mode       = 0;
+	std::string sourceName = "";
+
+	if (info.Length() > 3)
+		mode = info[3].ToNumber().Int32Value();
+	if (info.Length() > 4 && info[4].IsString())
+		sourceName = info[4].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Display",
+	    "OBS_content_createSharedMemoryDisplay",
+	    {ipc::value(key), ipc::value(sourceName), ipc::value(maxWidth), ipc::value(maxHeight), ipc::value(mode)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	auto shared = std::make_shared<SharedDisplay>();
+	if (!shared->memory.open(response[1].value_str) || !shared->reader.init(shared->memory)) {
+		conn->call("Display", "OBS_content_destroyDisplay", {ipc::value(key)});
+		Napi::Error::New(info.Env(), "Failed to map the shared memory of display " + key)
+		    .ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+	sharedDisplays[key] = shared;
+
+	return Napi::ArrayBuffer::New(
+	    info.Env(),
+	    shared->memory.data(),
+	    shared->memory.size(),
+	    [](Napi::Env, void*, std::shared_ptr<SharedDisplay>* hint) { delete hint; },
+	    new std::shared_ptr<SharedDisplay>(shared));
+}
+
+Napi::Value display::OBS_content_acquireSharedMemoryFrame(const Napi::CallbackInfo& info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+
+	auto found = sharedDisplays.find(key);
+	if (found == sharedDisplays.end())
+		return info.Env().Undefined();
+
+	shared_frame::rect        dirty;
+	const shared_frame::slot* slot = found->second->reader.acquire(dirty);
+	if (!slot)
+		return info.Env().Null();
+
+	Napi::Object dirtyObj = Napi::Object::New(info.Env());
+	dirtyObj.Set("x", Napi::Number::New(info.Env(), dirty.x));
+	dirtyObj.Set("y", Napi::Number::New(info.Env(), dirty.y));
+	dirtyObj.Set("width", Napi::Number::New(info.Env(), dirty.width));
+	dirtyObj.Set("height", Napi::Number::New(info.Env(), dirty.height));
+
+	Napi::Object frame = Napi::Object::New(info.Env());
+	frame.Set("frame", Napi::Number::New(info.Env(), double(slot->frame)));
+	frame.Set("timestamp", Napi::Number::New(info.Env(), double(slot->timestamp) / 1000000.0));
+	frame.Set("width", Napi::Number::New(info.Env(), slot->width));
+	frame.Set("height", Napi::Number::New(info.Env(), slot->height));
+	frame.Set("stride", Napi::Number::New(info.Env(), slot->stride));
+	frame.Set("offset", Napi::Number::New(info.Env(), double(slot->offset)));
+	frame.Set("dirty", dirtyObj);
+	return frame;
+}
+
 void display::Init(Napi::Env env, Napi::Object exports)
 {
 	exports.Set(
@@ -309,6 +431,21 @@ void display::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(
 		Napi::String::New(env, "OBS_content_setDrawGuideLines"),
 		Napi::Function::New(env, display::OBS_content_setDrawGuideLines));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_setDisplayRenderBudget"),
+		Napi::Function::New(env, display::OBS_content_setDisplayRenderBudget));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_setDisplayPaused"),
+		Napi::Function::New(env, display::OBS_content_setDisplayPaused));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_markDisplayDirty"),
+		Napi::Function::New(env, display::OBS_content_markDisplayDirty));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_createSharedMemoryDisplay"),
+		Napi::Function::New(env, display::OBS_content_createSharedMemoryDisplay));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_acquireSharedMemoryFrame"),
+		Napi::Function::New(env, display::OBS_content_acquireSharedMemoryFrame));
 	exports.Set(
 		Napi::String::New(env, "OBS_content_createIOSurface"),
 		Napi::Function::New(env, display::OBS_content_createIOSurface));
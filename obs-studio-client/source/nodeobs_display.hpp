@@ -34,5 +34,10 @@ namespace display
 	Napi::Value OBS_content_setOutlineColor(const Napi::CallbackInfo& info);
 	Napi::Value OBS_content_setShouldDrawUI(const Napi::CallbackInfo& info);
 	Napi::Value OBS_content_setDrawGuideLines(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_setDisplayRenderBudget(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_setDisplayPaused(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_markDisplayDirty(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_createSharedMemoryDisplay(const Napi::CallbackInfo& info);
+	Napi::Value OBS_content_acquireSharedMemoryFrame(const Napi::CallbackInfo& info);
 	Napi::Value OBS_content_createIOSurface(const Napi::CallbackInfo& info);
 }
@@ -164,6 +164,57 @@ Napi::Value service::OBS_service_stopReplayBuffer(const Napi::CallbackInfo& info
 	return info.Env().Undefined();
 }
 
+Napi::Value service::OBS_service_setRecordingPrewarm(const Napi::CallbackInfo& info)
+{
+	bool enabled = info[0].ToBoolean().Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Service", "OBS_service_setRecordingPrewarm", {ipc::value(enabled)});
+
+	ValidateResponse(info, response);
+	return info.Env().Undefined();
+}
+
+Napi::Value service::OBS_service_getEncoderPlan(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "OBS_service_getEncoderPlan", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	uint32_t    outputs = response[1].value_union.ui32;
+	Napi::Array plan    = Napi::Array::New(info.Env(), outputs);
+
+	size_t idx = 2;
+	for (uint32_t i = 0; i < outputs; i++) {
+		Napi::Object output = Napi::Object::New(info.Env());
+		output.Set("output", Napi::String::New(info.Env(), response[idx++].value_str));
+		output.Set("active", Napi::Boolean::New(info.Env(), response[idx++].value_union.ui32));
+
+		uint32_t    count    = response[idx++].value_union.ui32;
+		Napi::Array encoders = Napi::Array::New(info.Env(), count);
+		for (uint32_t j = 0; j < count; j++) {
+			Napi::Object encoder = Napi::Object::New(info.Env());
+			encoder.Set("type", Napi::String::New(info.Env(), response[idx++].value_str));
+			encoder.Set("name", Napi::String::New(info.Env(), response[idx++].value_str));
+			encoder.Set("fingerprint", Napi::String::New(info.Env(), response[idx++].value_str));
+			encoders.Set(j, encoder);
+		}
+		output.Set("encoders", encoders);
+		plan.Set(i, output);
+	}
+
+	return plan;
+}
+
 static v8::Persistent<v8::Object> serviceCallbackObject;
 
 Napi::Value service::OBS_service_connectOutputSignals(const Napi::CallbackInfo& info)
@@ -387,6 +438,12 @@ void service::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(
 		Napi::String::New(env, "OBS_service_stopReplayBuffer"),
 		Napi::Function::New(env, service::OBS_service_stopReplayBuffer));
+	exports.Set(
+		Napi::String::New(env, "OBS_service_setRecordingPrewarm"),
+		Napi::Function::New(env, service::OBS_service_setRecordingPrewarm));
+	exports.Set(
+		Napi::String::New(env, "OBS_service_getEncoderPlan"),
+		Napi::Function::New(env, service::OBS_service_getEncoderPlan));
 	exports.Set(
 		Napi::String::New(env, "OBS_service_connectOutputSignals"),
 		Napi::Function::New(env, service::OBS_service_connectOutputSignals));
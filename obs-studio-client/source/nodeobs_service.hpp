@@ -54,6 +54,8 @@ namespace service
 	Napi::Value OBS_service_stopStreaming(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_stopRecording(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_stopReplayBuffer(const Napi::CallbackInfo& info);
+	Napi::Value OBS_service_setRecordingPrewarm(const Napi::CallbackInfo& info);
+	Napi::Value OBS_service_getEncoderPlan(const Napi::CallbackInfo& info);
 
 	Napi::Value OBS_service_connectOutputSignals(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_removeCallback(const Napi::CallbackInfo& info);
@@ -0,0 +1,115 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "profiler.hpp"
+#include <ipc-value.hpp>
+#include "controller.hpp"
+#include "error.hpp"
+#include "utility-v8.hpp"
+
+Napi::FunctionReference osn::Profiler::constructor;
+
+Napi::Object osn::Profiler::Init(Napi::Env env, Napi::Object exports) {
+	Napi::HandleScope scope(env);
+	Napi::Function func =
+		DefineClass(env,
+		"Profiler",
+		{
+			StaticMethod("getSourceCosts", &osn::Profiler::getSourceCosts),
+			StaticMethod("reset", &osn::Profiler::reset),
+
+			StaticAccessor("enabled", &osn::Profiler::getEnabled, &osn::Profiler::setEnabled),
+		});
+	exports.Set("Profiler", func);
+	osn::Profiler::constructor = Napi::Persistent(func);
+	osn::Profiler::constructor.SuppressDestruct();
+	return exports;
+}
+
+osn::Profiler::Profiler(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<osn::Profiler>(info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+}
+
+Napi::Value osn::Profiler::getSourceCosts(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Profiler", "GetSourceCosts", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	static const size_t fields = 7;
+	uint32_t            count  = response[1].value_union.ui32;
+	if (response.size() < 2 + count * fields)
+		return info.Env().Undefined();
+
+	Napi::Array costs = Napi::Array::New(info.Env(), count);
+	for (uint32_t idx = 0; idx < count; idx++) {
+		const ipc::value* values = &response[2 + idx * fields];
+		Napi::Object      cost   = Napi::Object::New(info.Env());
+
+		cost.Set("name", Napi::String::New(info.Env(), values[0].value_str));
+		cost.Set("id", Napi::String::New(info.Env(), values[1].value_str));
+		cost.Set("type", Napi::Number::New(info.Env(), values[2].value_union.ui32));
+		cost.Set("samples", Napi::Number::New(info.Env(), values[3].value_union.ui32));
+		cost.Set("min", Napi::Number::New(info.Env(), values[4].value_union.fp64));
+		cost.Set("avg", Napi::Number::New(info.Env(), values[5].value_union.fp64));
+		cost.Set("p99", Napi::Number::New(info.Env(), values[6].value_union.fp64));
+		costs.Set(idx, cost);
+	}
+
+	return costs;
+}
+
+Napi::Value osn::Profiler::reset(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Profiler", "Reset", {});
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Profiler::getEnabled(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Profiler", "GetEnabled", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Boolean::New(info.Env(), response[1].value_union.i32);
+}
+
+void osn::Profiler::setEnabled(const Napi::CallbackInfo& info, const Napi::Value &value)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	conn->call("Profiler", "SetEnabled", {ipc::value(value.ToBoolean().Value())});
+}
@@ -20,7 +20,7 @@
 #include "isource.hpp"
 #include "utility-v8.hpp"
 
-std::shared_ptr<osn::property_map_t> osn::Properties::GetProperties()
+osn::property_snapshot_t osn::Properties::GetProperties()
 {
 	return properties;
 }
@@ -47,7 +47,7 @@ osn::Properties::Properties(const Napi::CallbackInfo& info)
     : Napi::ObjectWrap<osn::Properties>(info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
-	this->properties = std::make_shared<property_map_t>(*info[0].As<const Napi::External<property_map_t>>().Data());
+	this->properties = *info[0].As<const Napi::External<property_snapshot_t>>().Data();
 	this->sourceId = (uint64_t)info[1].ToNumber().Uint32Value();
 }
 
@@ -154,6 +154,7 @@ osn::PropertyObject::PropertyObject(const Napi::CallbackInfo& info)
 	Napi::Env env = info.Env();
 	Napi::HandleScope scope(env);
 	this->parent = Napi::ObjectWrap<osn::Properties>::Unwrap(info[0].ToObject());
+	this->parentRef = Napi::Persistent(info[0].ToObject());
 	this->index = (uint64_t)info[1].ToNumber().Uint32Value();
 }
 
@@ -178,7 +179,7 @@ Napi::Value osn::PropertyObject::Previous(const Napi::CallbackInfo& info)
 
 	auto instance =
 		osn::PropertyObject::constructor.New({
-			parent->Get(info), Napi::Number::New(info.Env(), (uint32_t)iter->first)
+			self->parentRef.Value(), Napi::Number::New(info.Env(), (uint32_t)iter->first)
 			});
 	return instance;
 }
@@ -201,12 +202,9 @@ Napi::Value osn::PropertyObject::Next(const Napi::CallbackInfo& info)
 	if (iter == parent->GetProperties()->end())
 		return info.Env().Undefined();
 
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), parent->properties.get());
-	auto obj = osn::Properties::constructor.New( {prop_ptr, Napi::Number::New(info.Env(), (uint32_t)parent->sourceId) });
-
 	auto instance =
 		osn::PropertyObject::constructor.New({
-			obj, Napi::Number::New(info.Env(), (uint32_t)iter->first)
+			self->parentRef.Value(), Napi::Number::New(info.Env(), (uint32_t)iter->first)
 			});
 	return instance;
 }
@@ -236,7 +234,7 @@ Napi::Value osn::PropertyObject::IsLast(const Napi::CallbackInfo& info)
 	if (!parent)
 		return info.Env().Undefined();
 
-	auto iter = property_map_t::reverse_iterator(parent->GetProperties()->find(self->index));
+	auto iter = property_map_t::const_reverse_iterator(parent->GetProperties()->find(self->index));
 	return Napi::Boolean::New(info.Env(), iter == parent->GetProperties()->rbegin());
 }
 
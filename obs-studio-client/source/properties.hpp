@@ -195,15 +195,18 @@ namespace osn
 	// This is a class that basically implements the OBS behavior.
 	typedef std::map<size_t, std::shared_ptr<Property>> property_map_t;
 
+	// Properties are never modified once received, every JS object of the same schema shares one snapshot.
+	typedef std::shared_ptr<const property_map_t> property_snapshot_t;
+
 	// The actual classes that work with JavaScript
 	class Properties : public Napi::ObjectWrap<osn::Properties>
 	{
 		public:
-		std::shared_ptr<property_map_t> properties;
+		property_snapshot_t properties;
 		uint64_t sourceId;
 
 		public:
-		std::shared_ptr<property_map_t> GetProperties();
+		property_snapshot_t GetProperties();
 		static Napi::FunctionReference constructor;
 		static Napi::Object Init(Napi::Env env, Napi::Object exports);
 		Properties(const Napi::CallbackInfo& info);
@@ -217,6 +220,7 @@ namespace osn
 	class PropertyObject : public Napi::ObjectWrap<osn::PropertyObject>
 	{
 		osn::Properties* parent;
+		Napi::ObjectReference parentRef; // Keeps the parent and its snapshot alive
 		uint32_t index;
 
 		public:
@@ -22,6 +22,7 @@
 #include <string>
 #include "controller.hpp"
 #include "error.hpp"
+#include "filter.hpp"
 #include "input.hpp"
 #include "ipc-value.hpp"
 #include "sceneitem.hpp"
@@ -39,6 +40,7 @@ Napi::Object osn::Scene::Init(Napi::Env env, Napi::Object exports) {
 			StaticMethod("create", &osn::Scene::Create),
 			StaticMethod("createPrivate", &osn::Scene::CreatePrivate),
 			StaticMethod("fromName", &osn::Scene::FromName),
+			StaticMethod("loadCollection", &osn::Scene::LoadCollection),
 
 			InstanceAccessor("source", &osn::Scene::AsSource, nullptr),
 
@@ -193,6 +195,192 @@ Napi::Value osn::Scene::FromName(const Napi::CallbackInfo& info)
     return instance;
 }
 
+static inline Napi::Value ReadCollectionFilters(
+    const Napi::Env& env, const Napi::Object& desc, const uint64_t*& cursor, const uint64_t* end, SourceDataInfo* parent)
+{
+	if (cursor >= end)
+		return Napi::Array::New(env);
+
+	uint64_t    count   = *cursor++;
+	Napi::Array descs   = desc.Has("filters") ? desc.Get("filters").As<Napi::Array>() : Napi::Array::New(env);
+	Napi::Array filters = Napi::Array::New(env);
+
+	if (parent)
+		parent->filters->clear();
+
+	for (uint64_t idx = 0; idx < count && cursor < end; idx++) {
+		uint64_t uid = *cursor++;
+		if (uid == UINT64_MAX) {
+			filters.Set(uint32_t(idx), env.Null());
+			continue;
+		}
+
+		Napi::Object    fdesc = descs.Get(uint32_t(idx)).ToObject();
+		SourceDataInfo* sdi   = new SourceDataInfo;
+		sdi->name             = fdesc.Get("name").ToString().Utf8Value();
+		sdi->obs_sourceId     = fdesc.Get("id").ToString().Utf8Value();
+		sdi->id               = uid;
+		CacheManager<SourceDataInfo*>::getInstance().Store(uid, sdi->name, sdi);
+
+		if (parent)
+			parent->filters->push_back(uid);
+
+		filters.Set(uint32_t(idx), osn::Filter::constructor.New({Napi::Number::New(env, uid)}));
+	}
+
+	if (parent)
+		parent->filtersOrderChanged = false;
+
+	return filters;
+}
+
+Napi::Value osn::Scene::LoadCollection(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 1 || !info[0].IsObject()) {
+		Napi::TypeError::New(info.Env(), "Object expected").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	Napi::Env    env        = info.Env();
+	Napi::Object collection = info[0].ToObject();
+	Napi::Object json       = env.Global().Get("JSON").As<Napi::Object>();
+	std::string  desc       = json.Get("stringify").As<Napi::Function>().Call(json, {collection}).ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return env.Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("SceneCollection", "Load", std::vector<ipc::value>{ipc::value(desc)});
+
+	if (!ValidateResponse(info, response))
+		return env.Undefined();
+
+	const std::vector<char>& blob   = response[1].value_bin;
+	const uint64_t*          cursor = reinterpret_cast<const uint64_t*>(blob.data());
+	const uint64_t*          end    = cursor + blob.size() / sizeof(uint64_t);
+
+	Napi::Array inputDescs = collection.Has("inputs") ? collection.Get("inputs").As<Napi::Array>() : Napi::Array::New(env);
+	Napi::Array sceneDescs = collection.Has("scenes") ? collection.Get("scenes").As<Napi::Array>() : Napi::Array::New(env);
+	Napi::Array inputs     = Napi::Array::New(env);
+	Napi::Array scenes     = Napi::Array::New(env);
+
+	for (uint32_t idx = 0; idx < inputDescs.Length() && cursor + 1 < end; idx++) {
+		Napi::Object idesc       = inputDescs.Get(idx).ToObject();
+		uint64_t     uid         = *cursor++;
+		uint32_t     audioMixers = uint32_t(*cursor++);
+
+		SourceDataInfo* sdi = nullptr;
+		if (uid != UINT64_MAX) {
+			sdi               = new SourceDataInfo;
+			sdi->name         = idesc.Get("name").ToString().Utf8Value();
+			sdi->obs_sourceId = idesc.Get("id").ToString().Utf8Value();
+			sdi->id           = uid;
+			sdi->audioMixers  = audioMixers;
+			sdi->audioMixersChanged = false;
+			CacheManager<SourceDataInfo*>::getInstance().Store(uid, sdi->name, sdi);
+		}
+
+		Napi::Object entry = Napi::Object::New(env);
+		entry.Set("input", sdi ? osn::Input::constructor.New({Napi::Number::New(env, uid)}) : env.Null());
+		entry.Set("filters", ReadCollectionFilters(env, idesc, cursor, end, sdi));
+		inputs.Set(idx, entry);
+	}
+
+	for (uint32_t idx = 0; idx < sceneDescs.Length() && cursor < end; idx++) {
+		Napi::Object sdesc = sceneDescs.Get(idx).ToObject();
+		std::string  name  = sdesc.Get("name").ToString().Utf8Value();
+		uint64_t     uid   = *cursor++;
+
+		SourceDataInfo* sdi = nullptr;
+		SceneInfo*      si  = nullptr;
+		if (uid != UINT64_MAX) {
+			si                = new SceneInfo();
+			si->name          = name;
+			si->id            = uid;
+			sdi               = new SourceDataInfo;
+			sdi->name         = name;
+			sdi->obs_sourceId = "scene";
+			sdi->id           = uid;
+			CacheManager<SourceDataInfo*>::getInstance().Store(uid, name, sdi);
+			CacheManager<SceneInfo*>::getInstance().Store(uid, name, si);
+		}
+
+		Napi::Object entry = Napi::Object::New(env);
+		entry.Set("scene", si ? osn::Scene::constructor.New({Napi::Number::New(env, uid)}) : env.Null());
+		entry.Set("filters", ReadCollectionFilters(env, sdesc, cursor, end, sdi));
+
+		uint64_t    count      = cursor < end ? *cursor++ : 0;
+		Napi::Array itemDescs  = sdesc.Has("items") ? sdesc.Get("items").As<Napi::Array>() : Napi::Array::New(env);
+		Napi::Array items      = Napi::Array::New(env);
+		for (uint32_t item = 0; item < count && cursor + 1 < end; item++) {
+			uint64_t itemId = *cursor++;
+			int64_t  obsId  = int64_t(*cursor++);
+			if (itemId == UINT64_MAX) {
+				items.Set(item, env.Null());
+				continue;
+			}
+
+			if (si)
+				si->items.push_back(std::make_pair(obsId, itemId));
+
+			Napi::Object   tdesc = itemDescs.Get(item).ToObject();
+			SceneItemData* sid   = new SceneItemData;
+			sid->obs_itemId      = obsId;
+			sid->scene_id        = uid;
+
+			// Only the fields that were sent are known, everything else is fetched lazily.
+			if (tdesc.Has("x") && tdesc.Has("y")) {
+				sid->posX       = tdesc.Get("x").ToNumber().FloatValue();
+				sid->posY       = tdesc.Get("y").ToNumber().FloatValue();
+				sid->posChanged = false;
+			}
+			if (tdesc.Has("scaleX") && tdesc.Has("scaleY")) {
+				sid->scaleX       = tdesc.Get("scaleX").ToNumber().FloatValue();
+				sid->scaleY       = tdesc.Get("scaleY").ToNumber().FloatValue();
+				sid->scaleChanged = false;
+			}
+			if (tdesc.Has("visible")) {
+				sid->isVisible      = tdesc.Get("visible").ToBoolean().Value();
+				sid->visibleChanged = false;
+			}
+			if (tdesc.Has("rotation")) {
+				sid->rotation        = tdesc.Get("rotation").ToNumber().FloatValue();
+				sid->rotationChanged = false;
+			}
+			if (tdesc.Has("crop")) {
+				Napi::Object crop = tdesc.Get("crop").ToObject();
+				sid->cropLeft     = crop.Get("left").ToNumber().Int32Value();
+				sid->cropTop      = crop.Get("top").ToNumber().Int32Value();
+				sid->cropRight    = crop.Get("right").ToNumber().Int32Value();
+				sid->cropBottom   = crop.Get("bottom").ToNumber().Int32Value();
+				sid->cropChanged  = false;
+			}
+			if (tdesc.Has("streamVisible")) {
+				sid->isStreamVisible      = tdesc.Get("streamVisible").ToBoolean().Value();
+				sid->streamVisibleChanged = false;
+			}
+			if (tdesc.Has("recordingVisible")) {
+				sid->isRecordingVisible      = tdesc.Get("recordingVisible").ToBoolean().Value();
+				sid->recordingVisibleChanged = false;
+			}
+			CacheManager<SceneItemData*>::getInstance().Store(itemId, sid);
+
+			items.Set(item, osn::SceneItem::constructor.New({Napi::Number::New(env, itemId)}));
+		}
+		if (si)
+			si->itemsOrderCached = true;
+
+		entry.Set("items", items);
+		scenes.Set(idx, entry);
+	}
+
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("inputs", inputs);
+	result.Set("scenes", scenes);
+	return result;
+}
+
 Napi::Value osn::Scene::Release(const Napi::CallbackInfo& info)
 {
 	auto conn = GetConnection(info);
@@ -540,21 +728,26 @@ Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo& info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	Napi::Array array = Napi::Array::New(info.Env(), int((response.size()) - 1)/2);
-	size_t index = 0;
-	for (size_t i = 1; i < response.size(); i++) {
+	// Pairs of (uid, obs item id).
+	const std::vector<char>& ids   = response[1].value_bin;
+	const uint64_t*          pairs = reinterpret_cast<const uint64_t*>(ids.data());
+	size_t                   count = ids.size() / (2 * sizeof(uint64_t));
+
+	Napi::Array array = Napi::Array::New(info.Env(), count);
+	for (size_t index = 0; index < count; index++) {
 		auto instance =
 			osn::SceneItem::constructor.New({
-				Napi::Number::New(info.Env(), response[i++].value_union.ui64)
+				Napi::Number::New(info.Env(), pairs[index * 2])
 				});
-		array.Set(uint32_t(index++), instance);
+		array.Set(uint32_t(index), instance);
 	}
 
 	if (si) {
 		si->items.clear();
+		si->items.reserve(count);
 
-		for (size_t i = 1; i < response.size(); i+= 2) {
-			si->items.push_back(std::make_pair(response[i + 1].value_union.i64, response[i].value_union.ui64));
+		for (size_t index = 0; index < count; index++) {
+			si->items.push_back(std::make_pair(int64_t(pairs[index * 2 + 1]), pairs[index * 2]));
 		}
 
 		si->itemsOrderCached = true;
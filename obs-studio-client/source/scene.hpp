@@ -36,6 +36,7 @@ namespace osn
 		static Napi::Value Create(const Napi::CallbackInfo& info);
 		static Napi::Value CreatePrivate(const Napi::CallbackInfo& info);
 		static Napi::Value FromName(const Napi::CallbackInfo& info);
+		static Napi::Value LoadCollection(const Napi::CallbackInfo& info);
 
 		Napi::Value Release(const Napi::CallbackInfo& info);
 		Napi::Value Remove(const Napi::CallbackInfo& info);
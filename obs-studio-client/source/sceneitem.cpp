@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include <condition_variable>
+#include <cstring>
 #include <mutex>
 #include <string>
 
@@ -25,6 +26,7 @@
 #include "input.hpp"
 #include "ipc-value.hpp"
 #include "scene.hpp"
+#include "sceneitem-transform.hpp"
 #include "sceneitem.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
@@ -63,6 +65,8 @@ Napi::Object osn::SceneItem::Init(Napi::Env env, Napi::Object exports) {
 			InstanceMethod("remove", &osn::SceneItem::Remove),
 			InstanceMethod("deferUpdateBegin", &osn::SceneItem::DeferUpdateBegin),
 			InstanceMethod("deferUpdateEnd", &osn::SceneItem::DeferUpdateEnd),
+
+			StaticMethod("applyTransforms", &osn::SceneItem::ApplyTransforms),
 		});
 	exports.Set("SceneItem", func);
 	osn::SceneItem::constructor = Napi::Persistent(func);
@@ -393,14 +397,13 @@ void osn::SceneItem::SetPosition(const Napi::CallbackInfo& info, const Napi::Val
 	if (sid && x == sid->posX && y == sid->posY)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
+	WriteBehind::GetInstance().set(
+	    "SceneItem", "SetPosition", this->itemId, {ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
 
-	conn->call("SceneItem", "SetPosition", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
-
-	sid->posX = x;
-	sid->posY = y;
+	if (sid) {
+		sid->posX = x;
+		sid->posY = y;
+	}
 }
 
 Napi::Value osn::SceneItem::GetRotation(const Napi::CallbackInfo& info)
@@ -436,13 +439,11 @@ void osn::SceneItem::SetRotation(const Napi::CallbackInfo& info, const Napi::Val
 	if (sid && vector == sid->rotation)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetRotation", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(vector)});
+	WriteBehind::GetInstance().set(
+	    "SceneItem", "SetRotation", this->itemId, {ipc::value(this->itemId), ipc::value(vector)});
 
-	sid->rotation = vector;
+	if (sid)
+		sid->rotation = vector;
 }
 
 Napi::Value osn::SceneItem::GetScale(const Napi::CallbackInfo& info)
@@ -490,14 +491,13 @@ void osn::SceneItem::SetScale(const Napi::CallbackInfo& info, const Napi::Value
 	if (sid && x == sid->scaleX && y == sid->scaleY)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetScale", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
+	WriteBehind::GetInstance().set(
+	    "SceneItem", "SetScale", this->itemId, {ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
 
-	sid->scaleX = x;
-	sid->scaleY = y;
+	if (sid) {
+		sid->scaleX = x;
+		sid->scaleY = y;
+	}
 }
 
 Napi::Value osn::SceneItem::GetScaleFilter(const Napi::CallbackInfo& info)
@@ -876,3 +876,147 @@ Napi::Value osn::SceneItem::DeferUpdateEnd(const Napi::CallbackInfo& info)
 	conn->call("SceneItem", "DeferUpdateEnd", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
+
+Napi::Value osn::SceneItem::ApplyTransforms(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 1 || !info[0].IsArray()) {
+		Napi::TypeError::New(info.Env(), "Array expected").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	Napi::Array                              array = info[0].As<Napi::Array>();
+	std::vector<sceneitem_transform::record> records(array.Length());
+	std::vector<Napi::Object>                items(array.Length());
+
+	for (uint32_t idx = 0; idx < array.Length(); idx++) {
+		Napi::Object entry = array.Get(idx).ToObject();
+		Napi::Value  item  = entry.Get("item");
+		if (!item.IsObject() || !item.ToObject().InstanceOf(osn::SceneItem::constructor.Value())) {
+			Napi::TypeError::New(info.Env(), "SceneItem expected").ThrowAsJavaScriptException();
+			return info.Env().Undefined();
+		}
+		items[idx] = item.ToObject();
+
+		sceneitem_transform::record& rec = records[idx];
+		memset(&rec, 0, sizeof(rec));
+		rec.id = Napi::ObjectWrap<osn::SceneItem>::Unwrap(items[idx])->itemId;
+
+		if (entry.Has("position")) {
+			Napi::Object position = entry.Get("position").ToObject();
+			rec.mask |= sceneitem_transform::Position;
+			rec.position_x = position.Get("x").ToNumber().FloatValue();
+			rec.position_y = position.Get("y").ToNumber().FloatValue();
+		}
+		if (entry.Has("scale")) {
+			Napi::Object scale = entry.Get("scale").ToObject();
+			rec.mask |= sceneitem_transform::Scale;
+			rec.scale_x = scale.Get("x").ToNumber().FloatValue();
+			rec.scale_y = scale.Get("y").ToNumber().FloatValue();
+		}
+		if (entry.Has("rotation")) {
+			rec.mask |= sceneitem_transform::Rotation;
+			rec.rotation = entry.Get("rotation").ToNumber().FloatValue();
+		}
+		if (entry.Has("crop")) {
+			Napi::Object crop = entry.Get("crop").ToObject();
+			rec.mask |= sceneitem_transform::Crop;
+			rec.crop_left   = crop.Get("left").ToNumber().Int32Value();
+			rec.crop_top    = crop.Get("top").ToNumber().Int32Value();
+			rec.crop_right  = crop.Get("right").ToNumber().Int32Value();
+			rec.crop_bottom = crop.Get("bottom").ToNumber().Int32Value();
+		}
+		if (entry.Has("bounds")) {
+			Napi::Object bounds = entry.Get("bounds").ToObject();
+			rec.mask |= sceneitem_transform::Bounds;
+			rec.bounds_x = bounds.Get("x").ToNumber().FloatValue();
+			rec.bounds_y = bounds.Get("y").ToNumber().FloatValue();
+		}
+		if (entry.Has("alignment")) {
+			rec.mask |= sceneitem_transform::Alignment;
+			rec.alignment = entry.Get("alignment").ToNumber().Uint32Value();
+		}
+		if (entry.Has("boundsAlignment")) {
+			rec.mask |= sceneitem_transform::BoundsAlignment;
+			rec.bounds_alignment = entry.Get("boundsAlignment").ToNumber().Uint32Value();
+		}
+		if (entry.Has("boundsType")) {
+			rec.mask |= sceneitem_transform::BoundsType;
+			rec.bounds_type = entry.Get("boundsType").ToNumber().Int32Value();
+		}
+	}
+
+	std::vector<char> packed(records.size() * sizeof(sceneitem_transform::record));
+	if (!records.empty())
+		memcpy(packed.data(), records.data(), packed.size());
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("SceneItem", "ApplyTransforms", std::vector<ipc::value>{ipc::value(packed)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	const std::vector<char>& resolved = response[1].value_bin;
+	if (resolved.size() != packed.size())
+		return info.Env().Undefined();
+	if (!records.empty())
+		memcpy(records.data(), resolved.data(), resolved.size());
+
+	Napi::Array result = Napi::Array::New(info.Env(), records.size());
+	for (uint32_t idx = 0; idx < records.size(); idx++) {
+		const sceneitem_transform::record& rec = records[idx];
+
+		// The reply is authoritative, so it refreshes the cached transform of every item it touched.
+		SceneItemData* sid = CacheManager<SceneItemData*>::getInstance().Retrieve(rec.id);
+		if (sid) {
+			sid->posX            = rec.position_x;
+			sid->posY            = rec.position_y;
+			sid->posChanged      = false;
+			sid->scaleX          = rec.scale_x;
+			sid->scaleY          = rec.scale_y;
+			sid->scaleChanged    = false;
+			sid->rotation        = rec.rotation;
+			sid->rotationChanged = false;
+			sid->cropLeft        = rec.crop_left;
+			sid->cropTop         = rec.crop_top;
+			sid->cropRight       = rec.crop_right;
+			sid->cropBottom      = rec.crop_bottom;
+			sid->cropChanged     = false;
+		}
+
+		Napi::Object position = Napi::Object::New(info.Env());
+		position.Set("x", Napi::Number::New(info.Env(), rec.position_x));
+		position.Set("y", Napi::Number::New(info.Env(), rec.position_y));
+
+		Napi::Object scale = Napi::Object::New(info.Env());
+		scale.Set("x", Napi::Number::New(info.Env(), rec.scale_x));
+		scale.Set("y", Napi::Number::New(info.Env(), rec.scale_y));
+
+		Napi::Object crop = Napi::Object::New(info.Env());
+		crop.Set("left", Napi::Number::New(info.Env(), rec.crop_left));
+		crop.Set("top", Napi::Number::New(info.Env(), rec.crop_top));
+		crop.Set("right", Napi::Number::New(info.Env(), rec.crop_right));
+		crop.Set("bottom", Napi::Number::New(info.Env(), rec.crop_bottom));
+
+		Napi::Object bounds = Napi::Object::New(info.Env());
+		bounds.Set("x", Napi::Number::New(info.Env(), rec.bounds_x));
+		bounds.Set("y", Napi::Number::New(info.Env(), rec.bounds_y));
+
+		Napi::Object obj = Napi::Object::New(info.Env());
+		obj.Set("item", items[idx]);
+		obj.Set("position", position);
+		obj.Set("scale", scale);
+		obj.Set("rotation", Napi::Number::New(info.Env(), rec.rotation));
+		obj.Set("crop", crop);
+		obj.Set("bounds", bounds);
+		obj.Set("alignment", Napi::Number::New(info.Env(), rec.alignment));
+		obj.Set("boundsAlignment", Napi::Number::New(info.Env(), rec.bounds_alignment));
+		obj.Set("boundsType", Napi::Number::New(info.Env(), rec.bounds_type));
+		result.Set(idx, obj);
+	}
+
+	return result;
+}
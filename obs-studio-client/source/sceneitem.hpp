@@ -75,5 +75,7 @@ namespace osn
 		Napi::Value Move(const Napi::CallbackInfo& info);
 		Napi::Value DeferUpdateBegin(const Napi::CallbackInfo& info);
 		Napi::Value DeferUpdateEnd(const Napi::CallbackInfo& info);
+
+		static Napi::Value ApplyTransforms(const Napi::CallbackInfo& info);
 	};
 }
@@ -18,6 +18,7 @@
 
 #include "transition.hpp"
 #include <condition_variable>
+#include <cstring>
 #include <mutex>
 #include <string>
 #include "controller.hpp"
@@ -98,11 +99,16 @@ Napi::Value osn::Transition::Types(const Napi::CallbackInfo& info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	size_t count = response.size() - 1;
-	Napi::Array types = Napi::Array::New(info.Env(), count);
+	// Null-terminated type ids packed back to back.
+	const std::vector<char>& buffer = response[1].value_bin;
+	Napi::Array              types  = Napi::Array::New(info.Env());
 
-	for (size_t idx = 0; idx < count; idx++) {
-		types.Set(idx, Napi::String::New(info.Env(), response[1 + idx].value_str));
+	uint32_t idx = 0;
+	for (size_t pos = 0; pos < buffer.size();) {
+		const char* typeId = buffer.data() + pos;
+		size_t      length = strnlen(typeId, buffer.size() - pos);
+		types.Set(idx++, Napi::String::New(info.Env(), typeId, length));
+		pos += length + 1;
 	}
 
 	return types;
@@ -25,6 +25,7 @@
 #include "shared.hpp"
 #include "controller.hpp"
 #include "error.hpp"
+#include "write-behind.hpp"
 #include <thread>
 
 #ifdef __cplusplus
@@ -128,6 +129,9 @@ static FORCE_INLINE std::shared_ptr<ipc::client> GetConnection(const Napi::Callb
 		Napi::Error::New(info.Env(), "Failed to obtain IPC connection.").ThrowAsJavaScriptException();
 		exit(1);
 	}
+
+	// Coalesced setters must reach the server before whatever call follows.
+	WriteBehind::GetInstance().flush();
 	return conn;
 }
 
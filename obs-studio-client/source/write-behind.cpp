@@ -0,0 +1,133 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "write-behind.hpp"
+#include "controller.hpp"
+
+// One frame at 60 fps
+static const std::chrono::milliseconds flushInterval(16);
+
+WriteBehind::~WriteBehind()
+{
+	{
+		std::unique_lock<std::mutex> ulock(m_lock);
+		m_stop = true;
+		m_cv.notify_one();
+	}
+
+	if (m_worker.joinable())
+		m_worker.join();
+}
+
+void WriteBehind::set(
+    const std::string& cname, const std::string& fname, uint64_t target, std::vector<ipc::value>&& args)
+{
+	set(cname, fname, std::to_string(target), std::move(args));
+}
+
+void WriteBehind::set(
+    const std::string& cname, const std::string& fname, const std::string& target, std::vector<ipc::value>&& args)
+{
+	std::string key = cname + "." + fname + "#" + target;
+
+	std::unique_lock<std::mutex> ulock(m_lock);
+
+	if (m_pending.empty())
+		m_deadline = std::chrono::steady_clock::now() + flushInterval;
+
+	auto found = m_index.find(key);
+	if (found != m_index.end()) {
+		// Last writer wins, and the call moves behind everything queued since.
+		found->second->args = std::move(args);
+		m_pending.splice(m_pending.end(), m_pending, found->second);
+	} else {
+		m_pending.push_back({key, cname, fname, std::move(args)});
+		m_index.emplace(key, std::prev(m_pending.end()));
+	}
+
+	if (!m_running) {
+		m_running = true;
+		m_stop    = false;
+		m_worker  = std::thread(&WriteBehind::worker, this);
+	}
+	m_cv.notify_one();
+}
+
+void WriteBehind::flush(void)
+{
+	// Held while sending so that a concurrent flush can't overtake this one.
+	std::unique_lock<std::mutex> slock(m_sendLock);
+
+	std::list<pending_call> calls;
+	{
+		std::unique_lock<std::mutex> ulock(m_lock);
+		if (m_pending.empty())
+			return;
+
+		calls.swap(m_pending);
+		m_index.clear();
+	}
+
+	auto conn = Controller::GetInstance().GetConnection();
+	if (!conn)
+		return;
+
+	for (auto& call : calls)
+		conn->call(call.cname, call.fname, std::move(call.args));
+}
+
+void WriteBehind::stop(void)
+{
+	{
+		std::unique_lock<std::mutex> ulock(m_lock);
+		if (!m_running)
+			return;
+
+		m_stop = true;
+		m_cv.notify_one();
+	}
+
+	if (m_worker.joinable())
+		m_worker.join();
+
+	flush();
+
+	std::unique_lock<std::mutex> ulock(m_lock);
+	m_running = false;
+}
+
+void WriteBehind::worker(void)
+{
+	std::unique_lock<std::mutex> ulock(m_lock);
+
+	while (!m_stop) {
+		if (m_pending.empty()) {
+			m_cv.wait(ulock);
+			continue;
+		}
+
+		if (std::chrono::steady_clock::now() < m_deadline) {
+			m_cv.wait_until(ulock, m_deadline);
+			continue;
+		}
+
+		ulock.unlock();
+		flush();
+		ulock.lock();
+	}
+}
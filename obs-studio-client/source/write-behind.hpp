@@ -0,0 +1,78 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ipc-value.hpp"
+
+// Coalesces fire-and-forget setters that are sent at a high rate, like drags and slider moves.
+// Only the last value per (function, target) is kept and pending calls are sent at most once per
+// frame interval. Every other call flushes first, see GetConnection, so ordering is preserved.
+class WriteBehind
+{
+	public:
+	static WriteBehind& GetInstance()
+	{
+		static WriteBehind instance;
+		return instance;
+	}
+
+	private:
+	WriteBehind(){};
+	~WriteBehind();
+
+	public:
+	WriteBehind(WriteBehind const&) = delete;
+	void operator=(WriteBehind const&) = delete;
+
+	public:
+	void set(const std::string& cname, const std::string& fname, uint64_t target, std::vector<ipc::value>&& args);
+	void set(const std::string& cname, const std::string& fname, const std::string& target, std::vector<ipc::value>&& args);
+
+	// Sends every pending call, in the order of their last update.
+	void flush(void);
+	void stop(void);
+
+	private:
+	struct pending_call
+	{
+		std::string             key;
+		std::string             cname;
+		std::string             fname;
+		std::vector<ipc::value> args;
+	};
+
+	void worker(void);
+
+	std::list<pending_call>                                           m_pending;
+	std::unordered_map<std::string, std::list<pending_call>::iterator> m_index;
+	std::mutex                                                        m_lock;
+	std::mutex                                                        m_sendLock;
+	std::condition_variable                                           m_cv;
+	std::chrono::steady_clock::time_point                             m_deadline;
+	std::thread                                                       m_worker;
+	bool                                                              m_running = false;
+	bool                                                              m_stop    = false;
+};
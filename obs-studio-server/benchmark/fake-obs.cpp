@@ -0,0 +1,1839 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+/*
+ * In-process replacement for the subset of libobs used by the benchmarked IPC
+ * collections. It keeps the object model (reference counts, global and per
+ * source signals, scenes owning items, filters) but does no rendering, audio
+ * mixing or plugin loading, so that the measured cost is the IPC layer plus
+ * the handlers themselves.
+ *
+ * The libobs headers are deliberately not included: the handlers are compiled
+ * against the real headers and only the C symbols are provided here, with the
+ * same ABI as libobs 26.1.
+ */
+
+#include "fake-obs.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+#define MAX_AUDIO_CHANNELS 8
+
+#define LOG_ERROR 100
+#define LOG_WARNING 200
+
+enum
+{
+	SOURCE_TYPE_INPUT,
+	SOURCE_TYPE_FILTER,
+	SOURCE_TYPE_TRANSITION,
+	SOURCE_TYPE_SCENE,
+};
+
+enum
+{
+	SOURCE_VIDEO       = (1 << 0),
+	SOURCE_AUDIO       = (1 << 1),
+	SOURCE_ASYNC       = (1 << 2),
+	SOURCE_CUSTOM_DRAW = (1 << 3),
+	SOURCE_INTERACTION = (1 << 5),
+	SOURCE_COMPOSITE   = (1 << 6),
+};
+
+enum
+{
+	PROPERTY_INVALID,
+	PROPERTY_BOOL,
+	PROPERTY_INT,
+	PROPERTY_FLOAT,
+	PROPERTY_TEXT,
+	PROPERTY_PATH,
+	PROPERTY_LIST,
+	PROPERTY_COLOR,
+	PROPERTY_BUTTON,
+	PROPERTY_FONT,
+	PROPERTY_EDITABLE_LIST,
+	PROPERTY_FRAME_RATE,
+	PROPERTY_GROUP,
+};
+
+enum
+{
+	COMBO_FORMAT_INVALID,
+	COMBO_FORMAT_INT,
+	COMBO_FORMAT_FLOAT,
+	COMBO_FORMAT_STRING,
+};
+
+enum
+{
+	ORDER_MOVE_UP,
+	ORDER_MOVE_DOWN,
+	ORDER_MOVE_TOP,
+	ORDER_MOVE_BOTTOM,
+};
+
+extern "C" {
+struct vec2
+{
+	float x, y;
+};
+
+struct obs_sceneitem_crop
+{
+	int left, top, right, bottom;
+};
+
+struct obs_transform_info
+{
+	vec2     pos;
+	float    rot;
+	vec2     scale;
+	uint32_t alignment;
+	int      bounds_type;
+	uint32_t bounds_alignment;
+	vec2     bounds;
+};
+
+struct media_frames_per_second
+{
+	uint32_t numerator, denominator;
+};
+
+// Same layout as libobs, the content of the stack is private to this file.
+struct calldata
+{
+	uint8_t* stack;
+	size_t   size;
+	size_t   capacity;
+	bool     fixed;
+};
+
+typedef void (*signal_callback_t)(void* data, calldata* cd);
+typedef void (*volmeter_updated_t)(
+    void*       param,
+    const float magnitude[MAX_AUDIO_CHANNELS],
+    const float peak[MAX_AUDIO_CHANNELS],
+    const float input_peak[MAX_AUDIO_CHANNELS]);
+
+struct obs_data;
+struct obs_data_array;
+struct obs_property;
+struct obs_properties;
+struct obs_source;
+struct obs_scene;
+struct obs_scene_item;
+struct obs_volmeter;
+struct signal_handler;
+}
+
+/* Calldata: a flat list of (name, size, bytes) records. */
+
+static void calldata_write(calldata* cd, const char* name, const void* in, size_t size)
+{
+	size_t name_len = strlen(name) + 1;
+	size_t needed   = cd->size + name_len + sizeof(size_t) + size;
+	if (needed > cd->capacity) {
+		size_t capacity = std::max(needed, cd->capacity * 2);
+		cd->stack       = (uint8_t*)realloc(cd->stack, capacity);
+		cd->capacity    = capacity;
+	}
+
+	uint8_t* pos = cd->stack + cd->size;
+	memcpy(pos, name, name_len);
+	memcpy(pos + name_len, &size, sizeof(size_t));
+	memcpy(pos + name_len + sizeof(size_t), in, size);
+	cd->size = needed;
+}
+
+extern "C" bool calldata_get_data(const calldata* cd, const char* name, void* out, size_t size)
+{
+	size_t offset = 0;
+	while (offset < cd->size) {
+		const char* entry = (const char*)(cd->stack + offset);
+		size_t      len   = strlen(entry) + 1;
+		size_t      entry_size;
+		memcpy(&entry_size, cd->stack + offset + len, sizeof(size_t));
+
+		if (strcmp(entry, name) == 0) {
+			if (entry_size != size)
+				return false;
+			memcpy(out, cd->stack + offset + len + sizeof(size_t), size);
+			return true;
+		}
+
+		offset += len + sizeof(size_t) + entry_size;
+	}
+	return false;
+}
+
+extern "C" void calldata_set_data(calldata* cd, const char* name, const void* in, size_t size)
+{
+	calldata_write(cd, name, in, size);
+}
+
+/* Signals */
+
+struct signal_handler
+{
+	struct connection
+	{
+		std::string       signal;
+		signal_callback_t callback;
+		void*             data;
+	};
+
+	std::mutex              mtx;
+	std::vector<connection> connections;
+
+	void emit(const char* signal, calldata* cd)
+	{
+		std::vector<connection> targets;
+		{
+			std::unique_lock<std::mutex> ulock(mtx);
+			for (auto& connection : connections) {
+				if (connection.signal == signal)
+					targets.push_back(connection);
+			}
+		}
+		for (auto& connection : targets)
+			connection.callback(connection.data, cd);
+	}
+};
+
+static void EmitSource(signal_handler* sh, const char* signal, obs_source* source)
+{
+	calldata cd = {};
+	calldata_write(&cd, "source", &source, sizeof(source));
+	sh->emit(signal, &cd);
+	free(cd.stack);
+}
+
+extern "C" void signal_handler_connect(signal_handler* sh, const char* signal, signal_callback_t callback, void* data)
+{
+	if (!sh)
+		return;
+	std::unique_lock<std::mutex> ulock(sh->mtx);
+	sh->connections.push_back({signal, callback, data});
+}
+
+extern "C" void
+    signal_handler_disconnect(signal_handler* sh, const char* signal, signal_callback_t callback, void* data)
+{
+	if (!sh)
+		return;
+	std::unique_lock<std::mutex> ulock(sh->mtx);
+	auto&                        list = sh->connections;
+	for (auto it = list.begin(); it != list.end(); ++it) {
+		if (it->signal == signal && it->callback == callback && it->data == data) {
+			list.erase(it);
+			break;
+		}
+	}
+}
+
+/* Logging */
+
+extern "C" void blog(int level, const char* format, ...)
+{
+	if (level > LOG_WARNING)
+		return;
+
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+
+/* Data */
+
+struct obs_data
+{
+	std::atomic<long> refs{1};
+	nlohmann::json    json = nlohmann::json::object();
+	std::string       full;
+};
+
+struct obs_data_array
+{
+	std::atomic<long>      refs{1};
+	std::vector<obs_data*> items;
+};
+
+static obs_data* DataCreate(const nlohmann::json& json)
+{
+	obs_data* data = new obs_data;
+	if (json.is_object())
+		data->json = json;
+	return data;
+}
+
+extern "C" obs_data* obs_data_create_from_json(const char* json_string)
+{
+	nlohmann::json json = nlohmann::json::parse(json_string ? json_string : "", nullptr, false);
+	if (json.is_discarded())
+		blog(LOG_ERROR, "obs-data.c: [obs_data_create_from_json] Failed reading json string");
+	return DataCreate(json);
+}
+
+extern "C" void obs_data_addref(obs_data* data)
+{
+	if (data)
+		data->refs++;
+}
+
+extern "C" void obs_data_release(obs_data* data)
+{
+	if (data && --data->refs == 0)
+		delete data;
+}
+
+extern "C" const char* obs_data_get_full_json(obs_data* data)
+{
+	if (!data)
+		return nullptr;
+	data->full = data->json.dump();
+	return data->full.c_str();
+}
+
+static const nlohmann::json* DataFind(obs_data* data, const char* name)
+{
+	if (!data || !name)
+		return nullptr;
+	auto it = data->json.find(name);
+	return it == data->json.end() ? nullptr : &*it;
+}
+
+extern "C" const char* obs_data_get_string(obs_data* data, const char* name)
+{
+	const nlohmann::json* value = DataFind(data, name);
+	if (!value || !value->is_string())
+		return "";
+	return value->get_ref<const std::string&>().c_str();
+}
+
+extern "C" long long obs_data_get_int(obs_data* data, const char* name)
+{
+	const nlohmann::json* value = DataFind(data, name);
+	return value && value->is_number() ? value->get<long long>() : 0;
+}
+
+extern "C" double obs_data_get_double(obs_data* data, const char* name)
+{
+	const nlohmann::json* value = DataFind(data, name);
+	return value && value->is_number() ? value->get<double>() : 0.0;
+}
+
+extern "C" bool obs_data_get_bool(obs_data* data, const char* name)
+{
+	const nlohmann::json* value = DataFind(data, name);
+	return value && value->is_boolean() ? value->get<bool>() : false;
+}
+
+extern "C" obs_data* obs_data_get_obj(obs_data* data, const char* name)
+{
+	const nlohmann::json* value = DataFind(data, name);
+	return value && value->is_object() ? DataCreate(*value) : nullptr;
+}
+
+extern "C" obs_data_array* obs_data_get_array(obs_data* data, const char* name)
+{
+	const nlohmann::json* value = DataFind(data, name);
+	if (!value || !value->is_array())
+		return nullptr;
+
+	obs_data_array* array = new obs_data_array;
+	for (auto& item : *value)
+		array->items.push_back(DataCreate(item));
+	return array;
+}
+
+extern "C" void obs_data_set_string(obs_data* data, const char* name, const char* val)
+{
+	if (data && name)
+		data->json[name] = val ? val : "";
+}
+
+extern "C" size_t obs_data_array_count(obs_data_array* array)
+{
+	return array ? array->items.size() : 0;
+}
+
+extern "C" obs_data* obs_data_array_item(obs_data_array* array, size_t idx)
+{
+	if (!array || idx >= array->items.size())
+		return nullptr;
+	obs_data_addref(array->items[idx]);
+	return array->items[idx];
+}
+
+extern "C" void obs_data_array_release(obs_data_array* array)
+{
+	if (!array || --array->refs != 0)
+		return;
+	for (obs_data* item : array->items)
+		obs_data_release(item);
+	delete array;
+}
+
+/* Source types */
+
+struct source_type
+{
+	const char* id;
+	int         type;
+	uint32_t    output_flags;
+	uint32_t    width;
+	uint32_t    height;
+	size_t      list_items;
+};
+
+static const source_type source_types[] = {
+    {"image_source", SOURCE_TYPE_INPUT, SOURCE_VIDEO, 1920, 1080, 4},
+    {"color_source", SOURCE_TYPE_INPUT, SOURCE_VIDEO | SOURCE_CUSTOM_DRAW, 1920, 1080, 2},
+    {"ffmpeg_source", SOURCE_TYPE_INPUT, SOURCE_VIDEO | SOURCE_AUDIO | SOURCE_ASYNC, 1280, 720, 8},
+    {"browser_source",
+     SOURCE_TYPE_INPUT,
+     SOURCE_VIDEO | SOURCE_AUDIO | SOURCE_CUSTOM_DRAW | SOURCE_INTERACTION,
+     800,
+     600,
+     16},
+    {"text_gdiplus", SOURCE_TYPE_INPUT, SOURCE_VIDEO | SOURCE_CUSTOM_DRAW, 400, 80, 6},
+    {"wasapi_input_capture", SOURCE_TYPE_INPUT, SOURCE_AUDIO, 0, 0, 32},
+    {"color_filter", SOURCE_TYPE_FILTER, SOURCE_VIDEO, 0, 0, 0},
+    {"gain_filter", SOURCE_TYPE_FILTER, SOURCE_AUDIO, 0, 0, 0},
+    {"scene", SOURCE_TYPE_SCENE, SOURCE_VIDEO | SOURCE_CUSTOM_DRAW | SOURCE_COMPOSITE, 1920, 1080, 0},
+};
+
+static const source_type* FindType(const char* id)
+{
+	for (auto& type : source_types) {
+		if (id && strcmp(type.id, id) == 0)
+			return &type;
+	}
+	return nullptr;
+}
+
+static nlohmann::json TypeDefaults(const source_type* type)
+{
+	nlohmann::json defaults = nlohmann::json::object();
+	if (!type || type->type == SOURCE_TYPE_SCENE)
+		return defaults;
+
+	defaults["enabled"]  = true;
+	defaults["width"]    = type->width;
+	defaults["height"]   = type->height;
+	defaults["opacity"]  = 1.0;
+	defaults["text"]     = "";
+	defaults["file"]     = "";
+	defaults["color"]    = 0xFFFFFFFF;
+	defaults["fps"]      = 30;
+	defaults["playlist"] = nlohmann::json::array();
+	return defaults;
+}
+
+extern "C" bool obs_enum_input_types(size_t idx, const char** id)
+{
+	size_t count = 0;
+	for (auto& type : source_types) {
+		if (type.type != SOURCE_TYPE_INPUT)
+			continue;
+		if (count++ == idx) {
+			*id = type.id;
+			return true;
+		}
+	}
+	return false;
+}
+
+extern "C" obs_data* obs_get_source_defaults(const char* id)
+{
+	const source_type* type = FindType(id);
+	return type ? DataCreate(TypeDefaults(type)) : nullptr;
+}
+
+extern "C" uint32_t obs_get_source_output_flags(const char* id)
+{
+	const source_type* type = FindType(id);
+	return type ? type->output_flags : 0;
+}
+
+/* Sources */
+
+struct obs_scene
+{
+	obs_source*                  source;
+	std::vector<obs_scene_item*> items;
+	int64_t                      next_id = 1;
+};
+
+struct obs_scene_item
+{
+	std::atomic<long>  refs{1};
+	bool               attached = true;
+	obs_scene*         parent;
+	obs_source*        source;
+	int64_t            id;
+	vec2               pos               = {0, 0};
+	vec2               scale             = {1, 1};
+	vec2               bounds            = {0, 0};
+	float              rot               = 0;
+	uint32_t           alignment         = 5;
+	uint32_t           bounds_alignment  = 0;
+	int                bounds_type       = 0;
+	int                scale_filter      = 0;
+	obs_sceneitem_crop crop              = {0, 0, 0, 0};
+	bool               visible           = true;
+	bool               selected          = false;
+	bool               stream_visible    = true;
+	bool               recording_visible = true;
+	int                defer_update      = 0;
+};
+
+struct obs_source
+{
+	std::atomic<long>        refs{1};
+	const source_type*       type;
+	std::string              id;
+	std::string              name;
+	bool                     is_private;
+	bool                     removed = false;
+	obs_data*                settings;
+	signal_handler           signals;
+	obs_scene*               scene = nullptr;
+	std::vector<obs_source*> filters;
+	obs_source*              filter_parent = nullptr;
+
+	float    volume            = 1.0f;
+	bool     muted             = false;
+	bool     enabled           = true;
+	int64_t  sync_offset       = 0;
+	uint32_t audio_mixers      = 0x3F;
+	uint32_t flags             = 0;
+	int      monitoring_type   = 0;
+	int      deinterlace_mode  = 0;
+	int      deinterlace_order = 0;
+};
+
+struct obs_volmeter
+{
+	struct callback
+	{
+		volmeter_updated_t callback;
+		void*              param;
+	};
+
+	int                   fader_type;
+	unsigned int          update_interval = 50;
+	obs_source*           source          = nullptr;
+	std::vector<callback> callbacks;
+	uint64_t              next_update = 0;
+};
+
+static struct
+{
+	std::recursive_mutex       mtx;
+	signal_handler             signals;
+	std::vector<obs_source*>   sources;
+	size_t                     items = 0;
+	std::vector<obs_volmeter*> meters;
+
+	std::thread       audio_thread;
+	std::atomic<bool> audio_running{false};
+	uint32_t          audio_channels = 2;
+} fake;
+
+extern "C" signal_handler* obs_get_signal_handler(void)
+{
+	return &fake.signals;
+}
+
+extern "C" signal_handler* obs_source_get_signal_handler(const obs_source* source)
+{
+	return source ? const_cast<signal_handler*>(&source->signals) : nullptr;
+}
+
+extern "C" void            obs_sceneitem_release(obs_scene_item* item);
+extern "C" void            obs_source_release(obs_source* source);
+extern "C" obs_scene_item* obs_scene_add(obs_scene* scene, obs_source* source);
+
+static obs_source* SourceCreate(const char* id, const char* name, obs_data* settings, bool is_private)
+{
+	const source_type* type = FindType(id);
+	if (!type) {
+		blog(LOG_ERROR, "Source ID '%s' not found", id ? id : "");
+		return nullptr;
+	}
+
+	obs_source* source = new obs_source;
+	source->type       = type;
+	source->id         = type->id;
+	source->name       = name ? name : "";
+	source->is_private = is_private;
+
+	nlohmann::json json = TypeDefaults(type);
+	if (settings)
+		json.update(settings->json);
+	source->settings = DataCreate(json);
+
+	if (type->type == SOURCE_TYPE_SCENE) {
+		source->scene         = new obs_scene;
+		source->scene->source = source;
+	}
+
+	{
+		std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+		fake.sources.push_back(source);
+	}
+
+	if (!is_private)
+		EmitSource(&fake.signals, "source_create", source);
+	return source;
+}
+
+static void SourceDestroy(obs_source* source)
+{
+	EmitSource(&source->signals, "destroy", source);
+	if (!source->is_private)
+		EmitSource(&fake.signals, "source_destroy", source);
+
+	if (source->scene) {
+		std::vector<obs_scene_item*> items;
+		items.swap(source->scene->items);
+		for (obs_scene_item* item : items) {
+			item->attached = false;
+			obs_sceneitem_release(item);
+		}
+		delete source->scene;
+	}
+
+	std::vector<obs_source*> filters;
+	filters.swap(source->filters);
+	for (obs_source* filter : filters) {
+		filter->filter_parent = nullptr;
+		obs_source_release(filter);
+	}
+
+	{
+		std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+		fake.sources.erase(std::remove(fake.sources.begin(), fake.sources.end(), source), fake.sources.end());
+		for (obs_volmeter* meter : fake.meters) {
+			if (meter->source == source)
+				meter->source = nullptr;
+		}
+	}
+
+	obs_data_release(source->settings);
+	delete source;
+}
+
+extern "C" obs_source* obs_source_create(const char* id, const char* name, obs_data* settings, obs_data* hotkey_data)
+{
+	return SourceCreate(id, name, settings, false);
+}
+
+extern "C" obs_source* obs_source_create_private(const char* id, const char* name, obs_data* settings)
+{
+	return SourceCreate(id, name, settings, true);
+}
+
+extern "C" void obs_source_addref(obs_source* source)
+{
+	if (source)
+		source->refs++;
+}
+
+extern "C" void obs_source_release(obs_source* source)
+{
+	if (source && --source->refs == 0)
+		SourceDestroy(source);
+}
+
+extern "C" void obs_source_remove(obs_source* source)
+{
+	if (!source || source->removed)
+		return;
+	source->removed = true;
+	EmitSource(&source->signals, "remove", source);
+}
+
+extern "C" bool obs_source_removed(const obs_source* source)
+{
+	return source ? source->removed : true;
+}
+
+extern "C" obs_source* obs_source_duplicate(obs_source* source, const char* desired_name, bool create_private)
+{
+	if (!source)
+		return nullptr;
+	if (source->scene) {
+		obs_source_addref(source);
+		return source;
+	}
+	return SourceCreate(source->id.c_str(), desired_name, source->settings, create_private);
+}
+
+extern "C" obs_source* obs_get_source_by_name(const char* name)
+{
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	for (obs_source* source : fake.sources) {
+		if (!source->is_private && !source->removed && name && source->name == name) {
+			obs_source_addref(source);
+			return source;
+		}
+	}
+	return nullptr;
+}
+
+extern "C" void obs_enum_sources(bool (*enum_proc)(void*, obs_source*), void* param)
+{
+	std::vector<obs_source*> sources;
+	{
+		std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+		for (obs_source* source : fake.sources) {
+			if (!source->is_private && !source->removed && source->type->type == SOURCE_TYPE_INPUT)
+				sources.push_back(source);
+		}
+	}
+	for (obs_source* source : sources) {
+		if (!enum_proc(param, source))
+			break;
+	}
+}
+
+extern "C" const char* obs_source_get_name(const obs_source* source)
+{
+	return source ? source->name.c_str() : nullptr;
+}
+
+extern "C" void obs_source_set_name(obs_source* source, const char* name)
+{
+	if (source && name)
+		source->name = name;
+}
+
+extern "C" const char* obs_source_get_id(const obs_source* source)
+{
+	return source ? source->id.c_str() : nullptr;
+}
+
+extern "C" int obs_source_get_type(const obs_source* source)
+{
+	return source ? source->type->type : SOURCE_TYPE_INPUT;
+}
+
+extern "C" uint32_t obs_source_get_output_flags(const obs_source* source)
+{
+	return source ? source->type->output_flags : 0;
+}
+
+extern "C" uint32_t obs_source_get_flags(const obs_source* source)
+{
+	return source ? source->flags : 0;
+}
+
+extern "C" void obs_source_set_flags(obs_source* source, uint32_t flags)
+{
+	if (source)
+		source->flags = flags;
+}
+
+extern "C" obs_data* obs_source_get_settings(const obs_source* source)
+{
+	if (!source)
+		return nullptr;
+	obs_data_addref(source->settings);
+	return source->settings;
+}
+
+extern "C" void obs_source_update(obs_source* source, obs_data* settings)
+{
+	if (source && settings)
+		source->settings->json.update(settings->json);
+}
+
+extern "C" void obs_source_load(obs_source* source) {}
+
+extern "C" void obs_source_save(obs_source* source) {}
+
+extern "C" bool obs_source_configurable(const obs_source* source)
+{
+	return source && source->type->list_items > 0;
+}
+
+extern "C" uint32_t obs_source_get_width(obs_source* source)
+{
+	if (!source || !(source->type->output_flags & SOURCE_VIDEO))
+		return 0;
+	return (uint32_t)source->settings->json.value("width", 0);
+}
+
+extern "C" uint32_t obs_source_get_height(obs_source* source)
+{
+	if (!source || !(source->type->output_flags & SOURCE_VIDEO))
+		return 0;
+	return (uint32_t)source->settings->json.value("height", 0);
+}
+
+extern "C" float obs_source_get_volume(const obs_source* source)
+{
+	return source ? source->volume : 0.0f;
+}
+
+extern "C" void obs_source_set_volume(obs_source* source, float volume)
+{
+	if (source)
+		source->volume = volume;
+}
+
+extern "C" bool obs_source_muted(const obs_source* source)
+{
+	return source ? source->muted : false;
+}
+
+extern "C" void obs_source_set_muted(obs_source* source, bool muted)
+{
+	if (source)
+		source->muted = muted;
+}
+
+extern "C" bool obs_source_enabled(const obs_source* source)
+{
+	return source ? source->enabled : false;
+}
+
+extern "C" void obs_source_set_enabled(obs_source* source, bool enabled)
+{
+	if (source)
+		source->enabled = enabled;
+}
+
+extern "C" int64_t obs_source_get_sync_offset(const obs_source* source)
+{
+	return source ? source->sync_offset : 0;
+}
+
+extern "C" void obs_source_set_sync_offset(obs_source* source, int64_t offset)
+{
+	if (source)
+		source->sync_offset = offset;
+}
+
+extern "C" uint32_t obs_source_get_audio_mixers(const obs_source* source)
+{
+	if (!source || !(source->type->output_flags & SOURCE_AUDIO))
+		return 0;
+	return source->audio_mixers;
+}
+
+extern "C" void obs_source_set_audio_mixers(obs_source* source, uint32_t mixers)
+{
+	if (source)
+		source->audio_mixers = mixers;
+}
+
+extern "C" int obs_source_get_monitoring_type(const obs_source* source)
+{
+	return source ? source->monitoring_type : 0;
+}
+
+extern "C" void obs_source_set_monitoring_type(obs_source* source, int type)
+{
+	if (source)
+		source->monitoring_type = type;
+}
+
+extern "C" int obs_source_get_deinterlace_mode(const obs_source* source)
+{
+	return source ? source->deinterlace_mode : 0;
+}
+
+extern "C" void obs_source_set_deinterlace_mode(obs_source* source, int mode)
+{
+	if (source)
+		source->deinterlace_mode = mode;
+}
+
+extern "C" int obs_source_get_deinterlace_field_order(const obs_source* source)
+{
+	return source ? source->deinterlace_order : 0;
+}
+
+extern "C" void obs_source_set_deinterlace_field_order(obs_source* source, int order)
+{
+	if (source)
+		source->deinterlace_order = order;
+}
+
+extern "C" bool obs_source_active(const obs_source* source)
+{
+	return false;
+}
+
+extern "C" bool obs_source_showing(const obs_source* source)
+{
+	return false;
+}
+
+extern "C" void
+    obs_source_send_mouse_click(obs_source* source, const void* event, int32_t type, bool mouse_up, uint32_t count)
+{}
+extern "C" void obs_source_send_mouse_move(obs_source* source, const void* event, bool mouse_leave) {}
+extern "C" void obs_source_send_mouse_wheel(obs_source* source, const void* event, int x_delta, int y_delta) {}
+extern "C" void obs_source_send_focus(obs_source* source, bool focus) {}
+extern "C" void obs_source_send_key_click(obs_source* source, const void* event, bool key_up) {}
+
+/* Filters */
+
+extern "C" void obs_source_filter_add(obs_source* source, obs_source* filter)
+{
+	if (!source || !filter || filter->filter_parent)
+		return;
+	obs_source_addref(filter);
+	filter->filter_parent = source;
+	source->filters.insert(source->filters.begin(), filter);
+}
+
+extern "C" void obs_source_filter_remove(obs_source* source, obs_source* filter)
+{
+	if (!source || !filter)
+		return;
+	auto it = std::find(source->filters.begin(), source->filters.end(), filter);
+	if (it == source->filters.end())
+		return;
+	source->filters.erase(it);
+	filter->filter_parent = nullptr;
+	obs_source_release(filter);
+}
+
+extern "C" void obs_source_filter_set_order(obs_source* source, obs_source* filter, int movement)
+{
+	if (!source || !filter)
+		return;
+	auto& list = source->filters;
+	auto  it   = std::find(list.begin(), list.end(), filter);
+	if (it == list.end())
+		return;
+
+	size_t idx = it - list.begin();
+	list.erase(it);
+	switch (movement) {
+	case ORDER_MOVE_UP:
+		idx = idx > 0 ? idx - 1 : 0;
+		break;
+	case ORDER_MOVE_DOWN:
+		idx = std::min(idx + 1, list.size());
+		break;
+	case ORDER_MOVE_TOP:
+		idx = 0;
+		break;
+	case ORDER_MOVE_BOTTOM:
+		idx = list.size();
+		break;
+	}
+	list.insert(list.begin() + idx, filter);
+}
+
+extern "C" void
+    obs_source_enum_filters(obs_source* source, void (*callback)(obs_source*, obs_source*, void*), void* param)
+{
+	if (!source)
+		return;
+	std::vector<obs_source*> filters = source->filters;
+	for (auto it = filters.rbegin(); it != filters.rend(); ++it)
+		callback(source, *it, param);
+}
+
+extern "C" obs_source* obs_source_get_filter_by_name(obs_source* source, const char* name)
+{
+	if (!source || !name)
+		return nullptr;
+	for (obs_source* filter : source->filters) {
+		if (filter->name == name) {
+			obs_source_addref(filter);
+			return filter;
+		}
+	}
+	return nullptr;
+}
+
+extern "C" void obs_source_copy_filters(obs_source* dst, obs_source* src)
+{
+	if (!dst || !src)
+		return;
+	for (auto it = src->filters.rbegin(); it != src->filters.rend(); ++it) {
+		obs_source* copy = SourceCreate((*it)->id.c_str(), (*it)->name.c_str(), (*it)->settings, true);
+		obs_source_filter_add(dst, copy);
+		obs_source_release(copy);
+	}
+}
+
+/* Scenes */
+
+extern "C" obs_scene* obs_scene_create(const char* name)
+{
+	obs_source* source = SourceCreate("scene", name, nullptr, false);
+	return source ? source->scene : nullptr;
+}
+
+extern "C" obs_scene* obs_scene_create_private(const char* name)
+{
+	obs_source* source = SourceCreate("scene", name, nullptr, true);
+	return source ? source->scene : nullptr;
+}
+
+extern "C" obs_scene* obs_scene_duplicate(obs_scene* scene, const char* name, int type)
+{
+	if (!scene)
+		return nullptr;
+	obs_scene* copy = obs_scene_create(name);
+	for (obs_scene_item* item : scene->items) {
+		obs_scene_item* dup = obs_scene_add(copy, item->source);
+		dup->pos            = item->pos;
+		dup->scale          = item->scale;
+		dup->rot            = item->rot;
+		dup->crop           = item->crop;
+		dup->visible        = item->visible;
+	}
+	return copy;
+}
+
+extern "C" obs_source* obs_scene_get_source(const obs_scene* scene)
+{
+	return scene ? scene->source : nullptr;
+}
+
+extern "C" obs_scene* obs_scene_from_source(const obs_source* source)
+{
+	return source ? source->scene : nullptr;
+}
+
+extern "C" obs_scene_item* obs_scene_add(obs_scene* scene, obs_source* source)
+{
+	if (!scene || !source)
+		return nullptr;
+
+	obs_source_addref(source);
+
+	obs_scene_item* item = new obs_scene_item;
+	item->parent         = scene;
+	item->source         = source;
+	item->id             = scene->next_id++;
+	scene->items.push_back(item);
+
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	fake.items++;
+	return item;
+}
+
+extern "C" void
+    obs_scene_enum_items(obs_scene* scene, bool (*callback)(obs_scene*, obs_scene_item*, void*), void* param)
+{
+	if (!scene)
+		return;
+	std::vector<obs_scene_item*> items = scene->items;
+	for (obs_scene_item* item : items) {
+		if (!callback(scene, item, param))
+			break;
+	}
+}
+
+extern "C" obs_scene_item* obs_scene_find_source(obs_scene* scene, const char* name)
+{
+	if (!scene || !name)
+		return nullptr;
+	for (obs_scene_item* item : scene->items) {
+		if (item->source->name == name)
+			return item;
+	}
+	return nullptr;
+}
+
+extern "C" obs_scene_item* obs_scene_find_sceneitem_by_id(obs_scene* scene, int64_t id)
+{
+	if (!scene)
+		return nullptr;
+	for (obs_scene_item* item : scene->items) {
+		if (item->id == id)
+			return item;
+	}
+	return nullptr;
+}
+
+extern "C" bool obs_scene_set_items_order(obs_scene* scene, obs_scene_item* const* order, size_t count)
+{
+	if (!scene || !order || count != scene->items.size())
+		return false;
+	scene->items.assign(order, order + count);
+	return true;
+}
+
+/* Scene items */
+
+static void ItemFree(obs_scene_item* item)
+{
+	obs_source_release(item->source);
+	delete item;
+
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	fake.items--;
+}
+
+extern "C" void obs_sceneitem_addref(obs_scene_item* item)
+{
+	if (item)
+		item->refs++;
+}
+
+extern "C" void obs_sceneitem_release(obs_scene_item* item)
+{
+	// The memory stays valid while the item is in its scene, like libobs.
+	if (item && --item->refs <= 0 && !item->attached)
+		ItemFree(item);
+}
+
+extern "C" void obs_sceneitem_remove(obs_scene_item* item)
+{
+	if (!item || !item->attached)
+		return;
+
+	auto& items = item->parent->items;
+	items.erase(std::remove(items.begin(), items.end(), item), items.end());
+	item->attached = false;
+
+	if (--item->refs <= 0)
+		ItemFree(item);
+}
+
+extern "C" obs_scene* obs_sceneitem_get_scene(const obs_scene_item* item)
+{
+	return item ? item->parent : nullptr;
+}
+
+extern "C" obs_source* obs_sceneitem_get_source(const obs_scene_item* item)
+{
+	return item ? item->source : nullptr;
+}
+
+extern "C" int64_t obs_sceneitem_get_id(const obs_scene_item* item)
+{
+	return item ? item->id : 0;
+}
+
+extern "C" void obs_sceneitem_set_order(obs_scene_item* item, int movement)
+{
+	if (!item || !item->attached)
+		return;
+	auto&  list = item->parent->items;
+	auto   it   = std::find(list.begin(), list.end(), item);
+	size_t idx  = it - list.begin();
+	list.erase(it);
+	switch (movement) {
+	case ORDER_MOVE_UP:
+		idx = std::min(idx + 1, list.size());
+		break;
+	case ORDER_MOVE_DOWN:
+		idx = idx > 0 ? idx - 1 : 0;
+		break;
+	case ORDER_MOVE_TOP:
+		idx = list.size();
+		break;
+	case ORDER_MOVE_BOTTOM:
+		idx = 0;
+		break;
+	}
+	list.insert(list.begin() + idx, item);
+}
+
+extern "C" void obs_sceneitem_set_order_position(obs_scene_item* item, int position)
+{
+	if (!item || !item->attached)
+		return;
+	auto& list = item->parent->items;
+	list.erase(std::find(list.begin(), list.end(), item));
+	size_t idx = std::min((size_t)std::max(position, 0), list.size());
+	list.insert(list.begin() + idx, item);
+}
+
+extern "C" bool obs_sceneitem_visible(const obs_scene_item* item)
+{
+	return item ? item->visible : false;
+}
+
+extern "C" bool obs_sceneitem_set_visible(obs_scene_item* item, bool visible)
+{
+	if (!item)
+		return false;
+	item->visible = visible;
+	return true;
+}
+
+extern "C" bool obs_sceneitem_stream_visible(const obs_scene_item* item)
+{
+	return item ? item->stream_visible : false;
+}
+
+extern "C" bool obs_sceneitem_set_stream_visible(obs_scene_item* item, bool visible)
+{
+	if (!item)
+		return false;
+	item->stream_visible = visible;
+	return true;
+}
+
+extern "C" bool obs_sceneitem_recording_visible(const obs_scene_item* item)
+{
+	return item ? item->recording_visible : false;
+}
+
+extern "C" bool obs_sceneitem_set_recording_visible(obs_scene_item* item, bool visible)
+{
+	if (!item)
+		return false;
+	item->recording_visible = visible;
+	return true;
+}
+
+extern "C" bool obs_sceneitem_selected(const obs_scene_item* item)
+{
+	return item ? item->selected : false;
+}
+
+extern "C" bool obs_sceneitem_select(obs_scene_item* item, bool select)
+{
+	if (!item)
+		return false;
+	item->selected = select;
+	return true;
+}
+
+extern "C" void obs_sceneitem_get_pos(const obs_scene_item* item, vec2* pos)
+{
+	if (item && pos)
+		*pos = item->pos;
+}
+
+extern "C" void obs_sceneitem_set_pos(obs_scene_item* item, const vec2* pos)
+{
+	if (item && pos)
+		item->pos = *pos;
+}
+
+extern "C" void obs_sceneitem_get_scale(const obs_scene_item* item, vec2* scale)
+{
+	if (item && scale)
+		*scale = item->scale;
+}
+
+extern "C" void obs_sceneitem_set_scale(obs_scene_item* item, const vec2* scale)
+{
+	if (item && scale)
+		item->scale = *scale;
+}
+
+extern "C" void obs_sceneitem_get_bounds(const obs_scene_item* item, vec2* bounds)
+{
+	if (item && bounds)
+		*bounds = item->bounds;
+}
+
+extern "C" void obs_sceneitem_set_bounds(obs_scene_item* item, const vec2* bounds)
+{
+	if (item && bounds)
+		item->bounds = *bounds;
+}
+
+extern "C" float obs_sceneitem_get_rot(const obs_scene_item* item)
+{
+	return item ? item->rot : 0.0f;
+}
+
+extern "C" void obs_sceneitem_set_rot(obs_scene_item* item, float rot)
+{
+	if (item)
+		item->rot = rot;
+}
+
+extern "C" uint32_t obs_sceneitem_get_alignment(const obs_scene_item* item)
+{
+	return item ? item->alignment : 0;
+}
+
+extern "C" void obs_sceneitem_set_alignment(obs_scene_item* item, uint32_t alignment)
+{
+	if (item)
+		item->alignment = alignment;
+}
+
+extern "C" uint32_t obs_sceneitem_get_bounds_alignment(const obs_scene_item* item)
+{
+	return item ? item->bounds_alignment : 0;
+}
+
+extern "C" void obs_sceneitem_set_bounds_alignment(obs_scene_item* item, uint32_t alignment)
+{
+	if (item)
+		item->bounds_alignment = alignment;
+}
+
+extern "C" int obs_sceneitem_get_bounds_type(const obs_scene_item* item)
+{
+	return item ? item->bounds_type : 0;
+}
+
+extern "C" void obs_sceneitem_set_bounds_type(obs_scene_item* item, int type)
+{
+	if (item)
+		item->bounds_type = type;
+}
+
+extern "C" int obs_sceneitem_get_scale_filter(obs_scene_item* item)
+{
+	return item ? item->scale_filter : 0;
+}
+
+extern "C" void obs_sceneitem_set_scale_filter(obs_scene_item* item, int filter)
+{
+	if (item)
+		item->scale_filter = filter;
+}
+
+extern "C" void obs_sceneitem_get_crop(const obs_scene_item* item, obs_sceneitem_crop* crop)
+{
+	if (item && crop)
+		*crop = item->crop;
+}
+
+extern "C" void obs_sceneitem_set_crop(obs_scene_item* item, const obs_sceneitem_crop* crop)
+{
+	if (item && crop)
+		item->crop = *crop;
+}
+
+extern "C" void obs_sceneitem_get_info(const obs_scene_item* item, obs_transform_info* info)
+{
+	if (!item || !info)
+		return;
+	info->pos              = item->pos;
+	info->rot              = item->rot;
+	info->scale            = item->scale;
+	info->alignment        = item->alignment;
+	info->bounds_type      = item->bounds_type;
+	info->bounds_alignment = item->bounds_alignment;
+	info->bounds           = item->bounds;
+}
+
+extern "C" void obs_sceneitem_defer_update_begin(obs_scene_item* item)
+{
+	if (item)
+		item->defer_update++;
+}
+
+extern "C" void obs_sceneitem_defer_update_end(obs_scene_item* item)
+{
+	if (item && item->defer_update > 0)
+		item->defer_update--;
+}
+
+/* Properties */
+
+struct obs_property
+{
+	struct list_item
+	{
+		std::string name;
+		std::string value_string;
+		long long   value_int;
+		double      value_float;
+		bool        disabled;
+	};
+
+	std::string name;
+	std::string description;
+	std::string long_description;
+	int         type;
+	bool        enabled = true;
+	bool        visible = true;
+
+	int         int_min = 0, int_max = 0, int_step = 1;
+	double      float_min = 0, float_max = 0, float_step = 1;
+	int         number_type = 0;
+	int         text_type   = 0;
+	int         path_type   = 0;
+	std::string filter;
+	std::string default_path;
+
+	int                    combo_type   = 0;
+	int                    combo_format = COMBO_FORMAT_INVALID;
+	std::vector<list_item> items;
+	int                    editable_type = 0;
+
+	std::vector<std::pair<media_frames_per_second, media_frames_per_second>> fps_ranges;
+	std::vector<std::pair<std::string, std::string>>                         fps_options;
+
+	obs_properties* group = nullptr;
+	obs_property*   next  = nullptr;
+};
+
+struct obs_properties
+{
+	std::vector<std::unique_ptr<obs_property>> list;
+
+	obs_property* add(const char* name, const char* description, int type)
+	{
+		list.emplace_back(new obs_property);
+		obs_property* prop     = list.back().get();
+		prop->name             = name;
+		prop->description      = description;
+		prop->long_description = std::string(description) + ".";
+		prop->type             = type;
+		if (list.size() > 1)
+			list[list.size() - 2]->next = prop;
+		return prop;
+	}
+
+	~obs_properties();
+};
+
+obs_properties::~obs_properties()
+{
+	for (auto& prop : list)
+		delete prop->group;
+}
+
+static obs_properties* BuildProperties(const source_type* type)
+{
+	obs_properties* props = new obs_properties;
+
+	// Shaped after the common inputs: a few scalars, a device/file list and grouped advanced settings.
+	obs_property* prop = props->add("width", "Width", PROPERTY_INT);
+	prop->int_max      = 8192;
+	prop               = props->add("height", "Height", PROPERTY_INT);
+	prop->int_max      = 8192;
+	prop               = props->add("opacity", "Opacity", PROPERTY_FLOAT);
+	prop->float_max    = 1.0;
+	prop->float_step   = 0.01;
+	prop->number_type  = 1;
+	props->add("enabled", "Enabled", PROPERTY_BOOL);
+	props->add("text", "Text", PROPERTY_TEXT)->text_type = 2;
+	prop               = props->add("file", "File", PROPERTY_PATH);
+	prop->filter       = "All files (*.*)";
+	prop->default_path = "/tmp";
+
+	prop               = props->add("device", "Device", PROPERTY_LIST);
+	prop->combo_type   = 2;
+	prop->combo_format = COMBO_FORMAT_STRING;
+	for (size_t idx = 0; idx < type->list_items; idx++) {
+		std::string name = "Device " + std::to_string(idx) + " (" + type->id + ")";
+		prop->items.push_back({name, "device_" + std::to_string(idx), 0, 0, idx % 7 == 6});
+	}
+
+	prop               = props->add("fps", "FPS", PROPERTY_LIST);
+	prop->combo_type   = 2;
+	prop->combo_format = COMBO_FORMAT_INT;
+	for (long long fps : {24, 25, 30, 48, 50, 60})
+		prop->items.push_back({std::to_string(fps), "", fps, 0, false});
+
+	props->add("color", "Color", PROPERTY_COLOR);
+	props->add("refresh", "Refresh", PROPERTY_BUTTON);
+	props->add("playlist", "Playlist", PROPERTY_EDITABLE_LIST)->filter = "Media (*.mp4 *.mkv)";
+
+	prop = props->add("frame_rate", "Frame Rate", PROPERTY_FRAME_RATE);
+	prop->fps_ranges.push_back({{1, 1}, {240, 1}});
+	prop->fps_options.push_back({"match", "Match output FPS"});
+	prop->fps_options.push_back({"native", "Native"});
+
+	prop                = props->add("advanced", "Advanced", PROPERTY_GROUP);
+	prop->group         = new obs_properties;
+	obs_property* inner = prop->group->add("hw_decode", "Use hardware decoding", PROPERTY_BOOL);
+	inner               = prop->group->add("buffering", "Network Buffering (MB)", PROPERTY_INT);
+	inner->int_max      = 16;
+	return props;
+}
+
+extern "C" obs_properties* obs_source_properties(const obs_source* source)
+{
+	return source ? BuildProperties(source->type) : nullptr;
+}
+
+extern "C" void obs_properties_destroy(obs_properties* props)
+{
+	delete props;
+}
+
+extern "C" obs_property* obs_properties_first(obs_properties* props)
+{
+	return props && !props->list.empty() ? props->list.front().get() : nullptr;
+}
+
+extern "C" bool obs_property_next(obs_property** p)
+{
+	if (!p || !*p)
+		return false;
+	*p = (*p)->next;
+	return *p != nullptr;
+}
+
+extern "C" obs_properties* obs_property_group_content(obs_property* p)
+{
+	return p ? p->group : nullptr;
+}
+
+extern "C" const char* obs_property_name(obs_property* p)
+{
+	return p ? p->name.c_str() : nullptr;
+}
+
+extern "C" const char* obs_property_description(obs_property* p)
+{
+	return p ? p->description.c_str() : nullptr;
+}
+
+extern "C" const char* obs_property_long_description(obs_property* p)
+{
+	return p ? p->long_description.c_str() : nullptr;
+}
+
+extern "C" int obs_property_get_type(obs_property* p)
+{
+	return p ? p->type : PROPERTY_INVALID;
+}
+
+extern "C" bool obs_property_enabled(obs_property* p)
+{
+	return p ? p->enabled : false;
+}
+
+extern "C" bool obs_property_visible(obs_property* p)
+{
+	return p ? p->visible : false;
+}
+
+extern "C" int obs_property_int_min(obs_property* p)
+{
+	return p ? p->int_min : 0;
+}
+
+extern "C" int obs_property_int_max(obs_property* p)
+{
+	return p ? p->int_max : 0;
+}
+
+extern "C" int obs_property_int_step(obs_property* p)
+{
+	return p ? p->int_step : 0;
+}
+
+extern "C" int obs_property_int_type(obs_property* p)
+{
+	return p ? p->number_type : 0;
+}
+
+extern "C" double obs_property_float_min(obs_property* p)
+{
+	return p ? p->float_min : 0;
+}
+
+extern "C" double obs_property_float_max(obs_property* p)
+{
+	return p ? p->float_max : 0;
+}
+
+extern "C" double obs_property_float_step(obs_property* p)
+{
+	return p ? p->float_step : 0;
+}
+
+extern "C" int obs_property_float_type(obs_property* p)
+{
+	return p ? p->number_type : 0;
+}
+
+// Spelled like the libobs export.
+extern "C" int obs_proprety_text_type(obs_property* p)
+{
+	return p ? p->text_type : 0;
+}
+
+extern "C" int obs_property_path_type(obs_property* p)
+{
+	return p ? p->path_type : 0;
+}
+
+extern "C" const char* obs_property_path_filter(obs_property* p)
+{
+	return p ? p->filter.c_str() : nullptr;
+}
+
+extern "C" const char* obs_property_path_default_path(obs_property* p)
+{
+	return p ? p->default_path.c_str() : nullptr;
+}
+
+extern "C" int obs_property_list_type(obs_property* p)
+{
+	return p ? p->combo_type : 0;
+}
+
+extern "C" int obs_property_list_format(obs_property* p)
+{
+	return p ? p->combo_format : COMBO_FORMAT_INVALID;
+}
+
+extern "C" size_t obs_property_list_item_count(obs_property* p)
+{
+	return p ? p->items.size() : 0;
+}
+
+static const obs_property::list_item* ListItem(obs_property* p, size_t idx)
+{
+	return p && idx < p->items.size() ? &p->items[idx] : nullptr;
+}
+
+extern "C" const char* obs_property_list_item_name(obs_property* p, size_t idx)
+{
+	auto item = ListItem(p, idx);
+	return item ? item->name.c_str() : nullptr;
+}
+
+extern "C" bool obs_property_list_item_disabled(obs_property* p, size_t idx)
+{
+	auto item = ListItem(p, idx);
+	return item ? item->disabled : false;
+}
+
+extern "C" long long obs_property_list_item_int(obs_property* p, size_t idx)
+{
+	auto item = ListItem(p, idx);
+	return item ? item->value_int : 0;
+}
+
+extern "C" double obs_property_list_item_float(obs_property* p, size_t idx)
+{
+	auto item = ListItem(p, idx);
+	return item ? item->value_float : 0;
+}
+
+extern "C" const char* obs_property_list_item_string(obs_property* p, size_t idx)
+{
+	auto item = ListItem(p, idx);
+	return item ? item->value_string.c_str() : nullptr;
+}
+
+extern "C" int obs_property_editable_list_type(obs_property* p)
+{
+	return p ? p->editable_type : 0;
+}
+
+extern "C" const char* obs_property_editable_list_filter(obs_property* p)
+{
+	return p ? p->filter.c_str() : nullptr;
+}
+
+extern "C" const char* obs_property_editable_list_default_path(obs_property* p)
+{
+	return p ? p->default_path.c_str() : nullptr;
+}
+
+extern "C" size_t obs_property_frame_rate_fps_ranges_count(obs_property* p)
+{
+	return p ? p->fps_ranges.size() : 0;
+}
+
+extern "C" media_frames_per_second obs_property_frame_rate_fps_range_min(obs_property* p, size_t idx)
+{
+	return p && idx < p->fps_ranges.size() ? p->fps_ranges[idx].first : media_frames_per_second{0, 0};
+}
+
+extern "C" media_frames_per_second obs_property_frame_rate_fps_range_max(obs_property* p, size_t idx)
+{
+	return p && idx < p->fps_ranges.size() ? p->fps_ranges[idx].second : media_frames_per_second{0, 0};
+}
+
+extern "C" size_t obs_property_frame_rate_options_count(obs_property* p)
+{
+	return p ? p->fps_options.size() : 0;
+}
+
+extern "C" const char* obs_property_frame_rate_option_name(obs_property* p, size_t idx)
+{
+	return p && idx < p->fps_options.size() ? p->fps_options[idx].first.c_str() : nullptr;
+}
+
+extern "C" const char* obs_property_frame_rate_option_description(obs_property* p, size_t idx)
+{
+	return p && idx < p->fps_options.size() ? p->fps_options[idx].second.c_str() : nullptr;
+}
+
+/* Volume meters */
+
+extern "C" obs_volmeter* obs_volmeter_create(int type)
+{
+	obs_volmeter* meter = new obs_volmeter;
+	meter->fader_type   = type;
+
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	fake.meters.push_back(meter);
+	return meter;
+}
+
+extern "C" void obs_volmeter_destroy(obs_volmeter* meter)
+{
+	if (!meter)
+		return;
+
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	fake.meters.erase(std::remove(fake.meters.begin(), fake.meters.end(), meter), fake.meters.end());
+	delete meter;
+}
+
+extern "C" bool obs_volmeter_attach_source(obs_volmeter* meter, obs_source* source)
+{
+	if (!meter || !source)
+		return false;
+
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	meter->source = source;
+	return true;
+}
+
+extern "C" void obs_volmeter_detach_source(obs_volmeter* meter)
+{
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	if (meter)
+		meter->source = nullptr;
+}
+
+extern "C" void obs_volmeter_add_callback(obs_volmeter* meter, volmeter_updated_t callback, void* param)
+{
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	if (meter)
+		meter->callbacks.push_back({callback, param});
+}
+
+extern "C" void obs_volmeter_remove_callback(obs_volmeter* meter, volmeter_updated_t callback, void* param)
+{
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	if (!meter)
+		return;
+	auto& list = meter->callbacks;
+	for (auto it = list.begin(); it != list.end(); ++it) {
+		if (it->callback == callback && it->param == param) {
+			list.erase(it);
+			break;
+		}
+	}
+}
+
+extern "C" void obs_volmeter_set_update_interval(obs_volmeter* meter, const unsigned int ms)
+{
+	if (meter && ms > 0)
+		meter->update_interval = ms;
+}
+
+extern "C" unsigned int obs_volmeter_get_update_interval(obs_volmeter* meter)
+{
+	return meter ? meter->update_interval : 0;
+}
+
+extern "C" int obs_volmeter_get_nr_channels(obs_volmeter* meter)
+{
+	return (int)fake.audio_channels;
+}
+
+static uint64_t NowMs()
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+	           std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+}
+
+// Stands in for the audio thread: every attached meter receives levels at its update interval.
+static void AudioThread()
+{
+	float    magnitude[MAX_AUDIO_CHANNELS];
+	float    peak[MAX_AUDIO_CHANNELS];
+	float    input_peak[MAX_AUDIO_CHANNELS];
+	uint64_t frame = 0;
+
+	while (fake.audio_running) {
+		uint64_t now = NowMs();
+		for (uint32_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
+			float level    = ch < fake.audio_channels ? -20.0f + 10.0f * std::sin(frame * 0.1f + ch) : -INFINITY;
+			magnitude[ch]  = level - 3.0f;
+			peak[ch]       = level;
+			input_peak[ch] = level;
+		}
+		frame++;
+
+		std::vector<obs_volmeter::callback> due;
+		{
+			std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+			for (obs_volmeter* meter : fake.meters) {
+				if (!meter->source || now < meter->next_update)
+					continue;
+				meter->next_update = now + meter->update_interval;
+				due.insert(due.end(), meter->callbacks.begin(), meter->callbacks.end());
+			}
+		}
+		for (auto& entry : due)
+			entry.callback(entry.param, magnitude, peak, input_peak);
+
+		// One audio tick of 1024 frames at 48kHz.
+		std::this_thread::sleep_for(std::chrono::microseconds(21333));
+	}
+}
+
+extern "C" void fake_obs_startup(uint32_t audio_channels)
+{
+	fake.audio_channels = std::min<uint32_t>(std::max<uint32_t>(audio_channels, 1), MAX_AUDIO_CHANNELS);
+	fake.audio_running  = true;
+	fake.audio_thread   = std::thread(AudioThread);
+}
+
+extern "C" void fake_obs_shutdown(void)
+{
+	fake.audio_running = false;
+	if (fake.audio_thread.joinable())
+		fake.audio_thread.join();
+}
+
+extern "C" void fake_obs_counts(size_t* sources, size_t* items, size_t* meters)
+{
+	std::unique_lock<std::recursive_mutex> ulock(fake.mtx);
+	if (sources)
+		*sources = fake.sources.size();
+	if (items)
+		*items = fake.items;
+	if (meters)
+		*meters = fake.meters.size();
+}
@@ -0,0 +1,40 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Hooks of the in-process libobs replacement used by the IPC benchmark.
+
+// Starts the thread that feeds attached volume meters like the audio thread would.
+void fake_obs_startup(uint32_t audio_channels);
+
+// Stops the audio thread, sources still alive are reported and left as is.
+void fake_obs_shutdown(void);
+
+// Number of sources, scene items and volume meters currently alive.
+void fake_obs_counts(size_t* sources, size_t* items, size_t* meters);
+
+#ifdef __cplusplus
+}
+#endif
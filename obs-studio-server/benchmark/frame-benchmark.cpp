@@ -0,0 +1,171 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+/*
+ * Measures the shared memory frame export without libobs.
+ *
+ * Frames that already sit in system memory, as they do once FrameExport has
+ * mapped a staging surface, are published through shared_frame::writer while
+ * a reader thread acquires them and copies the dirty rows out, as the client
+ * does. Rendering and the GPU download are not part of the numbers.
+ *
+ * Usage: osn-frame-benchmark [--frames N]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "shared-frame.hpp"
+
+struct run_result
+{
+	double   seconds   = 0;
+	uint64_t calls     = 0;
+	uint64_t published = 0;
+	uint64_t acquired  = 0;
+	uint64_t copied    = 0;
+};
+
+// How much of each frame differs from the previous one.
+enum class change
+{
+	Full,
+	Band,
+	None,
+};
+
+static const char* ChangeName(change what)
+{
+	switch (what) {
+	case change::Full:
+		return "full";
+	case change::Band:
+		return "band";
+	case change::None:
+		return "none";
+	}
+	return "";
+}
+
+static run_result Run(uint32_t width, uint32_t height, change what, size_t frames)
+{
+	std::string           name = "osn-frame-benchmark-" + std::to_string(getpid());
+	shared_frame::mapping server_memory, client_memory;
+	shared_frame::writer  writer;
+	shared_frame::reader  reader;
+
+	if (!server_memory.create(name, shared_frame::mapping_size(width, height))
+	    || !writer.init(server_memory, width, height) || !client_memory.open(name) || !reader.init(client_memory))
+		throw std::runtime_error("could not set up the shared memory");
+
+	uint32_t                          linesize = width * 4;
+	std::vector<std::vector<uint8_t>> sources(2, std::vector<uint8_t>(size_t(linesize) * height));
+	std::fill(sources[1].begin(), sources[1].end(), 0xFF);
+	if (what == change::Band) {
+		// Only a 64 pixel high band differs between the two source frames
+		sources[1] = sources[0];
+		std::fill_n(sources[1].begin() + size_t(linesize) * (height / 2), size_t(linesize) * 64, 0xFF);
+	}
+
+	run_result        result;
+	std::atomic<bool> done(false);
+	std::thread       client([&]() {
+		std::vector<uint8_t> target(size_t(linesize) * height);
+		while (true) {
+			bool                      finished = done.load();
+			shared_frame::rect        dirty;
+			const shared_frame::slot* frame = reader.acquire(dirty);
+			if (frame) {
+				const uint8_t* pixels = client_memory.data() + frame->offset;
+				for (uint32_t row = dirty.y; row < dirty.y + dirty.height; row++)
+					memcpy(
+					    target.data() + size_t(row) * linesize + dirty.x * 4,
+					    pixels + size_t(row) * frame->stride + dirty.x * 4,
+					    size_t(dirty.width) * 4);
+				result.copied += size_t(dirty.width) * 4 * dirty.height;
+				result.acquired++;
+			} else if (finished) {
+				break;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	auto begin = std::chrono::steady_clock::now();
+	for (size_t idx = 0; idx < frames; idx++) {
+		const std::vector<uint8_t>& source = sources[what == change::None ? 0 : idx % 2];
+		writer.publish(source.data(), linesize, width, height, idx + 1);
+	}
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	result.calls   = frames;
+	done           = true;
+	client.join();
+
+	result.published = server_memory.get_header()->published.load();
+	return result;
+}
+
+static void Report(uint32_t width, uint32_t height, change what, const run_result& result)
+{
+	printf(
+	    "  %4ux%-4u %-6s %9llu %9llu %10.1f %10.1f\n",
+	    width,
+	    height,
+	    ChangeName(what),
+	    (unsigned long long)result.published,
+	    (unsigned long long)result.acquired,
+	    result.calls / result.seconds,
+	    result.copied / result.seconds / (1024 * 1024));
+}
+
+int main(int argc, char* argv[])
+{
+	size_t frames = 600;
+	for (int idx = 1; idx < argc; idx++) {
+		std::string arg = argv[idx];
+		if (arg == "--frames" && idx + 1 < argc) {
+			frames = std::max<size_t>(1, std::stoul(argv[++idx]));
+		} else {
+			fprintf(stderr, "Unknown option %s\n", arg.c_str());
+			return -1;
+		}
+	}
+
+	printf(
+	    "  %-9s %-6s %9s %9s %10s %10s\n", "size", "change", "published", "acquired", "calls/s", "copy MiB/s");
+
+	const uint32_t sizes[][2] = {{1280, 720}, {1920, 1080}};
+	try {
+		for (auto& size : sizes) {
+			for (change what : {change::Full, change::Band, change::None})
+				Report(size[0], size[1], what, Run(size[0], size[1], what, frames));
+		}
+	} catch (std::exception& e) {
+		fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}
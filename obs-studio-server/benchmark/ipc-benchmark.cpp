@@ -0,0 +1,460 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+/*
+ * Measures the IPC layer of the server without libobs, a GPU or Electron.
+ *
+ * The server collections run in this process on top of the fake backend and
+ * are driven by a native ipc::client over the regular socket transport.
+ * Each workload reports calls per second, latency percentiles and the
+ * approximate number of bytes exchanged per call, per function.
+ *
+ * Usage: osn-ipc-benchmark [--iterations N] [--sources N] [--polls N]
+ *                          [--meters N] [--socket PATH] [--workload NAME]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <ipc-client.hpp>
+#include <ipc-server.hpp>
+#include <ipc-value.hpp>
+#include "nlohmann/json.hpp"
+#include "callback-manager.h"
+#include "error.hpp"
+#include "fake-obs.h"
+#include "osn-input.hpp"
+#include "osn-scene.hpp"
+#include "osn-scenecollection.hpp"
+#include "osn-sceneitem.hpp"
+#include "osn-source.hpp"
+#include "osn-volmeter.hpp"
+#include "utility.hpp"
+
+struct options
+{
+	size_t      iterations = 200;
+	size_t      sources    = 20;
+	size_t      polls      = 20000;
+	size_t      meters     = 8;
+	std::string socket;
+	std::string workload;
+};
+
+struct function_stats
+{
+	std::vector<uint64_t> latencies;
+	uint64_t              request_bytes  = 0;
+	uint64_t              response_bytes = 0;
+};
+
+// Approximate wire size of a value list: a type tag per value plus its payload.
+static uint64_t EstimateSize(const std::vector<ipc::value>& values)
+{
+	uint64_t size = 0;
+	for (auto& value : values) {
+		size += 1;
+		switch (value.type) {
+		case ipc::type::Null:
+			break;
+		case ipc::type::Float:
+		case ipc::type::Int32:
+		case ipc::type::UInt32:
+			size += 4;
+			break;
+		case ipc::type::Double:
+		case ipc::type::Int64:
+		case ipc::type::UInt64:
+			size += 8;
+			break;
+		case ipc::type::String:
+			size += 4 + value.value_str.size();
+			break;
+		case ipc::type::Binary:
+			size += 4 + value.value_bin.size();
+			break;
+		}
+	}
+	return size;
+}
+
+class Workload
+{
+	public:
+	Workload(std::shared_ptr<ipc::client> client, const char* name) : client(client), name(name) {}
+
+	std::vector<ipc::value>
+	    call(const std::string& cname, const std::string& fname, const std::vector<ipc::value>& args)
+	{
+		auto                    begin    = std::chrono::steady_clock::now();
+		std::vector<ipc::value> response = client->call_synchronous_helper(cname, fname, args);
+		auto                    end      = std::chrono::steady_clock::now();
+
+		function_stats& entry = stats[cname + "." + fname];
+		entry.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+		entry.request_bytes += cname.size() + fname.size() + 8 + EstimateSize(args);
+		entry.response_bytes += EstimateSize(response);
+
+		if (response.empty() || response[0].type != ipc::type::UInt64
+		    || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok) {
+			std::string message = name + ": " + cname + "." + fname + " failed";
+			if (response.size() > 1 && response[1].type == ipc::type::String)
+				message += " (" + response[1].value_str + ")";
+			throw std::runtime_error(message);
+		}
+		return response;
+	}
+
+	void start()
+	{
+		begin = std::chrono::steady_clock::now();
+	}
+
+	void stop()
+	{
+		end = std::chrono::steady_clock::now();
+	}
+
+	void report() const
+	{
+		double seconds = std::chrono::duration<double>(end - begin).count();
+		size_t calls   = 0;
+		for (auto& entry : stats)
+			calls += entry.second.latencies.size();
+
+		printf("\n%s: %.3f s, %zu calls, %.0f calls/s\n", name.c_str(), seconds, calls, calls / seconds);
+		printf(
+		    "  %-30s %8s %10s %9s %9s %9s %9s %9s %9s\n",
+		    "function",
+		    "calls",
+		    "calls/s",
+		    "p50 us",
+		    "p90 us",
+		    "p99 us",
+		    "max us",
+		    "req B",
+		    "resp B");
+
+		for (auto& entry : stats) {
+			std::vector<uint64_t> sorted = entry.second.latencies;
+			std::sort(sorted.begin(), sorted.end());
+
+			auto percentile = [&sorted](double p) {
+				size_t idx = std::min(sorted.size() - 1, size_t(p * (sorted.size() - 1) + 0.5));
+				return sorted[idx] / 1000.0;
+			};
+
+			uint64_t total = 0;
+			for (uint64_t latency : sorted)
+				total += latency;
+
+			printf(
+			    "  %-30s %8zu %10.0f %9.1f %9.1f %9.1f %9.1f %9.0f %9.0f\n",
+			    entry.first.c_str(),
+			    sorted.size(),
+			    sorted.size() / (total / 1e9),
+			    percentile(0.50),
+			    percentile(0.90),
+			    percentile(0.99),
+			    sorted.back() / 1000.0,
+			    double(entry.second.request_bytes) / sorted.size(),
+			    double(entry.second.response_bytes) / sorted.size());
+		}
+	}
+
+	private:
+	std::shared_ptr<ipc::client>          client;
+	std::string                           name;
+	std::map<std::string, function_stats> stats;
+
+	std::chrono::steady_clock::time_point begin, end;
+};
+
+static const char* input_types[] = {"image_source", "color_source", "ffmpeg_source", "browser_source", "text_gdiplus"};
+
+static std::string InputSettings(size_t idx)
+{
+	nlohmann::json settings = {
+	    {"file", "/home/user/Videos/clip_" + std::to_string(idx) + ".mp4"},
+	    {"text", "Source " + std::to_string(idx)},
+	    {"width", 1280},
+	    {"height", 720},
+	    {"color", 0xFF3366AA}};
+	return settings.dump();
+}
+
+// Builds a scene from individual calls, the way the client loads a collection today.
+static void SceneLoad(std::shared_ptr<ipc::client> client, const options& opts)
+{
+	Workload work(client, "scene load (per call)");
+	work.start();
+
+	for (size_t it = 0; it < opts.iterations; it++) {
+		std::string prefix = "scene-" + std::to_string(it);
+		uint64_t    scene  = work.call("Scene", "Create", {ipc::value(prefix)})[1].value_union.ui64;
+
+		std::vector<uint64_t> inputs, items;
+		for (size_t idx = 0; idx < opts.sources; idx++) {
+			std::string name = prefix + "-input-" + std::to_string(idx);
+			std::vector<ipc::value> args = {
+			    ipc::value(input_types[idx % 5]), ipc::value(name), ipc::value(InputSettings(idx)), ipc::value("{}")};
+
+			auto rval = work.call("Input", "Create", args);
+			inputs.push_back(rval[1].value_union.ui64);
+
+			rval = work.call("Scene", "AddSource", {ipc::value(scene), ipc::value(inputs.back())});
+			items.push_back(rval[1].value_union.ui64);
+
+			work.call(
+			    "SceneItem",
+			    "SetPosition",
+			    {ipc::value(items.back()), ipc::value(float(idx * 10)), ipc::value(float(idx * 5))});
+		}
+
+		work.call("Scene", "GetItems", {ipc::value(scene)});
+
+		for (uint64_t item : items)
+			work.call("SceneItem", "Remove", {ipc::value(item)});
+		for (uint64_t input : inputs) {
+			work.call("Source", "Remove", {ipc::value(input)});
+			work.call("Source", "Release", {ipc::value(input)});
+		}
+		work.call("Source", "Release", {ipc::value(scene)});
+	}
+
+	work.stop();
+	work.report();
+}
+
+// Same scene through the bulk SceneCollection.Load call.
+static void SceneLoadBulk(std::shared_ptr<ipc::client> client, const options& opts)
+{
+	Workload work(client, "scene load (bulk)");
+	work.start();
+
+	for (size_t it = 0; it < opts.iterations; it++) {
+		std::string    prefix = "bulk-" + std::to_string(it);
+		nlohmann::json inputs = nlohmann::json::array(), items = nlohmann::json::array();
+		for (size_t idx = 0; idx < opts.sources; idx++) {
+			std::string name = prefix + "-input-" + std::to_string(idx);
+			inputs.push_back(
+			    {{"id", input_types[idx % 5]},
+			     {"name", name},
+			     {"settings", nlohmann::json::parse(InputSettings(idx))}});
+			items.push_back({{"source", name}, {"x", idx * 10}, {"y", idx * 5}});
+		}
+		nlohmann::json collection = {
+		    {"inputs", inputs}, {"scenes", nlohmann::json::array({{{"name", prefix}, {"items", items}}})}};
+
+		auto                     rval = work.call("SceneCollection", "Load", {ipc::value(collection.dump())});
+		const std::vector<char>& bin  = rval[1].value_bin;
+		std::vector<uint64_t>    packed(bin.size() / sizeof(uint64_t));
+		memcpy(packed.data(), bin.data(), packed.size() * sizeof(uint64_t));
+
+		// Per input: uid, mixers, filter count (0). Then the scene: uid, filter count (0), item count, pairs.
+		size_t                pos = 0;
+		std::vector<uint64_t> input_uids;
+		for (size_t idx = 0; idx < opts.sources; idx++, pos += 3)
+			input_uids.push_back(packed[pos]);
+		uint64_t scene = packed[pos];
+		size_t   count = packed[pos + 2];
+		pos += 3;
+
+		for (size_t idx = 0; idx < count; idx++, pos += 2)
+			work.call("SceneItem", "Remove", {ipc::value(packed[pos])});
+		for (uint64_t input : input_uids) {
+			work.call("Source", "Remove", {ipc::value(input)});
+			work.call("Source", "Release", {ipc::value(input)});
+		}
+		work.call("Source", "Release", {ipc::value(scene)});
+	}
+
+	work.stop();
+	work.report();
+}
+
+// Volume meters polled as fast as the client can, while the fake audio thread publishes levels.
+static void MeterPolling(std::shared_ptr<ipc::client> client, const options& opts)
+{
+	Workload work(client, "meter polling");
+
+	std::vector<uint64_t> inputs, meters;
+	for (size_t idx = 0; idx < opts.meters; idx++) {
+		std::string name = "meter-input-" + std::to_string(idx);
+		auto rval = work.call("Input", "Create", {ipc::value("wasapi_input_capture"), ipc::value(name)});
+		inputs.push_back(rval[1].value_union.ui64);
+
+		rval = work.call("Volmeter", "Create", {ipc::value(int32_t(0))});
+		meters.push_back(rval[1].value_union.ui64);
+		work.call("Volmeter", "Attach", {ipc::value(meters.back()), ipc::value(inputs.back())});
+		work.call("Volmeter", "AddCallback", {ipc::value(meters.back())});
+	}
+
+	work.start();
+	for (size_t poll = 0; poll < opts.polls; poll++)
+		work.call("Volmeter", "Query", {ipc::value(meters[poll % meters.size()])});
+	work.stop();
+
+	for (size_t idx = 0; idx < meters.size(); idx++) {
+		work.call("Volmeter", "RemoveCallback", {ipc::value(meters[idx])});
+		work.call("Volmeter", "Destroy", {ipc::value(meters[idx])});
+		work.call("Source", "Remove", {ipc::value(inputs[idx])});
+		work.call("Source", "Release", {ipc::value(inputs[idx])});
+	}
+
+	work.report();
+}
+
+// Opening the properties window of an input: its properties and its current settings.
+static void SettingsOpen(std::shared_ptr<ipc::client> client, const options& opts)
+{
+	Workload work(client, "settings open");
+
+	auto rval = work.call(
+	    "Input", "Create", {ipc::value("browser_source"), ipc::value("settings-input"), ipc::value(InputSettings(0))});
+	uint64_t input = rval[1].value_union.ui64;
+
+	work.start();
+	for (size_t it = 0; it < opts.iterations; it++) {
+		work.call("Source", "GetProperties", {ipc::value(input)});
+		work.call("Source", "GetSettings", {ipc::value(input)});
+	}
+	work.stop();
+
+	work.call("Source", "Remove", {ipc::value(input)});
+	work.call("Source", "Release", {ipc::value(input)});
+	work.report();
+}
+
+static bool ParseOptions(int argc, char* argv[], options& opts)
+{
+	for (int idx = 1; idx < argc; idx++) {
+		std::string arg = argv[idx];
+		if (idx + 1 >= argc) {
+			fprintf(stderr, "Missing value for %s\n", arg.c_str());
+			return false;
+		}
+
+		std::string value = argv[++idx];
+		if (arg == "--iterations")
+			opts.iterations = std::stoul(value);
+		else if (arg == "--sources")
+			opts.sources = std::stoul(value);
+		else if (arg == "--polls")
+			opts.polls = std::stoul(value);
+		else if (arg == "--meters")
+			opts.meters = std::max<size_t>(1, std::stoul(value));
+		else if (arg == "--socket")
+			opts.socket = value;
+		else if (arg == "--workload")
+			opts.workload = value;
+		else {
+			fprintf(stderr, "Unknown option %s\n", arg.c_str());
+			return false;
+		}
+	}
+
+	if (opts.socket.empty())
+		opts.socket = "/tmp/osn-ipc-benchmark-" + std::to_string(getpid());
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	options opts;
+	if (!ParseOptions(argc, argv, opts))
+		return -1;
+
+	utility::osn_current_version("benchmark");
+	fake_obs_startup(2);
+	osn::Source::initialize_global_signals();
+
+	ipc::server server;
+	osn::Source::Register(server);
+	osn::Input::Register(server);
+	osn::Scene::Register(server);
+	osn::SceneItem::Register(server);
+	osn::SceneCollection::Register(server);
+	osn::Volmeter::Register(server);
+	CallbackManager::Register(server);
+
+	try {
+		server.initialize(opts.socket.c_str());
+	} catch (std::exception& e) {
+		fprintf(stderr, "Server initialization failed: %s\n", e.what());
+		return -2;
+	}
+
+	std::shared_ptr<ipc::client> client;
+	for (int attempt = 0; !client && attempt < 50; attempt++) {
+		try {
+			client = ipc::client::create(opts.socket);
+		} catch (...) {
+			client = nullptr;
+		}
+		if (!client)
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+	if (!client) {
+		fprintf(stderr, "Could not connect to %s\n", opts.socket.c_str());
+		server.finalize();
+		return -3;
+	}
+
+	struct
+	{
+		const char* name;
+		void (*run)(std::shared_ptr<ipc::client>, const options&);
+	} workloads[] = {
+	    {"scene-load", SceneLoad},
+	    {"scene-load-bulk", SceneLoadBulk},
+	    {"meter-polling", MeterPolling},
+	    {"settings-open", SettingsOpen},
+	};
+
+	int result = 0;
+	try {
+		for (auto& workload : workloads) {
+			if (opts.workload.empty() || opts.workload == workload.name)
+				workload.run(client, opts);
+		}
+	} catch (std::exception& e) {
+		fprintf(stderr, "%s\n", e.what());
+		result = 1;
+	}
+
+	size_t sources, items, meters;
+	fake_obs_counts(&sources, &items, &meters);
+	if (sources || items || meters)
+		printf("\nleft alive: %zu sources, %zu scene items, %zu meters\n", sources, items, meters);
+
+	client = nullptr;
+	server.finalize();
+	osn::Source::finalize_global_signals();
+	fake_obs_shutdown();
+	return result;
+}
@@ -0,0 +1,34 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "memory-manager.h"
+
+// The media file cache watches real files and memory usage, none of which exist
+// behind the fake backend. Only the entry points used by the source handlers are kept.
+
+MemoryManager::MemoryManager() : total_memory(0), available_memory(0), process_rss(0), current_cached_size(0),
+    allowed_cached_size(0), max_cached_size(0), evictions(0), readmissions(0)
+{}
+
+MemoryManager::~MemoryManager() {}
+
+void MemoryManager::registerSource(obs_source_t* source) {}
+
+void MemoryManager::unregisterSource(obs_source_t* source) {}
+
+void MemoryManager::updateSourceCache(obs_source_t* source) {}
@@ -0,0 +1,247 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+/*
+ * Compares the round trip cost of the IPC transports on Linux.
+ *
+ * The same echo handler is served by the lib-streamlabs-ipc server and by the
+ * SOCK_SEQPACKET transport in uds-transport.cpp, and driven by one or more
+ * client threads with payloads from a few bytes up to several megabytes.
+ * Payloads above uds::max_inline_size go through a memfd on the seqpacket
+ * transport. No libobs is involved, only the transports are measured.
+ *
+ * Usage: osn-transport-benchmark [--calls N] [--threads N] [--max-size BYTES]
+ *                                [--transport lib|uds] [--socket-dir PATH]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <ipc-client.hpp>
+#include <ipc-server.hpp>
+#include <ipc-value.hpp>
+#include "error.hpp"
+#include "uds-transport.hpp"
+
+struct options
+{
+	size_t      calls    = 20000;
+	size_t      threads  = 1;
+	size_t      max_size = 16 * 1024 * 1024;
+	std::string transport;
+	std::string socket_dir = "/tmp";
+};
+
+// Answers with Ok followed by the arguments it received.
+static void Echo(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.insert(rval.end(), args.begin(), args.end());
+}
+
+struct run_result
+{
+	double                seconds = 0;
+	std::vector<uint64_t> latencies;
+};
+
+template<typename Client>
+static run_result Run(std::function<std::shared_ptr<Client>()> connect, size_t size, size_t calls, size_t threads)
+{
+	std::vector<std::shared_ptr<Client>> clients;
+	for (size_t idx = 0; idx < threads; idx++) {
+		auto client = connect();
+		if (!client)
+			throw std::runtime_error("could not connect");
+		clients.push_back(client);
+	}
+
+	std::vector<std::vector<uint64_t>> latencies(threads);
+	std::vector<std::string>           errors(threads);
+	std::vector<std::thread>           workers;
+	std::vector<char>                  payload(size, 'x');
+
+	auto begin = std::chrono::steady_clock::now();
+	for (size_t idx = 0; idx < threads; idx++) {
+		workers.emplace_back([&, idx]() {
+			std::vector<ipc::value> args = {ipc::value(payload)};
+			for (size_t call = idx; call < calls; call += threads) {
+				auto start    = std::chrono::steady_clock::now();
+				auto response = clients[idx]->call_synchronous_helper("Benchmark", "Echo", args);
+				auto end      = std::chrono::steady_clock::now();
+
+				if (response.size() != 2 || response[1].value_bin.size() != size) {
+					errors[idx] = "echo of " + std::to_string(size) + " bytes failed";
+					return;
+				}
+				latencies[idx].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+			}
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+
+	run_result result;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	for (size_t idx = 0; idx < threads; idx++) {
+		if (!errors[idx].empty())
+			throw std::runtime_error(errors[idx]);
+		result.latencies.insert(result.latencies.end(), latencies[idx].begin(), latencies[idx].end());
+	}
+	std::sort(result.latencies.begin(), result.latencies.end());
+	return result;
+}
+
+static void Report(const char* transport, size_t size, size_t threads, const run_result& result)
+{
+	auto percentile = [&result](double p) {
+		size_t idx = std::min(result.latencies.size() - 1, size_t(p * (result.latencies.size() - 1) + 0.5));
+		return result.latencies[idx] / 1000.0;
+	};
+
+	size_t calls = result.latencies.size();
+	printf(
+	    "  %-9s %10zu %7zu %8zu %10.0f %10.1f %9.1f %9.1f %9.1f\n",
+	    transport,
+	    size,
+	    threads,
+	    calls,
+	    calls / result.seconds,
+	    2.0 * size * calls / result.seconds / (1024 * 1024),
+	    percentile(0.50),
+	    percentile(0.99),
+	    result.latencies.back() / 1000.0);
+}
+
+static bool ParseOptions(int argc, char* argv[], options& opts)
+{
+	for (int idx = 1; idx < argc; idx++) {
+		std::string arg = argv[idx];
+		if (idx + 1 >= argc) {
+			fprintf(stderr, "Missing value for %s\n", arg.c_str());
+			return false;
+		}
+
+		std::string value = argv[++idx];
+		if (arg == "--calls")
+			opts.calls = std::max<size_t>(1, std::stoul(value));
+		else if (arg == "--threads")
+			opts.threads = std::max<size_t>(1, std::stoul(value));
+		else if (arg == "--max-size")
+			opts.max_size = std::stoul(value);
+		else if (arg == "--transport")
+			opts.transport = value;
+		else if (arg == "--socket-dir")
+			opts.socket_dir = value;
+		else {
+			fprintf(stderr, "Unknown option %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	options opts;
+	if (!ParseOptions(argc, argv, opts))
+		return -1;
+
+	std::string prefix   = opts.socket_dir + "/osn-transport-" + std::to_string(getpid());
+	std::string lib_path = prefix + "-lib";
+	std::string uds_path = prefix + "-uds";
+
+	ipc::server lib_server;
+	{
+		std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Benchmark");
+		cls->register_function(
+		    std::make_shared<ipc::function>("Echo", std::vector<ipc::type>{ipc::type::Binary}, Echo));
+		lib_server.register_collection(cls);
+	}
+
+	uds::server uds_server;
+	uds_server.register_function("Benchmark", "Echo", Echo);
+
+	try {
+		lib_server.initialize(lib_path.c_str());
+		uds_server.initialize(uds_path);
+	} catch (std::exception& e) {
+		fprintf(stderr, "Server initialization failed: %s\n", e.what());
+		return -2;
+	}
+
+	std::function<std::shared_ptr<ipc::client>()> lib_connect = [&lib_path]() {
+		std::shared_ptr<ipc::client> client;
+		for (int attempt = 0; !client && attempt < 50; attempt++) {
+			try {
+				client = ipc::client::create(lib_path);
+			} catch (...) {
+				client = nullptr;
+			}
+			if (!client)
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+		return client;
+	};
+	std::function<std::shared_ptr<uds::client>()> uds_connect = [&uds_path]() {
+		return uds::client::create(uds_path);
+	};
+
+	printf(
+	    "  %-9s %10s %7s %8s %10s %10s %9s %9s %9s\n",
+	    "transport",
+	    "payload B",
+	    "threads",
+	    "calls",
+	    "calls/s",
+	    "MiB/s",
+	    "p50 us",
+	    "p99 us",
+	    "max us");
+
+	int result = 0;
+	try {
+		for (size_t size = 0; size <= opts.max_size; size = size ? size * 16 : 16) {
+			// Keep the amount of data per run bounded for the large payloads
+			size_t budget = (256u << 20) / std::max<size_t>(size, 1);
+			size_t calls  = std::max<size_t>(opts.threads * 4, std::min(opts.calls, budget));
+
+			for (size_t threads = 1; threads <= opts.threads; threads *= 2) {
+				if (opts.transport.empty() || opts.transport == "lib")
+					Report("lib", size, threads, Run(lib_connect, size, calls, threads));
+				if (opts.transport.empty() || opts.transport == "uds")
+					Report("uds", size, threads, Run(uds_connect, size, calls, threads));
+			}
+		}
+	} catch (std::exception& e) {
+		fprintf(stderr, "%s\n", e.what());
+		result = 1;
+	}
+
+	uds_server.finalize();
+	lib_server.finalize();
+	return result;
+}
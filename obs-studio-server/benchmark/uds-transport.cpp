@@ -0,0 +1,573 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "uds-transport.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+	struct message_header
+	{
+		uint32_t magic;
+		uint32_t flags;
+		uint64_t id;
+		uint64_t size;
+	};
+
+	const uint32_t message_magic = 0x314e534f; // "OSN1"
+	const uint32_t message_fd    = 1;          // Payload is in the attached memfd
+
+	// Received payload, either in the receive buffer or in a mapped memfd.
+	struct payload_view
+	{
+		const char* data     = nullptr;
+		size_t      size     = 0;
+		void*       map      = nullptr;
+		size_t      map_size = 0;
+
+		payload_view() = default;
+		payload_view(payload_view const&) = delete;
+		void operator=(payload_view const&) = delete;
+
+		~payload_view()
+		{
+			if (map)
+				munmap(map, map_size);
+		}
+	};
+
+	// A reply that can't be queued within this time drops the client instead of stalling the others
+	const auto send_timeout = std::chrono::milliseconds(2000);
+
+	bool wait_writable(int fd, std::chrono::steady_clock::time_point deadline)
+	{
+		struct pollfd pfd = {fd, POLLOUT, 0};
+		int           ret;
+		do {
+			auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+			    deadline - std::chrono::steady_clock::now());
+			if (left.count() <= 0)
+				return false;
+			ret = poll(&pfd, 1, int(left.count()));
+		} while (ret < 0 && errno == EINTR);
+		return ret > 0 && !(pfd.revents & (POLLERR | POLLHUP));
+	}
+
+	bool send_message(int fd, uint64_t id, const std::vector<char>& payload)
+	{
+		message_header header = {message_magic, 0, id, payload.size()};
+		struct iovec   iov[2];
+		struct msghdr  msg = {};
+		union
+		{
+			char           buf[CMSG_SPACE(sizeof(int))];
+			struct cmsghdr align;
+		} control;
+
+		int memfd = -1;
+		if (payload.size() > uds::max_inline_size) {
+			memfd = memfd_create("osn-ipc", MFD_CLOEXEC);
+			if (memfd < 0)
+				return false;
+
+			size_t written = 0;
+			while (written < payload.size()) {
+				ssize_t ret = write(memfd, payload.data() + written, payload.size() - written);
+				if (ret < 0 && errno == EINTR)
+					continue;
+				if (ret <= 0) {
+					close(memfd);
+					return false;
+				}
+				written += size_t(ret);
+			}
+
+			header.flags = message_fd;
+			memset(&control, 0, sizeof(control));
+			msg.msg_control             = control.buf;
+			msg.msg_controllen          = sizeof(control.buf);
+			struct cmsghdr* cmsg        = CMSG_FIRSTHDR(&msg);
+			cmsg->cmsg_level            = SOL_SOCKET;
+			cmsg->cmsg_type             = SCM_RIGHTS;
+			cmsg->cmsg_len              = CMSG_LEN(sizeof(int));
+			memcpy(CMSG_DATA(cmsg), &memfd, sizeof(int));
+		}
+
+		iov[0].iov_base = &header;
+		iov[0].iov_len  = sizeof(header);
+		iov[1].iov_base = const_cast<char*>(payload.data());
+		iov[1].iov_len  = (memfd < 0) ? payload.size() : 0;
+		msg.msg_iov     = iov;
+		msg.msg_iovlen  = 2;
+
+		bool sent     = false;
+		auto deadline = std::chrono::steady_clock::now() + send_timeout;
+		while (true) {
+			if (sendmsg(fd, &msg, MSG_NOSIGNAL) >= 0) {
+				sent = true;
+				break;
+			}
+			if (errno == EINTR)
+				continue;
+			if ((errno == EAGAIN || errno == EWOULDBLOCK) && wait_writable(fd, deadline))
+				continue;
+			break;
+		}
+
+		// The receiver holds its own descriptor once the message is queued
+		if (memfd >= 0)
+			close(memfd);
+		return sent;
+	}
+
+	// Returns 1 when a message was received, 0 when none is pending and -1 when the peer is gone.
+	int receive_message(int fd, std::vector<char>& buffer, message_header& header, payload_view& payload)
+	{
+		buffer.resize(sizeof(message_header) + uds::max_inline_size);
+
+		struct iovec  iov = {buffer.data(), buffer.size()};
+		struct msghdr msg = {};
+		union
+		{
+			char           buf[CMSG_SPACE(sizeof(int))];
+			struct cmsghdr align;
+		} control;
+		msg.msg_iov        = &iov;
+		msg.msg_iovlen     = 1;
+		msg.msg_control    = control.buf;
+		msg.msg_controllen = sizeof(control.buf);
+
+		ssize_t ret;
+		do {
+			ret = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+		} while (ret < 0 && errno == EINTR);
+
+		if (ret < 0)
+			return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+		if (ret == 0)
+			return -1;
+
+		int memfd = -1;
+		for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+			if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+				memcpy(&memfd, CMSG_DATA(cmsg), sizeof(int));
+		}
+
+		if (size_t(ret) < sizeof(message_header) || (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+			if (memfd >= 0)
+				close(memfd);
+			return -1;
+		}
+
+		memcpy(&header, buffer.data(), sizeof(header));
+		if (header.magic != message_magic) {
+			if (memfd >= 0)
+				close(memfd);
+			return -1;
+		}
+
+		if (header.flags & message_fd) {
+			if (memfd < 0)
+				return -1;
+
+			// A memfd shorter than the header claims would fault on access instead of failing here
+			struct stat info;
+			if (fstat(memfd, &info) < 0 || uint64_t(info.st_size) < header.size) {
+				close(memfd);
+				return -1;
+			}
+
+			payload.map_size = header.size;
+			payload.map      = header.size ? mmap(nullptr, header.size, PROT_READ, MAP_PRIVATE, memfd, 0) : nullptr;
+			close(memfd);
+			if (payload.map == MAP_FAILED) {
+				payload.map = nullptr;
+				return -1;
+			}
+			payload.data = static_cast<const char*>(payload.map);
+			payload.size = header.size;
+		} else {
+			if (memfd >= 0)
+				close(memfd);
+			if (header.size != size_t(ret) - sizeof(message_header))
+				return -1;
+			payload.data = buffer.data() + sizeof(message_header);
+			payload.size = header.size;
+		}
+		return 1;
+	}
+
+	void append(std::vector<char>& buffer, const void* data, size_t size)
+	{
+		const char* bytes = static_cast<const char*>(data);
+		buffer.insert(buffer.end(), bytes, bytes + size);
+	}
+
+	bool read_name(const char* data, size_t size, size_t& offset, std::string& name)
+	{
+		uint16_t length;
+		if (offset + sizeof(length) > size)
+			return false;
+		memcpy(&length, data + offset, sizeof(length));
+		offset += sizeof(length);
+
+		if (offset + length > size)
+			return false;
+		name.assign(data + offset, length);
+		offset += length;
+		return true;
+	}
+
+	void write_name(std::vector<char>& buffer, const std::string& name)
+	{
+		uint16_t length = uint16_t(std::min<size_t>(name.size(), UINT16_MAX));
+		append(buffer, &length, sizeof(length));
+		append(buffer, name.data(), length);
+	}
+
+	bool make_address(const std::string& path, struct sockaddr_un& addr)
+	{
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		if (path.size() >= sizeof(addr.sun_path))
+			return false;
+		memcpy(addr.sun_path, path.c_str(), path.size());
+		return true;
+	}
+} // namespace
+
+void uds::serialize(std::vector<char>& buffer, const std::vector<ipc::value>& values)
+{
+	for (auto& value : values) {
+		uint8_t tag = uint8_t(value.type);
+		append(buffer, &tag, sizeof(tag));
+
+		switch (value.type) {
+		case ipc::type::Null:
+			break;
+		case ipc::type::Float:
+		case ipc::type::Int32:
+		case ipc::type::UInt32:
+			append(buffer, &value.value_union, 4);
+			break;
+		case ipc::type::Double:
+		case ipc::type::Int64:
+		case ipc::type::UInt64:
+			append(buffer, &value.value_union, 8);
+			break;
+		case ipc::type::String: {
+			uint32_t length = uint32_t(value.value_str.size());
+			append(buffer, &length, sizeof(length));
+			append(buffer, value.value_str.data(), length);
+			break;
+		}
+		case ipc::type::Binary: {
+			uint32_t length = uint32_t(value.value_bin.size());
+			append(buffer, &length, sizeof(length));
+			append(buffer, value.value_bin.data(), length);
+			break;
+		}
+		}
+	}
+}
+
+bool uds::deserialize(const char* data, size_t size, size_t offset, std::vector<ipc::value>& values)
+{
+	while (offset < size) {
+		ipc::type type = ipc::type(uint8_t(data[offset++]));
+
+		switch (type) {
+		case ipc::type::Null: {
+			ipc::value value((uint64_t)0);
+			value.type = ipc::type::Null;
+			values.push_back(value);
+			break;
+		}
+		case ipc::type::Float:
+		case ipc::type::Int32:
+		case ipc::type::UInt32: {
+			if (offset + 4 > size)
+				return false;
+			ipc::value value((uint32_t)0);
+			memcpy(&value.value_union, data + offset, 4);
+			value.type = type;
+			values.push_back(value);
+			offset += 4;
+			break;
+		}
+		case ipc::type::Double:
+		case ipc::type::Int64:
+		case ipc::type::UInt64: {
+			if (offset + 8 > size)
+				return false;
+			ipc::value value((uint64_t)0);
+			memcpy(&value.value_union, data + offset, 8);
+			value.type = type;
+			values.push_back(value);
+			offset += 8;
+			break;
+		}
+		case ipc::type::String:
+		case ipc::type::Binary: {
+			uint32_t length;
+			if (offset + sizeof(length) > size)
+				return false;
+			memcpy(&length, data + offset, sizeof(length));
+			offset += sizeof(length);
+			if (offset + length > size)
+				return false;
+
+			if (type == ipc::type::String)
+				values.push_back(ipc::value(std::string(data + offset, length)));
+			else
+				values.push_back(ipc::value(std::vector<char>(data + offset, data + offset + length)));
+			offset += length;
+			break;
+		}
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+uds::server::server() {}
+
+uds::server::~server()
+{
+	finalize();
+}
+
+void uds::server::register_function(
+    const std::string& cname,
+    const std::string& fname,
+    call_handler_t     handler,
+    void*              data)
+{
+	m_functions[cname + "." + fname] = {handler, data};
+}
+
+void uds::server::initialize(const std::string& path)
+{
+	struct sockaddr_un addr;
+	if (!make_address(path, addr))
+		throw std::runtime_error("Socket path is too long: " + path);
+
+	m_listen = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (m_listen < 0)
+		throw std::runtime_error(std::string("socket: ") + strerror(errno));
+
+	// A server that crashed leaves its socket file behind
+	unlink(path.c_str());
+	if (bind(m_listen, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(m_listen, 16) < 0) {
+		std::string error = strerror(errno);
+		close(m_listen);
+		m_listen = -1;
+		throw std::runtime_error("bind: " + error);
+	}
+	m_path = path;
+
+	m_epoll = epoll_create1(EPOLL_CLOEXEC);
+	m_wake  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_epoll < 0 || m_wake < 0) {
+		finalize();
+		throw std::runtime_error(std::string("epoll: ") + strerror(errno));
+	}
+
+	struct epoll_event event = {};
+	event.events             = EPOLLIN;
+	event.data.fd            = m_listen;
+	epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listen, &event);
+	event.data.fd = m_wake;
+	epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &event);
+
+	m_stop   = false;
+	m_worker = std::thread(&uds::server::worker, this);
+}
+
+void uds::server::finalize()
+{
+	if (m_worker.joinable()) {
+		m_stop         = true;
+		uint64_t value = 1;
+		if (write(m_wake, &value, sizeof(value)) < 0) {
+			// The worker also wakes up from its epoll timeout
+		}
+		m_worker.join();
+	}
+
+	while (!m_clients.empty())
+		close_client(m_clients.begin()->first);
+
+	if (m_listen >= 0) {
+		close(m_listen);
+		unlink(m_path.c_str());
+		m_listen = -1;
+	}
+	if (m_epoll >= 0) {
+		close(m_epoll);
+		m_epoll = -1;
+	}
+	if (m_wake >= 0) {
+		close(m_wake);
+		m_wake = -1;
+	}
+}
+
+void uds::server::worker()
+{
+	struct epoll_event events[32];
+
+	while (!m_stop) {
+		int count = epoll_wait(m_epoll, events, 32, 500);
+		if (count < 0 && errno != EINTR)
+			break;
+
+		for (int idx = 0; idx < count; idx++) {
+			int fd = events[idx].data.fd;
+
+			if (fd == m_wake) {
+				continue;
+			} else if (fd == m_listen) {
+				int client;
+				while ((client = accept4(m_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+					struct epoll_event event = {};
+					event.events             = EPOLLIN | EPOLLRDHUP;
+					event.data.fd            = client;
+					epoll_ctl(m_epoll, EPOLL_CTL_ADD, client, &event);
+					m_clients[client] = m_next_cid++;
+				}
+			} else {
+				auto client = m_clients.find(fd);
+				if (client == m_clients.end())
+					continue;
+
+				// Pending calls are answered before a hang up is handled
+				bool alive = receive(fd, client->second);
+				if (!alive || (events[idx].events & (EPOLLERR | EPOLLHUP)))
+					close_client(fd);
+			}
+		}
+	}
+}
+
+bool uds::server::receive(int fd, int64_t cid)
+{
+	while (true) {
+		message_header header;
+		payload_view   payload;
+
+		int ret = receive_message(fd, m_buffer, header, payload);
+		if (ret <= 0)
+			return ret == 0;
+
+		std::string             cname, fname;
+		size_t                  offset = 0;
+		std::vector<ipc::value> args, rval;
+		if (!read_name(payload.data, payload.size, offset, cname)
+		    || !read_name(payload.data, payload.size, offset, fname)
+		    || !deserialize(payload.data, payload.size, offset, args))
+			return false;
+
+		auto function = m_functions.find(cname + "." + fname);
+		if (function == m_functions.end()) {
+			ipc::value error((uint64_t)0);
+			error.type = ipc::type::Null;
+			rval.push_back(error);
+			rval.push_back(ipc::value("Function " + cname + "." + fname + " is not registered"));
+		} else {
+			function->second.handler(function->second.data, cid, args, rval);
+		}
+
+		std::vector<char> response;
+		serialize(response, rval);
+		if (!send_message(fd, header.id, response))
+			return false;
+	}
+}
+
+void uds::server::close_client(int fd)
+{
+	epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+	close(fd);
+	m_clients.erase(fd);
+}
+
+std::shared_ptr<uds::client> uds::client::create(const std::string& path)
+{
+	struct sockaddr_un addr;
+	if (!make_address(path, addr))
+		return nullptr;
+
+	int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return nullptr;
+
+	if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+		close(fd);
+		return nullptr;
+	}
+	return std::make_shared<uds::client>(fd);
+}
+
+uds::client::client(int fd) : m_fd(fd) {}
+
+uds::client::~client()
+{
+	close(m_fd);
+}
+
+std::vector<ipc::value> uds::client::call_synchronous_helper(
+    const std::string&             cname,
+    const std::string&             fname,
+    const std::vector<ipc::value>& args)
+{
+	std::unique_lock<std::mutex> ulock(m_lock);
+	uint64_t                     id = m_next_id++;
+
+	std::vector<char> request;
+	write_name(request, cname);
+	write_name(request, fname);
+	serialize(request, args);
+	if (!send_message(m_fd, id, request))
+		return {};
+
+	// Calls are serialized by the lock, so the next reply is the one for this call
+	message_header header;
+	payload_view   payload;
+	if (receive_message(m_fd, m_buffer, header, payload) != 1 || header.id != id)
+		return {};
+
+	std::vector<ipc::value> rval;
+	if (!deserialize(payload.data, payload.size, 0, rval))
+		return {};
+	return rval;
+}
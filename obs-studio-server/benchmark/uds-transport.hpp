@@ -0,0 +1,121 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <ipc-value.hpp>
+
+/*
+ * Linux transport for the client/server calls on a SOCK_SEQPACKET unix socket.
+ *
+ * Every call and every reply is a single datagram: a header followed by the
+ * payload, so there is no stream reassembly. Payloads larger than
+ * max_inline_size are written to a memfd that travels with the header as an
+ * SCM_RIGHTS message and is mapped by the receiver.
+ *
+ * The server runs one epoll thread that accepts clients and runs the handlers
+ * in the order the calls arrive, like the named pipe server does. Handlers use
+ * the same signature as the ipc::function ones so collections can be served
+ * by either transport. A client that stops reading its replies is dropped
+ * once a reply can't be queued within a bounded time.
+ */
+namespace uds
+{
+	typedef void (*call_handler_t)(
+	    void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+
+	static const size_t max_inline_size = 64 * 1024;
+
+	// Type tag followed by the payload, strings and binaries are prefixed with their 32-bit length.
+	void serialize(std::vector<char>& buffer, const std::vector<ipc::value>& values);
+	bool deserialize(const char* data, size_t size, size_t offset, std::vector<ipc::value>& values);
+
+	class server
+	{
+		public:
+		server();
+		~server();
+
+		server(server const&) = delete;
+		void operator=(server const&) = delete;
+
+		void register_function(
+		    const std::string& cname,
+		    const std::string& fname,
+		    call_handler_t     handler,
+		    void*              data = nullptr);
+
+		// Binds the socket and starts the worker, throws std::runtime_error on failure.
+		void initialize(const std::string& path);
+		void finalize();
+
+		private:
+		struct function
+		{
+			call_handler_t handler;
+			void*          data;
+		};
+
+		void worker();
+		bool receive(int fd, int64_t cid);
+		void close_client(int fd);
+
+		std::map<std::string, function> m_functions;
+		std::map<int, int64_t>          m_clients;
+		std::string                     m_path;
+		int                             m_listen   = -1;
+		int                             m_epoll    = -1;
+		int                             m_wake     = -1;
+		int64_t                         m_next_cid = 1;
+		std::vector<char>               m_buffer;
+		std::thread                     m_worker;
+		std::atomic<bool>               m_stop{false};
+	};
+
+	class client
+	{
+		public:
+		// Returns nullptr when nothing listens on the path.
+		static std::shared_ptr<client> create(const std::string& path);
+
+		client(int fd);
+		~client();
+
+		client(client const&) = delete;
+		void operator=(client const&) = delete;
+
+		// Same contract as ipc::client, an empty vector means the call failed.
+		std::vector<ipc::value> call_synchronous_helper(
+		    const std::string&             cname,
+		    const std::string&             fname,
+		    const std::vector<ipc::value>& args);
+
+		private:
+		int               m_fd;
+		uint64_t          m_next_id = 1;
+		std::vector<char> m_buffer;
+		std::mutex        m_lock;
+	};
+} // namespace uds
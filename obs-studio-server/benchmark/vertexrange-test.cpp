@@ -0,0 +1,97 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+/*
+ * Checks the upload range and copy rotation of GS::VertexRange, which makes
+ * no graphics calls and so runs without libobs or a GPU.
+ *
+ * Usage: osn-vertexrange-test, returns non-zero if a check failed.
+ */
+
+#include <cstdio>
+#include "gs-vertexrange.h"
+
+static int failures = 0;
+
+#define CHECK(expression) \
+	do { \
+		if (!(expression)) { \
+			fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, #expression); \
+			failures++; \
+		} \
+	} while (0)
+
+static void StaticBuffer()
+{
+	// Static buffers upload their whole capacity into their only copy
+	GS::VertexRange range(100, false, 2);
+	CHECK(range.Upload(10) == 100);
+	CHECK(range.Upload(0) == 100);
+	CHECK(range.Upload(500) == 100);
+	CHECK(range.Current() == 0);
+}
+
+static void StreamingSize()
+{
+	GS::VertexRange range(100, true, 2);
+
+	// Only the used range is sent, clamped to the capacity
+	CHECK(range.Upload(10) == 10);
+	CHECK(range.Upload(100) == 100);
+	CHECK(range.Upload(101) == 100);
+
+	// An empty buffer sends nothing and keeps drawing from the same copy
+	uint32_t current = range.Current();
+	CHECK(range.Upload(0) == 0);
+	CHECK(range.Current() == current);
+}
+
+static void StreamingCopies()
+{
+	// Every upload goes into the other copy
+	GS::VertexRange range(100, true, 2);
+	CHECK(range.Current() == 0);
+	range.Upload(10);
+	CHECK(range.Current() == 1);
+	range.Upload(10);
+	CHECK(range.Current() == 0);
+
+	// Copies are clamped to [1, MAXIMUM_STREAM_COPIES]
+	GS::VertexRange single(100, true, 0);
+	single.Upload(10);
+	single.Upload(10);
+	CHECK(single.Current() == 0);
+
+	GS::VertexRange clamped(100, true, GS::MAXIMUM_STREAM_COPIES + 3);
+	for (uint32_t idx = 0; idx < GS::MAXIMUM_STREAM_COPIES; idx++)
+		clamped.Upload(10);
+	CHECK(clamped.Current() == 0);
+}
+
+int main()
+{
+	StaticBuffer();
+	StreamingSize();
+	StreamingCopies();
+
+	if (failures)
+		fprintf(stderr, "%d checks failed\n", failures);
+	else
+		printf("All checks passed\n");
+	return failures ? 1 : 0;
+}
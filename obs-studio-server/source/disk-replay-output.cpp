@@ -0,0 +1,506 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "disk-replay-output.h"
+#include <obs-avc.h>
+#include <obs.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "nodeobs_service.h"
+#include "replay-ring.h"
+
+#define FLV_TAG_AUDIO 8
+#define FLV_TAG_VIDEO 9
+#define FLV_TAG_META 18
+
+struct disk_replay
+{
+	obs_output_t* output = nullptr;
+	obs_hotkey_id hotkey = OBS_INVALID_HOTKEY_ID;
+
+	std::mutex mtx;
+	ReplayRing ring;
+	bool       active = false;
+
+	std::string directory;
+	std::string format;
+	bool        allow_spaces = true;
+	int64_t     max_time_sec = 0;
+	uint64_t    memory_mb    = 0;
+	uint64_t    disk_mb      = 0;
+
+	std::thread       saver;
+	std::atomic<bool> saving{false};
+	std::string       last_replay;
+};
+
+static void PutBE16(std::vector<uint8_t>& buf, uint16_t value)
+{
+	buf.push_back(uint8_t(value >> 8));
+	buf.push_back(uint8_t(value));
+}
+
+static void PutBE24(std::vector<uint8_t>& buf, uint32_t value)
+{
+	buf.push_back(uint8_t(value >> 16));
+	buf.push_back(uint8_t(value >> 8));
+	buf.push_back(uint8_t(value));
+}
+
+static void PutBE32(std::vector<uint8_t>& buf, uint32_t value)
+{
+	PutBE16(buf, uint16_t(value >> 16));
+	PutBE16(buf, uint16_t(value));
+}
+
+static void PutAmfString(std::vector<uint8_t>& buf, const char* str)
+{
+	size_t len = strlen(str);
+	PutBE16(buf, uint16_t(len));
+	buf.insert(buf.end(), str, str + len);
+}
+
+static void PutAmfNumber(std::vector<uint8_t>& buf, const char* name, double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	PutAmfString(buf, name);
+	buf.push_back(0x00);
+	PutBE32(buf, uint32_t(bits >> 32));
+	PutBE32(buf, uint32_t(bits));
+}
+
+static int64_t PacketMs(const replay_packet& packet, int64_t value)
+{
+	return value * 1000 * packet.timebase_num / packet.timebase_den;
+}
+
+/*!
+* Minimal FLV muxer for h264 and aac, fed with packets already converted
+* to length prefixed NAL units.
+*/
+class FlvWriter
+{
+	public:
+	~FlvWriter()
+	{
+		if (file)
+			fclose(file);
+	}
+
+	bool open(const std::string& path)
+	{
+		file = os_fopen(path.c_str(), "wb");
+		if (!file)
+			return false;
+
+		static const uint8_t header[] = {'F', 'L', 'V', 1, 0x05, 0, 0, 0, 9, 0, 0, 0, 0};
+		return fwrite(header, 1, sizeof(header), file) == sizeof(header);
+	}
+
+	bool writeMetadata(uint32_t width, uint32_t height)
+	{
+		std::vector<uint8_t> data;
+		data.push_back(0x02);
+		PutAmfString(data, "onMetaData");
+		data.push_back(0x08);
+		PutBE32(data, 5);
+
+		// Patched once the replay is written
+		duration_offset = ftell(file) + 11 + long(data.size()) + 2 + strlen("duration") + 1;
+		PutAmfNumber(data, "duration", 0.0);
+		PutAmfNumber(data, "width", width);
+		PutAmfNumber(data, "height", height);
+		PutAmfNumber(data, "videocodecid", 7.0);
+		PutAmfNumber(data, "audiocodecid", 10.0);
+		PutBE24(data, 9);
+
+		return writeTag(FLV_TAG_META, 0, data);
+	}
+
+	bool writeVideoHeader(const uint8_t* avcc, size_t size)
+	{
+		std::vector<uint8_t> data = {0x17, 0x00, 0, 0, 0};
+		data.insert(data.end(), avcc, avcc + size);
+		return writeTag(FLV_TAG_VIDEO, 0, data);
+	}
+
+	bool writeAudioHeader(const uint8_t* config, size_t size)
+	{
+		std::vector<uint8_t> data = {0xAF, 0x00};
+		data.insert(data.end(), config, config + size);
+		return writeTag(FLV_TAG_AUDIO, 0, data);
+	}
+
+	bool writePacket(const replay_packet& packet, const std::vector<uint8_t>& payload, int64_t offsetMs)
+	{
+		int64_t dts = std::max<int64_t>(PacketMs(packet, packet.dts) - offsetMs, 0);
+		last_ms     = std::max(last_ms, dts);
+
+		std::vector<uint8_t> data;
+		if (packet.video) {
+			data.push_back(packet.keyframe ? 0x17 : 0x27);
+			data.push_back(0x01);
+			PutBE24(data, uint32_t(PacketMs(packet, packet.pts) - PacketMs(packet, packet.dts)) & 0xFFFFFF);
+		} else {
+			data.push_back(0xAF);
+			data.push_back(0x01);
+		}
+		data.insert(data.end(), payload.begin(), payload.end());
+
+		return writeTag(packet.video ? FLV_TAG_VIDEO : FLV_TAG_AUDIO, dts, data);
+	}
+
+	bool close()
+	{
+		std::vector<uint8_t> duration;
+		double               seconds = double(last_ms) / 1000.0;
+		uint64_t             bits;
+		memcpy(&bits, &seconds, sizeof(bits));
+		PutBE32(duration, uint32_t(bits >> 32));
+		PutBE32(duration, uint32_t(bits));
+
+		bool result = fseek(file, duration_offset, SEEK_SET) == 0
+		              && fwrite(duration.data(), 1, duration.size(), file) == duration.size();
+		result = fclose(file) == 0 && result;
+		file   = nullptr;
+		return result;
+	}
+
+	private:
+	bool writeTag(uint8_t type, int64_t timestamp, const std::vector<uint8_t>& data)
+	{
+		std::vector<uint8_t> tag;
+		tag.reserve(11 + data.size() + 4);
+		tag.push_back(type);
+		PutBE24(tag, uint32_t(data.size()));
+		PutBE24(tag, uint32_t(timestamp) & 0xFFFFFF);
+		tag.push_back(uint8_t(timestamp >> 24));
+		PutBE24(tag, 0);
+		tag.insert(tag.end(), data.begin(), data.end());
+		PutBE32(tag, uint32_t(11 + data.size()));
+
+		return fwrite(tag.data(), 1, tag.size(), file) == tag.size();
+	}
+
+	FILE*   file            = nullptr;
+	long    duration_offset = 0;
+	int64_t last_ms         = 0;
+};
+
+static void SignalOutput(disk_replay* replay, const char* signal)
+{
+	calldata_t cd = {0};
+	calldata_set_ptr(&cd, "output", replay->output);
+	signal_handler_signal(obs_output_get_signal_handler(replay->output), signal, &cd);
+	calldata_free(&cd);
+}
+
+static bool WriteReplay(disk_replay* replay, const std::string& path)
+{
+	obs_encoder_t* video = obs_output_get_video_encoder(replay->output);
+	obs_encoder_t* audio = obs_output_get_audio_encoder(replay->output, 0);
+
+	uint8_t* extra     = nullptr;
+	size_t   extraSize = 0;
+	uint8_t* avcc      = nullptr;
+	size_t   avccSize  = 0;
+	if (obs_encoder_get_extra_data(video, &extra, &extraSize))
+		avccSize = obs_parse_avc_header(&avcc, extra, extraSize);
+	if (!avccSize || !obs_encoder_get_extra_data(audio, &extra, &extraSize)) {
+		bfree(avcc);
+		return false;
+	}
+
+	FlvWriter writer;
+	bool      result = writer.open(path)
+	              && writer.writeMetadata(obs_encoder_get_width(video), obs_encoder_get_height(video))
+	              && writer.writeVideoHeader(avcc, avccSize) && writer.writeAudioHeader(extra, extraSize);
+	bfree(avcc);
+
+	uint64_t seq;
+	uint64_t end;
+	{
+		std::unique_lock<std::mutex> ulock(replay->mtx);
+		seq = replay->ring.firstKeyframe();
+		end = replay->ring.nextSequence();
+	}
+
+	// Packets are copied out one by one, the encoders keep feeding the ring meanwhile
+	replay_packet        packet;
+	std::vector<uint8_t> data;
+	bool                 started  = false;
+	int64_t              offsetMs = 0;
+	while (result && seq < end) {
+		{
+			std::unique_lock<std::mutex> ulock(replay->mtx);
+			if (!replay->ring.read(seq, packet, data))
+				break;
+		}
+		if (!started) {
+			if (!packet.video || !packet.keyframe)
+				continue;
+			started  = true;
+			offsetMs = PacketMs(packet, packet.dts);
+		}
+		if (!packet.video && packet.track != 0)
+			continue;
+
+		result = writer.writePacket(packet, data, offsetMs);
+	}
+
+	return writer.close() && result && started;
+}
+
+static void SaveReplay(disk_replay* replay)
+{
+	SignalOutput(replay, "writing");
+
+	std::string path = replay->directory;
+	if (!path.empty() && path.back() != '/' && path.back() != '\\')
+		path += "/";
+
+	bool result = false;
+	try {
+		path += GenerateSpecifiedFilename("flv", !replay->allow_spaces, replay->format.c_str());
+		result = WriteReplay(replay, path);
+	} catch (...) {
+	}
+
+	if (!result) {
+		blog(LOG_WARNING, "Failed to save the disk replay buffer to '%s'", path.c_str());
+		SignalOutput(replay, "writing_error");
+	} else {
+		{
+			std::unique_lock<std::mutex> ulock(replay->mtx);
+			replay->last_replay = path;
+		}
+		SignalOutput(replay, "wrote");
+	}
+	replay->saving = false;
+}
+
+static void StartSaving(disk_replay* replay)
+{
+	{
+		std::unique_lock<std::mutex> ulock(replay->mtx);
+		if (!replay->active)
+			return;
+	}
+
+	bool expected = false;
+	if (!replay->saving.compare_exchange_strong(expected, true))
+		return;
+
+	if (replay->saver.joinable())
+		replay->saver.join();
+	replay->saver = std::thread(SaveReplay, replay);
+}
+
+static void SaveHotkey(void* data, obs_hotkey_id id, obs_hotkey_t* hotkey, bool pressed)
+{
+	if (pressed)
+		StartSaving(reinterpret_cast<disk_replay*>(data));
+}
+
+static void SaveProc(void* data, calldata_t* cd)
+{
+	StartSaving(reinterpret_cast<disk_replay*>(data));
+}
+
+static void GetLastReplayProc(void* data, calldata_t* cd)
+{
+	disk_replay*                 replay = reinterpret_cast<disk_replay*>(data);
+	std::unique_lock<std::mutex> ulock(replay->mtx);
+	calldata_set_string(cd, "path", replay->last_replay.c_str());
+}
+
+static const char* DiskReplayGetName(void* type_data)
+{
+	return "Disk Replay Buffer";
+}
+
+static void DiskReplayUpdate(void* data, obs_data_t* settings)
+{
+	disk_replay* replay = reinterpret_cast<disk_replay*>(data);
+
+	const char* directory = obs_data_get_string(settings, "directory");
+	const char* format    = obs_data_get_string(settings, "format");
+
+	replay->directory    = directory ? directory : "";
+	replay->format       = format ? format : "";
+	replay->allow_spaces = obs_data_get_bool(settings, "allow_spaces");
+	replay->max_time_sec = obs_data_get_int(settings, "max_time_sec");
+	replay->memory_mb    = uint64_t(std::max<long long>(obs_data_get_int(settings, "memory_mb"), 0));
+	replay->disk_mb      = uint64_t(std::max<long long>(obs_data_get_int(settings, "disk_mb"), 1));
+}
+
+static void* DiskReplayCreate(obs_data_t* settings, obs_output_t* output)
+{
+	disk_replay* replay = new disk_replay();
+	replay->output      = output;
+	replay->hotkey = obs_hotkey_register_output(output, "ReplayBuffer.Save", "Save replay", SaveHotkey, replay);
+
+	proc_handler_t* ph = obs_output_get_proc_handler(output);
+	proc_handler_add(ph, "void save()", SaveProc, replay);
+	proc_handler_add(ph, "void get_last_replay(out string path)", GetLastReplayProc, replay);
+
+	signal_handler_t* sh = obs_output_get_signal_handler(output);
+	signal_handler_add(sh, "void writing()");
+	signal_handler_add(sh, "void wrote()");
+	signal_handler_add(sh, "void writing_error()");
+
+	DiskReplayUpdate(replay, settings);
+	return replay;
+}
+
+static void DiskReplayDestroy(void* data)
+{
+	disk_replay* replay = reinterpret_cast<disk_replay*>(data);
+
+	if (replay->saver.joinable())
+		replay->saver.join();
+
+	obs_hotkey_unregister(replay->hotkey);
+	delete replay;
+}
+
+static bool DiskReplayStart(void* data)
+{
+	disk_replay* replay = reinterpret_cast<disk_replay*>(data);
+
+	if (!obs_output_can_begin_data_capture(replay->output, 0))
+		return false;
+
+	obs_encoder_t* video = obs_output_get_video_encoder(replay->output);
+	obs_encoder_t* audio = obs_output_get_audio_encoder(replay->output, 0);
+	if (!video || !audio || strcmp(obs_encoder_get_codec(video), "h264") != 0
+	    || strcmp(obs_encoder_get_codec(audio), "aac") != 0) {
+		obs_output_set_last_error(replay->output, "The disk replay buffer only supports h264 video and aac audio");
+		return false;
+	}
+
+	if (!obs_output_initialize_encoders(replay->output, 0))
+		return false;
+
+	// Wait for a replay being written from the previous session
+	if (replay->saver.joinable())
+		replay->saver.join();
+
+	std::string ringPath = replay->directory;
+	if (!ringPath.empty() && ringPath.back() != '/' && ringPath.back() != '\\')
+		ringPath += "/";
+	ringPath += ".replay-buffer-" + std::to_string(os_gettime_ns()) + ".ring";
+
+	{
+		std::unique_lock<std::mutex> ulock(replay->mtx);
+		if (!replay->ring.open(
+		        ringPath,
+		        replay->memory_mb * 1024 * 1024,
+		        replay->disk_mb * 1024 * 1024,
+		        replay->max_time_sec * 1000000)) {
+			blog(LOG_WARNING, "Failed to create the replay buffer file '%s'", ringPath.c_str());
+			obs_output_set_last_error(replay->output, "Failed to create the replay buffer file");
+			return false;
+		}
+		replay->active = true;
+	}
+
+	return obs_output_begin_data_capture(replay->output, 0);
+}
+
+static void DiskReplayStop(void* data, uint64_t ts)
+{
+	disk_replay* replay = reinterpret_cast<disk_replay*>(data);
+
+	obs_output_end_data_capture(replay->output);
+
+	// A replay being saved is finished before the window is dropped
+	if (replay->saver.joinable())
+		replay->saver.join();
+
+	std::unique_lock<std::mutex> ulock(replay->mtx);
+	replay->active = false;
+	replay->ring.close();
+}
+
+static void DiskReplayPacket(void* data, struct encoder_packet* packet)
+{
+	disk_replay* replay = reinterpret_cast<disk_replay*>(data);
+	if (!packet)
+		return;
+
+	replay_packet meta;
+	meta.pts          = packet->pts;
+	meta.dts          = packet->dts;
+	meta.dts_usec     = packet->dts_usec;
+	meta.timebase_num = packet->timebase_num;
+	meta.timebase_den = packet->timebase_den;
+	meta.video        = packet->type == OBS_ENCODER_VIDEO;
+	meta.keyframe     = packet->keyframe;
+	meta.track        = uint8_t(packet->track_idx);
+
+	std::unique_lock<std::mutex> ulock(replay->mtx);
+	if (!replay->active)
+		return;
+
+	if (meta.video) {
+		// Stored as length prefixed NAL units, the layout FLV expects
+		struct encoder_packet parsed;
+		obs_parse_avc_packet(&parsed, packet);
+		meta.size = uint32_t(parsed.size);
+		replay->ring.push(meta, parsed.data);
+		obs_encoder_packet_release(&parsed);
+	} else {
+		meta.size = uint32_t(packet->size);
+		replay->ring.push(meta, packet->data);
+	}
+}
+
+static void DiskReplayDefaults(obs_data_t* settings)
+{
+	obs_data_set_default_int(settings, "max_time_sec", 20);
+	obs_data_set_default_int(settings, "memory_mb", 256);
+	obs_data_set_default_int(settings, "disk_mb", 4096);
+	obs_data_set_default_bool(settings, "allow_spaces", true);
+}
+
+void DiskReplayOutput::Register(void)
+{
+	struct obs_output_info info = {};
+	info.id                   = DISK_REPLAY_OUTPUT_ID;
+	info.flags                = OBS_OUTPUT_AV | OBS_OUTPUT_ENCODED;
+	info.encoded_video_codecs = "h264";
+	info.encoded_audio_codecs = "aac";
+	info.get_name             = DiskReplayGetName;
+	info.create               = DiskReplayCreate;
+	info.destroy              = DiskReplayDestroy;
+	info.start                = DiskReplayStart;
+	info.stop                 = DiskReplayStop;
+	info.encoded_packet       = DiskReplayPacket;
+	info.update               = DiskReplayUpdate;
+	info.get_defaults         = DiskReplayDefaults;
+	obs_register_output(&info);
+}
@@ -0,0 +1,36 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+
+#define DISK_REPLAY_OUTPUT_ID "disk_replay_buffer"
+
+/*!
+* \brief Replay buffer keeping older packets in a file mapped in memory.
+*
+* Only a small head of the replay window stays in memory, the rest is
+* spilled to a preallocated ring file sized by the disk budget. Saving a
+* replay remuxes the window to a FLV file, so the output accepts h264
+* video and the first aac audio track. It exposes the same save hotkey,
+* procedures and signals as the replay_buffer output of obs-ffmpeg.
+*/
+class DiskReplayOutput
+{
+	public:
+	static void Register(void);
+};
@@ -0,0 +1,129 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "encoder-planner.h"
+#include <cinttypes>
+#include <cstdio>
+#include <functional>
+#include <map>
+
+static std::string ItemValue(obs_data_item_t* item)
+{
+	switch (obs_data_item_gettype(item)) {
+	case OBS_DATA_STRING: {
+		const char* value = obs_data_item_get_string(item);
+		return value ? value : "";
+	}
+	case OBS_DATA_NUMBER:
+		if (obs_data_item_numtype(item) == OBS_DATA_NUM_DOUBLE)
+			return std::to_string(obs_data_item_get_double(item));
+		return std::to_string(obs_data_item_get_int(item));
+	case OBS_DATA_BOOLEAN:
+		return obs_data_item_get_bool(item) ? "true" : "false";
+	case OBS_DATA_OBJECT: {
+		obs_data_t* obj = obs_data_item_get_obj(item);
+		std::string value = obj ? obs_data_get_json(obj) : "";
+		obs_data_release(obj);
+		return value;
+	}
+	default:
+		return "";
+	}
+}
+
+std::string EncoderPlanner::fingerprint(obs_encoder_t* encoder)
+{
+	if (!encoder)
+		return "";
+
+	const char* id = obs_encoder_get_id(encoder);
+
+	std::string result = id ? id : "";
+	char        media[128];
+
+	if (obs_encoder_get_type(encoder) == OBS_ENCODER_VIDEO) {
+		snprintf(
+		    media,
+		    sizeof(media),
+		    "|video=%p|%" PRIu32 "x%" PRIu32,
+		    (void*)obs_encoder_video(encoder),
+		    obs_encoder_get_width(encoder),
+		    obs_encoder_get_height(encoder));
+	} else {
+		snprintf(
+		    media,
+		    sizeof(media),
+		    "|audio=%p|mixer=%zu|rate=%" PRIu32,
+		    (void*)obs_encoder_audio(encoder),
+		    obs_encoder_get_mixer_index(encoder),
+		    obs_encoder_get_sample_rate(encoder));
+	}
+	result += media;
+
+	// Items are visited in insertion order, sort them so equal settings compare equal
+	std::map<std::string, std::string> values;
+	obs_data_t*                        settings = obs_encoder_get_settings(encoder);
+	for (obs_data_item_t* item = obs_data_first(settings); item; obs_data_item_next(&item))
+		values[obs_data_item_get_name(item)] = ItemValue(item);
+	obs_data_release(settings);
+
+	for (auto& value : values) {
+		result += "|";
+		result += value.first;
+		result += "=";
+		result += value.second;
+	}
+	return result;
+}
+
+std::string EncoderPlanner::digest(obs_encoder_t* encoder)
+{
+	if (!encoder)
+		return "";
+
+	char hex[17];
+	snprintf(hex, sizeof(hex), "%016" PRIx64, uint64_t(std::hash<std::string>()(fingerprint(encoder))));
+	return hex;
+}
+
+obs_encoder_t* EncoderPlanner::share(obs_encoder_t* encoder, std::initializer_list<obs_encoder_t*> candidates)
+{
+	if (!encoder || obs_get_multiple_rendering())
+		return encoder;
+
+	std::string wanted;
+	for (obs_encoder_t* candidate : candidates) {
+		if (!candidate || candidate == encoder || !obs_encoder_active(candidate))
+			continue;
+		if (obs_encoder_get_type(candidate) != obs_encoder_get_type(encoder))
+			continue;
+
+		if (wanted.empty())
+			wanted = fingerprint(encoder);
+		if (fingerprint(candidate) == wanted) {
+			// Also reached by state checks that attach nothing, so this stays out of the info log
+			blog(
+			    LOG_DEBUG,
+			    "Sharing encoder '%s' in place of '%s'",
+			    obs_encoder_get_name(candidate),
+			    obs_encoder_get_name(encoder));
+			return candidate;
+		}
+	}
+	return encoder;
+}
@@ -0,0 +1,48 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <initializer_list>
+#include <string>
+
+/*!
+* \brief Decides which outputs can be fed by the same encoder instance.
+*
+* Two encoders are interchangeable when their fingerprints match: same
+* encoder id, same media pipeline, same scaled resolution or mixer and the
+* same effective value for every setting, defaults included.
+*/
+class EncoderPlanner
+{
+	public:
+	// Canonical description of the effective settings, empty for a null encoder
+	static std::string fingerprint(obs_encoder_t* encoder);
+
+	// Short hexadecimal digest of the fingerprint, used when reporting the plan
+	static std::string digest(obs_encoder_t* encoder);
+
+	/*!
+	* Returns the first active candidate producing the same stream as the
+	* given encoder, or the encoder itself. Only encoders that are already
+	* running are shared so that an idle encoder holding stale settings
+	* never ends up feeding an output. Sharing is disabled under multiple
+	* rendering, where each output renders its own view.
+	*/
+	static obs_encoder_t* share(obs_encoder_t* encoder, std::initializer_list<obs_encoder_t*> candidates);
+};
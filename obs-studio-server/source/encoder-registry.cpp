@@ -0,0 +1,271 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "encoder-registry.h"
+#include <cstring>
+#include <memory>
+
+static const char* NullToEmpty(const char* str)
+{
+	return str ? str : "";
+}
+
+static void ReadIntProperty(obs_property_t* prop, std::vector<int>& values)
+{
+	const int max_ = obs_property_int_max(prop);
+	const int step = obs_property_int_step(prop);
+	if (step <= 0)
+		return;
+
+	for (int i = obs_property_int_min(prop); i <= max_; i += step)
+		values.push_back(i);
+}
+
+static void ReadListProperty(obs_property_t* prop, const char* id, std::vector<int>& values)
+{
+	obs_combo_format format = obs_property_list_format(prop);
+	if (format != OBS_COMBO_FORMAT_INT) {
+		blog(
+		    LOG_ERROR,
+		    "Encoder '%s' (%s) returned %s "
+		    "OBS_PROPERTY_LIST property of unhandled "
+		    "format %d",
+		    NullToEmpty(obs_encoder_get_display_name(id)),
+		    id,
+		    obs_property_name(prop),
+		    static_cast<int>(format));
+		return;
+	}
+
+	const size_t count = obs_property_list_item_count(prop);
+	for (size_t i = 0; i < count; i++) {
+		if (obs_property_list_item_disabled(prop, i))
+			continue;
+
+		values.push_back(static_cast<int>(obs_property_list_item_int(prop, i)));
+	}
+}
+
+static bool ReadAudioProperties(encoder_capability& encoder, uint64_t sampleRate, std::vector<int>& bitrates)
+{
+	auto DestroyProperties = [](obs_properties_t* props) { obs_properties_destroy(props); };
+	std::unique_ptr<obs_properties_t, decltype(DestroyProperties)> props{obs_get_encoder_properties(encoder.id),
+	                                                                     DestroyProperties};
+
+	if (!props) {
+		blog(
+		    LOG_ERROR,
+		    "Failed to get properties for encoder "
+		    "'%s' (%s)",
+		    NullToEmpty(obs_encoder_get_display_name(encoder.id)),
+		    encoder.id);
+		return false;
+	}
+
+	obs_property_t* samplerate = obs_properties_get(props.get(), "samplerate");
+	if (samplerate) {
+		if (obs_property_get_type(samplerate) == OBS_PROPERTY_LIST) {
+			encoder.sample_rates.clear();
+			ReadListProperty(samplerate, encoder.id, encoder.sample_rates);
+		}
+
+		// The bitrate list of some encoders depends on the selected sample rate
+		auto                                               ReleaseData = [](obs_data_t* data) { obs_data_release(data); };
+		std::unique_ptr<obs_data_t, decltype(ReleaseData)> data{obs_encoder_defaults(encoder.id), ReleaseData};
+		if (data) {
+			obs_data_set_int(data.get(), "samplerate", sampleRate);
+			obs_property_modified(samplerate, data.get());
+		}
+	}
+
+	obs_property_t*   bitrate = obs_properties_get(props.get(), "bitrate");
+	obs_property_type type    = obs_property_get_type(bitrate);
+	switch (type) {
+	case OBS_PROPERTY_INT:
+		ReadIntProperty(bitrate, bitrates);
+		return true;
+	case OBS_PROPERTY_LIST:
+		ReadListProperty(bitrate, encoder.id, bitrates);
+		return true;
+	default:
+		break;
+	}
+
+	blog(
+	    LOG_ERROR,
+	    "Encoder '%s' (%s) returned bitrate property "
+	    "of unhandled type %d",
+	    NullToEmpty(obs_encoder_get_display_name(encoder.id)),
+	    encoder.id,
+	    static_cast<int>(type));
+	return true;
+}
+
+void EncoderRegistry::build()
+{
+	encoders.clear();
+
+	const char* id = nullptr;
+	for (size_t i = 0; obs_enum_encoder_types(i, &id); i++) {
+		if (id == nullptr)
+			continue;
+
+		encoder_capability encoder = {};
+		encoder.id                 = id;
+		encoder.codec              = NullToEmpty(obs_get_encoder_codec(id));
+		encoder.type               = obs_get_encoder_type(id);
+		encoder.caps               = obs_get_encoder_caps(id);
+		encoders.push_back(std::move(encoder));
+	}
+
+	valid = true;
+	builds++;
+
+	blog(LOG_DEBUG, "Encoder registry built with %d encoders", (int)encoders.size());
+}
+
+encoder_capability* EncoderRegistry::find(const char* id)
+{
+	if (!valid)
+		build();
+
+	if (!id)
+		return nullptr;
+
+	for (auto& encoder : encoders) {
+		if (strcmp(encoder.id, id) == 0)
+			return &encoder;
+	}
+
+	return nullptr;
+}
+
+void EncoderRegistry::invalidate()
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	valid = false;
+	encoders.clear();
+}
+
+void EncoderRegistry::refresh()
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	build();
+}
+
+uint64_t EncoderRegistry::generation()
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	if (!valid)
+		build();
+
+	return builds;
+}
+
+bool EncoderRegistry::available(const char* id)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	return find(id) != nullptr;
+}
+
+uint32_t EncoderRegistry::caps(const char* id)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	encoder_capability*          encoder = find(id);
+	return encoder ? encoder->caps : 0;
+}
+
+const char* EncoderRegistry::findByCodec(const char* codec)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	if (!valid)
+		build();
+
+	for (auto& encoder : encoders) {
+		if (encoder.codec == codec)
+			return encoder.id;
+	}
+
+	return nullptr;
+}
+
+std::vector<const char*> EncoderRegistry::encodersForCodec(obs_encoder_type type, const char* codec)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	if (!valid)
+		build();
+
+	std::vector<const char*> ids;
+	for (auto& encoder : encoders) {
+		if (encoder.type == type && encoder.codec == codec)
+			ids.push_back(encoder.id);
+	}
+
+	return ids;
+}
+
+const std::vector<int>* EncoderRegistry::loadBitrates(encoder_capability* encoder, uint64_t sampleRate)
+{
+	if (!encoder || encoder->type != OBS_ENCODER_AUDIO || encoder->properties_failed)
+		return nullptr;
+
+	auto cached = encoder->bitrates.find(sampleRate);
+	if (cached != encoder->bitrates.end())
+		return &cached->second;
+
+	std::vector<int> values;
+
+	// A corrupted encoder dll will fail when requesting its properties, in
+	// which case the encoder is not offered anymore until modules change.
+	try {
+		if (!ReadAudioProperties(*encoder, sampleRate, values)) {
+			encoder->properties_failed = true;
+			return nullptr;
+		}
+	} catch (...) {
+		encoder->properties_failed = true;
+		return nullptr;
+	}
+
+	return &encoder->bitrates.emplace(sampleRate, std::move(values)).first->second;
+}
+
+bool EncoderRegistry::bitrates(const char* id, uint64_t sampleRate, std::vector<int>& out)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	const std::vector<int>*      values = loadBitrates(find(id), sampleRate);
+	if (!values)
+		return false;
+
+	out = *values;
+	return true;
+}
+
+std::vector<int> EncoderRegistry::sampleRates(const char* id)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	encoder_capability*          encoder = find(id);
+	if (!encoder)
+		return {};
+
+	// Sample rates are read together with the bitrates
+	if (encoder->bitrates.empty())
+		loadBitrates(encoder, 48000);
+
+	return encoder->sample_rates;
+}
@@ -0,0 +1,94 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct encoder_capability
+{
+	// Encoder ids are owned by the module that registered them and live as long as libobs
+	const char*      id;
+	std::string      codec;
+	obs_encoder_type type;
+	uint32_t         caps;
+
+	// Audio only, sample rates offered by the encoder (empty if unrestricted)
+	std::vector<int> sample_rates;
+
+	// Audio only, supported bitrates per sample rate, filled on first request
+	std::map<uint64_t, std::vector<int>> bitrates;
+	bool                                 properties_failed;
+};
+
+/*!
+* \brief Encoder capabilities of the loaded modules, enumerated once.
+*
+* The list is built on first use after modules are loaded and is dropped by
+* invalidate() whenever another module gets initialized.
+*/
+class EncoderRegistry
+{
+	public:
+	static EncoderRegistry& GetInstance()
+	{
+		static EncoderRegistry instance;
+		return instance;
+	}
+
+	EncoderRegistry(EncoderRegistry const&) = delete;
+	void operator=(EncoderRegistry const&) = delete;
+
+	private:
+	EncoderRegistry() {}
+
+	public:
+	// Drop all cached capabilities, to be called after a module is loaded
+	void invalidate();
+
+	// Enumerate the encoders now instead of on the next query
+	void refresh();
+
+	// Incremented on each rebuild, lets users of the registry detect changes
+	uint64_t generation();
+
+	bool        available(const char* id);
+	uint32_t    caps(const char* id);
+	const char* findByCodec(const char* codec);
+
+	// Ids of all encoders of the given type producing the given codec, in enumeration order
+	std::vector<const char*> encodersForCodec(obs_encoder_type type, const char* codec);
+
+	// Bitrates supported by an audio encoder at the given sample rate
+	bool bitrates(const char* id, uint64_t sampleRate, std::vector<int>& out);
+
+	std::vector<int> sampleRates(const char* id);
+
+	private:
+	void                    build();
+	encoder_capability*     find(const char* id);
+	const std::vector<int>* loadBitrates(encoder_capability* encoder, uint64_t sampleRate);
+
+	std::mutex                      mtx;
+	std::vector<encoder_capability> encoders;
+	bool                            valid  = false;
+	uint64_t                        builds = 0;
+};
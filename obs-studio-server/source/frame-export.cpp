@@ -0,0 +1,160 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "frame-export.h"
+#include <algorithm>
+#include <atomic>
+#include <util/platform.h>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+static std::string NextMappingName()
+{
+	static std::atomic<uint32_t> counter{0};
+#ifdef WIN32
+	unsigned long pid = GetCurrentProcessId();
+#else
+	unsigned long pid = (unsigned long)getpid();
+#endif
+	return "osn-frame-" + std::to_string(pid) + "-" + std::to_string(++counter);
+}
+
+FrameExport::~FrameExport()
+{
+	obs_enter_graphics();
+	releaseStaging();
+	if (texrender)
+		gs_texrender_destroy(texrender);
+	texrender = nullptr;
+	obs_leave_graphics();
+
+	memory.close();
+}
+
+bool FrameExport::create(uint32_t width, uint32_t height)
+{
+	if (width == 0 || height == 0)
+		return false;
+
+	mappingName = NextMappingName();
+	if (!memory.create(mappingName, shared_frame::mapping_size(width, height))) {
+		blog(LOG_ERROR, "Failed to create shared memory %s for a display.", mappingName.c_str());
+		return false;
+	}
+	if (!writer.init(memory, width, height)) {
+		memory.close();
+		return false;
+	}
+
+	maxW = width;
+	maxH = height;
+	return true;
+}
+
+const std::string& FrameExport::name() const
+{
+	return mappingName;
+}
+
+size_t FrameExport::size() const
+{
+	return memory.size();
+}
+
+uint32_t FrameExport::maxWidth() const
+{
+	return maxW;
+}
+
+uint32_t FrameExport::maxHeight() const
+{
+	return maxH;
+}
+
+void FrameExport::releaseStaging()
+{
+	for (size_t idx = 0; idx < staging_count; idx++) {
+		if (staging[idx])
+			gs_stagesurface_destroy(staging[idx]);
+		staging[idx] = nullptr;
+		staged[idx]  = false;
+	}
+	stagingIndex = 0;
+	stagingW     = 0;
+	stagingH     = 0;
+}
+
+void FrameExport::render(
+    uint32_t cx,
+    uint32_t cy,
+    uint32_t background,
+    void (*draw)(void*, uint32_t, uint32_t),
+    void* param)
+{
+	cx = std::min(cx, maxW);
+	cy = std::min(cy, maxH);
+	if (cx == 0 || cy == 0)
+		return;
+
+	obs_enter_graphics();
+
+	if (!texrender)
+		texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+	if (stagingW != cx || stagingH != cy) {
+		releaseStaging();
+		for (size_t idx = 0; idx < staging_count; idx++)
+			staging[idx] = gs_stagesurface_create(cx, cy, GS_RGBA);
+		stagingW = cx;
+		stagingH = cy;
+	}
+
+	gs_texrender_reset(texrender);
+	if (gs_texrender_begin(texrender, cx, cy)) {
+		vec4 clear;
+		vec4_from_rgba(&clear, background);
+		gs_clear(GS_CLEAR_COLOR, &clear, 1.0f, 0);
+
+		gs_blend_state_push();
+		gs_reset_blend_state();
+		draw(param, cx, cy);
+		gs_blend_state_pop();
+
+		gs_texrender_end(texrender);
+
+		gs_stage_texture(staging[stagingIndex], gs_texrender_get_texture(texrender));
+		stagedTime[stagingIndex] = os_gettime_ns();
+		staged[stagingIndex]     = true;
+	}
+
+	// The oldest surface was staged two frames ago, its copy has completed by now.
+	stagingIndex = (stagingIndex + 1) % staging_count;
+	if (staged[stagingIndex]) {
+		uint8_t* data     = nullptr;
+		uint32_t linesize = 0;
+		if (gs_stagesurface_map(staging[stagingIndex], &data, &linesize)) {
+			writer.publish(data, linesize, cx, cy, stagedTime[stagingIndex]);
+			gs_stagesurface_unmap(staging[stagingIndex]);
+		}
+		staged[stagingIndex] = false;
+	}
+
+	obs_leave_graphics();
+}
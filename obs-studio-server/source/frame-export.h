@@ -0,0 +1,71 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <stdint.h>
+#include <string>
+#include <obs.h>
+#include "shared-frame.hpp"
+
+/*!
+* \brief Renders a display into shared memory instead of a window.
+*
+* The display is drawn into a texture and copied into a ring of staging
+* surfaces. A staging surface is mapped two frames after it was filled, so
+* the download does not stall the graphics thread, which also keeps it
+* usable with software GL. Mapped frames are published to the shared
+* triple buffer.
+*/
+class FrameExport
+{
+	public:
+	FrameExport() {}
+	~FrameExport();
+
+	FrameExport(FrameExport const&) = delete;
+	void operator=(FrameExport const&) = delete;
+
+	bool create(uint32_t width, uint32_t height);
+
+	const std::string& name() const;
+	size_t             size() const;
+	uint32_t           maxWidth() const;
+	uint32_t           maxHeight() const;
+
+	// Called on the graphics thread.
+	void render(uint32_t cx, uint32_t cy, uint32_t background, void (*draw)(void*, uint32_t, uint32_t), void* param);
+
+	private:
+	void releaseStaging();
+
+	static const size_t staging_count = 3;
+
+	std::string           mappingName;
+	shared_frame::mapping memory;
+	shared_frame::writer  writer;
+	uint32_t              maxW = 0;
+	uint32_t              maxH = 0;
+
+	gs_texrender_t* texrender                 = nullptr;
+	gs_stagesurf_t* staging[staging_count]    = {};
+	uint64_t        stagedTime[staging_count] = {};
+	bool            staged[staging_count]     = {};
+	size_t          stagingIndex              = 0;
+	uint32_t        stagingW                  = 0;
+	uint32_t        stagingH                  = 0;
+};
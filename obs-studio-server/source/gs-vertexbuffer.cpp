@@ -18,6 +18,7 @@
 
 #include "gs-vertexbuffer.h"
 #include <stdexcept>
+#include <utility>
 #include "util-memory.h"
 extern "C" {
 #pragma warning(push)
@@ -61,6 +62,10 @@ GS::VertexBuffer::~VertexBuffer()
 			m_vertexbufferdata = nullptr;
 		}
 	}
+	if (m_spare) {
+		DestroyVertexBuffer(m_spare);
+		m_spare = nullptr;
+	}
 	if (m_vertexbuffer) {
 		obs_enter_graphics();
 		gs_vertexbuffer_destroy(m_vertexbuffer);
@@ -69,9 +74,9 @@ GS::VertexBuffer::~VertexBuffer()
 	}
 }
 
-GS::VertexBuffer::VertexBuffer(uint32_t maximumVertices)
+GS::VertexBuffer::VertexBuffer(uint32_t maximumVertices, bool streaming)
 {
-	SetupVertexBuffer(maximumVertices);
+	SetupVertexBuffer(maximumVertices, streaming);
 
 	// In case of device being removed, try again to create VertexBuffer
 	// after manually rebuilding GPU device
@@ -85,7 +90,7 @@ GS::VertexBuffer::VertexBuffer(uint32_t maximumVertices)
 		// in case the exception is thrown during m_vertexbuffer creation,
 		// it would delete the m_vertexbufferdata as well,
 		// thus, need to recreate everything from scratch.
-		SetupVertexBuffer(maximumVertices);
+		SetupVertexBuffer(maximumVertices, streaming);
 
 		if (!m_vertexbuffer) {
 			throw std::runtime_error("Failed to create vertex buffer.");
@@ -151,6 +156,8 @@ GS::VertexBuffer::VertexBuffer(VertexBuffer const&& other)
 	m_vertexbuffer     = other.m_vertexbuffer;
 	m_layerdata        = other.m_layerdata;
 	m_colors           = other.m_colors;
+	m_range            = other.m_range;
+	m_spare            = other.m_spare;
 }
 
 void GS::VertexBuffer::operator=(VertexBuffer const&& other)
@@ -190,6 +197,10 @@ void GS::VertexBuffer::operator=(VertexBuffer const&& other)
 			m_vertexbufferdata = nullptr;
 		}
 	}
+	if (m_spare) {
+		DestroyVertexBuffer(m_spare);
+		m_spare = nullptr;
+	}
 	if (m_vertexbuffer) {
 		obs_enter_graphics();
 		gs_vertexbuffer_destroy(m_vertexbuffer);
@@ -211,6 +222,8 @@ void GS::VertexBuffer::operator=(VertexBuffer const&& other)
 	m_vertexbuffer     = other.m_vertexbuffer;
 	m_layerdata        = other.m_layerdata;
 	m_colors           = other.m_colors;
+	m_range            = other.m_range;
+	m_spare            = other.m_spare;
 }
 
 void GS::VertexBuffer::Resize(uint32_t new_size)
@@ -295,10 +308,18 @@ gs_vertbuffer_t* GS::VertexBuffer::Update(bool refreshGPU)
 	if (m_size > m_capacity)
 		throw std::out_of_range("size is larger than capacity");
 
+	// Streaming buffers only send the used range, into the copy the GPU is not drawing from.
+	uint32_t previous = m_range.Current();
+	uint32_t count    = m_range.Upload(m_size);
+	if (count == 0)
+		return m_vertexbuffer;
+	if (m_range.Current() != previous)
+		std::swap(m_vertexbuffer, m_spare);
+
 	// Update VertexBuffer data.
 	m_vertexbufferdata = gs_vertexbuffer_get_data(m_vertexbuffer);
 	memset(m_vertexbufferdata, 0, sizeof(gs_vb_data));
-	m_vertexbufferdata->num      = m_capacity;
+	m_vertexbufferdata->num      = count;
 	m_vertexbufferdata->points   = m_positions;
 	m_vertexbufferdata->normals  = m_normals;
 	m_vertexbufferdata->tangents = m_tangents;
@@ -330,7 +351,7 @@ gs_vertbuffer_t* GS::VertexBuffer::Update()
 	return Update(true);
 }
 
-void GS::VertexBuffer::SetupVertexBuffer(uint32_t maximumVertices)
+void GS::VertexBuffer::SetupVertexBuffer(uint32_t maximumVertices, bool streaming)
 {
 	if (maximumVertices > MAXIMUM_VERTICES) {
 		throw std::out_of_range("maximumVertices out of range");
@@ -367,5 +388,42 @@ void GS::VertexBuffer::SetupVertexBuffer(uint32_t maximumVertices)
 	memset(m_vertexbufferdata, 0, sizeof(gs_vb_data));
 	m_vertexbufferdata->num     = m_capacity;
 	m_vertexbufferdata->num_tex = m_layers;
+
+	// Second copy for streaming buffers, which shares the memory above.
+	m_spare = nullptr;
+	if (streaming && m_vertexbuffer) {
+		gs_vb_data* sparedata = gs_vbdata_create();
+		sparedata->num        = m_capacity;
+		sparedata->points     = m_positions;
+		sparedata->normals    = m_normals;
+		sparedata->tangents   = m_tangents;
+		sparedata->colors     = m_colors;
+		sparedata->num_tex    = m_layers;
+		sparedata->tvarray    = m_layerdata;
+
+		m_spare = gs_vertexbuffer_create(sparedata, GS_DYNAMIC);
+		if (m_spare) {
+			sparedata = gs_vertexbuffer_get_data(m_spare);
+			memset(sparedata, 0, sizeof(gs_vb_data));
+			sparedata->num     = m_capacity;
+			sparedata->num_tex = m_layers;
+		} else {
+			// Fall back to a single copy, still only sending the used range.
+			blog(LOG_WARNING, "GS::VertexBuffer: failed to create second copy of streaming buffer");
+		}
+	}
+	obs_leave_graphics();
+
+	m_range = GS::VertexRange(m_capacity, streaming, m_spare ? MAXIMUM_STREAM_COPIES : 1);
+}
+
+void GS::VertexBuffer::DestroyVertexBuffer(gs_vertbuffer_t* vertexbuffer)
+{
+	// The memory is owned by this object, keep OBS from freeing it.
+	obs_enter_graphics();
+	gs_vb_data* data = gs_vertexbuffer_get_data(vertexbuffer);
+	if (data)
+		memset(data, 0, sizeof(gs_vb_data));
+	gs_vertexbuffer_destroy(vertexbuffer);
 	obs_leave_graphics();
 }
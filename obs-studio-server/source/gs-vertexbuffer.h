@@ -20,6 +20,7 @@
 #include <inttypes.h>
 #include "gs-limits.h"
 #include "gs-vertex.h"
+#include "gs-vertexrange.h"
 #include "util-memory.h"
 extern "C" {
 #pragma warning(push)
@@ -40,7 +41,18 @@ namespace GS
 		*
 		* \param maximumVertices Maximum amount of vertices to store.
 		*/
-		VertexBuffer(uint32_t maximumVertices);
+		VertexBuffer(uint32_t maximumVertices) : VertexBuffer(maximumVertices, false){};
+
+		/*!
+		* \brief Create a Vertex Buffer with a specific number of Vertices.
+		* A streaming buffer only uploads the vertices in use (see Size()) and
+		* alternates between two GPU copies, so that rewriting it every frame
+		* does not wait on the GPU still drawing the previous frame.
+		*
+		* \param maximumVertices Maximum amount of vertices to store.
+		* \param streaming Whether the buffer is rewritten every frame.
+		*/
+		VertexBuffer(uint32_t maximumVertices, bool streaming);
 
 		/*!
 		* \brief Create a Vertex Buffer with the maximum number of Vertices.
@@ -152,7 +164,8 @@ namespace GS
 		gs_vertbuffer_t* Update(bool refreshGPU);
 
 		private:
-		void SetupVertexBuffer(uint32_t maximumVertices);
+		void SetupVertexBuffer(uint32_t maximumVertices, bool streaming);
+		void DestroyVertexBuffer(gs_vertbuffer_t* vertexbuffer);
 
 		private:
 		uint32_t m_size;
@@ -166,6 +179,10 @@ namespace GS
 		uint32_t* m_colors;
 		vec4*     m_uvs[MAXIMUM_UVW_LAYERS];
 
+		// Upload range and second GPU copy of streaming buffers
+		GS::VertexRange  m_range;
+		gs_vertbuffer_t* m_spare = nullptr;
+
 		// OBS GS Data
 		public:
 		gs_vb_data*      m_vertexbufferdata;
@@ -0,0 +1,81 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+
+namespace GS
+{
+	static const uint32_t MAXIMUM_STREAM_COPIES = 2u;
+
+	/*!
+	* \brief Decides how much of a vertex buffer is sent to the GPU and into which copy.
+	*
+	* A static buffer always uploads its whole capacity into its only copy.
+	* A streaming buffer uploads only the used range and rotates between its copies,
+	* so the GPU can still read the previous frame while the next one is written.
+	*/
+	class VertexRange
+	{
+		public:
+		VertexRange(uint32_t capacity = 0, bool streaming = false, uint32_t copies = 1)
+		    : m_capacity(capacity), m_streaming(streaming), m_copies(copies), m_current(0)
+		{
+			if (!m_streaming || m_copies < 1)
+				m_copies = 1;
+			if (m_copies > MAXIMUM_STREAM_COPIES)
+				m_copies = MAXIMUM_STREAM_COPIES;
+		}
+
+		/*!
+		* \brief Prepare an upload of a buffer that has \p size vertices in use.
+		*
+		* \param size Number of used vertices, clamped to the capacity.
+		* \return The number of vertices to send, 0 if nothing has to be sent.
+		*/
+		uint32_t Upload(uint32_t size)
+		{
+			if (!m_streaming)
+				return m_capacity;
+
+			if (size > m_capacity)
+				size = m_capacity;
+
+			// Nothing is drawn from an empty buffer, the current copy stays as is.
+			if (size == 0)
+				return 0;
+
+			m_current = (m_current + 1) % m_copies;
+			return size;
+		}
+
+		/*!
+		* \brief Index of the copy that received the last upload, the one to draw from.
+		*/
+		uint32_t Current() const
+		{
+			return m_current;
+		}
+
+		private:
+		uint32_t m_capacity;
+		bool     m_streaming;
+		uint32_t m_copies;
+		uint32_t m_current;
+	};
+} // namespace GS
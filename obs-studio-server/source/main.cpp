@@ -36,8 +36,10 @@
 #include "osn-global.hpp"
 #include "osn-input.hpp"
 #include "osn-module.hpp"
+#include "osn-profiler.hpp"
 #include "osn-properties.hpp"
 #include "osn-scene.hpp"
+#include "osn-scenecollection.hpp"
 #include "osn-sceneitem.hpp"
 #include "osn-source.hpp"
 #include "osn-transition.hpp"
@@ -171,11 +173,13 @@ int main(int argc, char* argv[])
 	osn::Transition::Register(myServer);
 	osn::Scene::Register(myServer);
 	osn::SceneItem::Register(myServer);
+	osn::SceneCollection::Register(myServer);
 	osn::Fader::Register(myServer);
 	osn::Volmeter::Register(myServer);
 	osn::Properties::Register(myServer);
 	osn::Video::Register(myServer);
 	osn::Module::Register(myServer);
+	osn::Profiler::Register(myServer);
 	CallbackManager::Register(myServer);
 	OBS_API::Register(myServer);
 	OBS_content::Register(myServer);
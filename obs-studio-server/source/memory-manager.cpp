@@ -17,26 +17,84 @@
 ******************************************************************************/
 
 #include "memory-manager.h"
+#include <fstream>
+#include <string>
+#include <util/platform.h>
 
 MemoryManager::MemoryManager()
 {
+	current_cached_size = 0;
+	evictions           = 0;
+	readmissions        = 0;
+	total_memory        = 0;
+	available_memory    = 0;
+	process_rss         = 0;
+
+	if (updateMemoryStatus() && total_memory)
+		max_cached_size = std::min((uint64_t)LIMIT, (uint64_t)total_memory / 2);
+	else
+		max_cached_size = LIMIT;
+
+	allowed_cached_size = max_cached_size;
+}
+
+bool MemoryManager::updateMemoryStatus(void)
+{
+	process_rss = os_get_proc_resident_size();
+
 #ifdef WIN32
 	MEMORYSTATUSEX statex;
 	statex.dwLength = sizeof(statex);
 
-	if (GlobalMemoryStatusEx(&statex)) {
-		available_memory    = statex.ullTotalPhys;
-		allowed_cached_size = std::min((uint64_t)LIMIT, (uint64_t)available_memory / 2);
-	} else {
-		available_memory    = 0;
-		allowed_cached_size = LIMIT;
-	}
+	if (!GlobalMemoryStatusEx(&statex))
+		return false;
+
+	total_memory     = statex.ullTotalPhys;
+	available_memory = statex.ullAvailPhys;
+	return true;
 #elif __APPLE__
-	available_memory = g_util_osx->getTotalPhysicalMemory();
-	allowed_cached_size = std::min((uint64_t)LIMIT, (uint64_t)available_memory / 2);
+	total_memory     = g_util_osx->getTotalPhysicalMemory();
+	available_memory = g_util_osx->getAvailableMemory();
+	return true;
+#else
+	// MemAvailable accounts for reclaimable page cache, MemFree alone would overstate the pressure
+	std::ifstream meminfo("/proc/meminfo");
+	if (!meminfo.is_open())
+		return false;
+
+	uint64_t    total = 0, available = 0;
+	std::string key;
+	uint64_t    value;
+	std::string unit;
+	while (meminfo >> key >> value) {
+		std::getline(meminfo, unit);
+		if (key == "MemTotal:")
+			total = value * 1024;
+		else if (key == "MemAvailable:")
+			available = value * 1024;
+	}
+
+	if (!total)
+		return false;
+
+	total_memory     = total;
+	available_memory = available;
+	return true;
 #endif
 }
 
+MemoryManager::~MemoryManager()
+{
+	{
+		std::unique_lock<std::mutex> ulock(scheduler.mtx);
+		scheduler.stop = true;
+		scheduler.cv.notify_one();
+	}
+
+	if (scheduler.worker.joinable())
+		scheduler.worker.join();
+}
+
 void MemoryManager::calculateRawSize(source_info* si)
 {
 	calldata_t      cd = {0};
@@ -114,41 +172,34 @@ void updateSource(obs_source_t* source, bool caching)
 	obs_data_release(settings);
 }
 
-void MemoryManager::addCachedMemory(source_info* si)
+uint32_t MemoryManager::addCachedMemory(source_info* si)
 {
-	std::unique_lock<std::mutex> ulock(si->mtx);
-
 	if (!si->size || si->cached || current_cached_size + si->size > allowed_cached_size)
-		return;
-
-	int32_t retry = MAX_POOLS;
+		return 0;
 
+	calldata_t      cd = {0};
 	proc_handler_t* ph = obs_source_get_proc_handler(si->source);
-	bool            playing = false;
-	while (retry > 0) {
-		calldata_t      cd = {0};
-		proc_handler_call(ph, "get_playing", &cd);
-		playing = calldata_bool(&cd, "playing");
-		if (playing)
-			break;
-
-		retry--;
-		std::this_thread::sleep_for(std::chrono::milliseconds(100));
-	}
+	proc_handler_call(ph, "get_playing", &cd);
+	bool playing = calldata_bool(&cd, "playing");
 
 	if (!playing)
-		return;
+		return --si->playing_retries > 0 ? PLAYING_RETRY_DELAY_MS : 0;
 
 	blog(LOG_INFO, "adding %dMB, source: %s", si->size / 1000000, obs_source_get_name(si->source));
 	current_cached_size += si->size;
 	si->cached          =  true;
 
+	if (si->evicted) {
+		si->evicted = false;
+		readmissions++;
+	}
+
 	updateSource(si->source, true);
+	return 0;
 }
 
 void MemoryManager::removeCachedMemory(source_info* si, bool cacheNewFiles)
 {
-	std::unique_lock<std::mutex> ulock(si->mtx);
 	if (!si->cached)
 		return;
 
@@ -161,74 +212,280 @@ void MemoryManager::removeCachedMemory(source_info* si, bool cacheNewFiles)
 	if (!cacheNewFiles || current_cached_size >= allowed_cached_size)
 		return;
 
+	// Let the worker pick up sources that now fit in the freed space, most useful first.
+	uint64_t room = allowed_cached_size - current_cached_size;
+	for (auto candidate : admissionCandidates()) {
+		if (candidate == si || candidate->size > room)
+			continue;
 
-	for (auto data : sources) {
-		if (strcmp(obs_source_get_name(si->source), data.first) != 0 && shouldCacheSource(data.second))
-			addCachedMemory(data.second);
+		room -= candidate->size;
+		updateSettings(candidate->source);
 	}
 }
 
-void MemoryManager::sourceManager(source_info* si)
+std::vector<source_info*> MemoryManager::admissionCandidates(void)
 {
-	si->mtx.lock();
-	obs_data_t*                  settings = obs_source_get_settings(si->source);
+	std::vector<source_info*> candidates;
+	for (auto data : sources) {
+		if (!data.second->cached && data.second->size && shouldCacheSource(data.second))
+			candidates.push_back(data.second);
+	}
 
-	bool looping    = obs_data_get_bool(settings, "looping");
-	bool local_file = obs_data_get_bool(settings, "is_local_file");
+	// Benefit is how often a file is shown for each byte it would keep in memory
+	auto benefit = [](source_info* si) { return double(si->show_count + 1) / double(si->size); };
+	std::sort(candidates.begin(), candidates.end(), [&benefit](source_info* a, source_info* b) {
+		return benefit(a) > benefit(b);
+	});
+	return candidates;
+}
 
-	obs_data_release(settings);
-	if (!looping || !local_file) {
-		si->mtx.unlock();
+void MemoryManager::monitorMemory(void)
+{
+	if (!updateMemoryStatus() || !total_memory)
 		return;
-	}
-	si->mtx.unlock();
 
-	if (si->size == 0) {
-		uint32_t retry = MAX_POOLS;
-		while (retry > 0) {
-			mtx.lock();
-			si->mtx.lock();
-			calculateRawSize(si);
-
-			if (si->size || !si->have_video) {
-				si->mtx.unlock();
-				mtx.unlock();
+	uint64_t in_use      = total_memory - std::min(available_memory, total_memory);
+	float    memory_load = (float)in_use / (float)total_memory * 100;
+
+	if (memory_load >= UPPER_LIMIT) {
+		// Evict sources that are hidden and were shown the longest time ago first
+		std::vector<source_info*> cached;
+		for (auto data : sources) {
+			if (data.second->cached)
+				cached.push_back(data.second);
+		}
+		std::sort(cached.begin(), cached.end(), [](source_info* a, source_info* b) {
+			if (a->showing != b->showing)
+				return !a->showing;
+			return a->last_shown < b->last_shown;
+		});
+
+		uint64_t target = total_memory / 100 * (UPPER_LIMIT - 10);
+		for (auto si : cached) {
+			if (in_use <= target)
 				break;
-			}
-			si->mtx.unlock();
-			mtx.unlock();
 
-			retry--;
-			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+			in_use -= std::min(in_use, si->size);
+			removeCachedMemory(si, false);
+			si->evicted = true;
+			evictions++;
+		}
+
+		// Shrink the budget so that evicted files are not admitted again right away
+		allowed_cached_size = current_cached_size;
+	} else if (memory_load < LOWER_LIMIT) {
+		uint64_t target = total_memory / 100 * (LOWER_LIMIT + 10);
+		uint64_t room   = target > in_use ? target - in_use : 0;
+
+		allowed_cached_size = std::min(max_cached_size, current_cached_size + room);
+		room                = allowed_cached_size - current_cached_size;
+
+		for (auto si : admissionCandidates()) {
+			if (si->size > room)
+				continue;
+
+			room -= si->size;
+			updateSettings(si->source);
 		}
 	}
+}
+
+media_cache_stats MemoryManager::getStats(void)
+{
 	std::unique_lock<std::mutex> ulock(mtx);
-	si->mtx.lock();
-	if (!si->size) {
-		si->mtx.unlock();
-		return;
+
+	media_cache_stats stats     = {};
+	stats.total_memory          = total_memory;
+	stats.available_memory      = available_memory;
+	stats.process_rss           = process_rss;
+	stats.allowed_cached_size   = allowed_cached_size;
+	stats.cached_size           = current_cached_size;
+	stats.tracked_sources       = uint32_t(sources.size());
+	stats.evictions             = evictions;
+	stats.readmissions          = readmissions;
+	for (auto data : sources) {
+		if (data.second->cached)
+			stats.cached_sources++;
 	}
-	bool should_cache = shouldCacheSource(si);
-	si->mtx.unlock();
+	return stats;
+}
 
-	if (should_cache)
-		addCachedMemory(si);
-	else
-		removeCachedMemory(si, true);
+uint32_t MemoryManager::sourceManager(source_info* si)
+{
+	// Activation changes land here, which is where the showing history is kept
+	bool showing = obs_source_showing(si->source);
+	if (showing && !si->showing)
+		si->show_count++;
+	if (showing || si->showing)
+		si->last_shown = os_gettime_ns();
+	si->showing = showing;
+
+	obs_data_t* settings = obs_source_get_settings(si->source);
+
+	bool looping    = obs_data_get_bool(settings, "looping");
+	bool local_file = obs_data_get_bool(settings, "is_local_file");
+
+	obs_data_release(settings);
+	if (!looping || !local_file)
+		return 0;
+
+	if (si->size == 0) {
+		calculateRawSize(si);
+
+		// The file may not be opened yet, check again later
+		if (!si->size && si->have_video && --si->size_retries > 0)
+			return SIZE_RETRY_DELAY_MS;
+	}
+
+	if (!si->size)
+		return 0;
+
+	if (shouldCacheSource(si))
+		return addCachedMemory(si);
+
+	removeCachedMemory(si, true);
+	return 0;
 }
 
 void MemoryManager::updateSettings(obs_source_t * source)
 {
-	auto it = sources.find(obs_source_get_name(source));
+	auto it = sources.find(source);
 
 	if (it == sources.end())
 		return;
 
-	it->second->workers.push_back(std::thread(&MemoryManager::sourceManager, this, it->second));
+	it->second->size_retries    = MAX_POOLS;
+	it->second->playing_retries = MAX_POOLS;
+	enqueue(source);
+}
+
+void MemoryManager::enqueue(obs_source_t* source)
+{
+	std::unique_lock<std::mutex> ulock(scheduler.mtx);
+
+	if (!scheduler.queued.insert(source).second)
+		return;
+
+	scheduler.queue.push_back(source);
+	scheduler.cv.notify_one();
+}
+
+void MemoryManager::scheduleRetry(obs_source_t* source, uint32_t delay_ms)
+{
+	std::unique_lock<std::mutex> ulock(scheduler.mtx);
+
+	// A source has at most one pending retry, the latest one wins.
+	for (auto& slot : scheduler.wheel) {
+		size_t count = slot.size();
+		slot.erase(
+		    std::remove_if(slot.begin(), slot.end(), [source](const timer_entry& e) { return e.source == source; }),
+		    slot.end());
+		scheduler.wheel_size -= count - slot.size();
+	}
+
+	if (!scheduler.wheel_size)
+		scheduler.next_tick = std::chrono::steady_clock::now() + std::chrono::milliseconds(WHEEL_TICK_MS);
+
+	uint32_t ticks = std::max<uint32_t>(1, (delay_ms + WHEEL_TICK_MS - 1) / WHEEL_TICK_MS);
+	scheduler.wheel[(scheduler.wheel_pos + ticks) % WHEEL_SLOTS].push_back({source, (ticks - 1) / WHEEL_SLOTS});
+	scheduler.wheel_size++;
+	scheduler.cv.notify_one();
+}
+
+void MemoryManager::advanceWheel(void)
+{
+	auto now = std::chrono::steady_clock::now();
+
+	while (scheduler.wheel_size && scheduler.next_tick <= now) {
+		scheduler.wheel_pos = (scheduler.wheel_pos + 1) % WHEEL_SLOTS;
+		scheduler.next_tick += std::chrono::milliseconds(WHEEL_TICK_MS);
+
+		auto& slot = scheduler.wheel[scheduler.wheel_pos];
+		for (auto it = slot.begin(); it != slot.end();) {
+			if (it->rounds) {
+				it->rounds--;
+				++it;
+				continue;
+			}
+
+			if (scheduler.queued.insert(it->source).second)
+				scheduler.queue.push_back(it->source);
+
+			it = slot.erase(it);
+			scheduler.wheel_size--;
+		}
+	}
+}
+
+void MemoryManager::cancelPending(obs_source_t* source)
+{
+	std::unique_lock<std::mutex> ulock(scheduler.mtx);
+
+	if (scheduler.queued.erase(source))
+		scheduler.queue.erase(std::remove(scheduler.queue.begin(), scheduler.queue.end(), source), scheduler.queue.end());
+
+	for (auto& slot : scheduler.wheel) {
+		size_t count = slot.size();
+		slot.erase(
+		    std::remove_if(slot.begin(), slot.end(), [source](const timer_entry& e) { return e.source == source; }),
+		    slot.end());
+		scheduler.wheel_size -= count - slot.size();
+	}
+}
+
+void MemoryManager::schedulerLoop(void)
+{
+	std::unique_lock<std::mutex> lock(scheduler.mtx);
+
+	scheduler.next_check = std::chrono::steady_clock::now() + std::chrono::milliseconds(MONITOR_INTERVAL_MS);
+
+	while (!scheduler.stop) {
+		advanceWheel();
+
+		if (std::chrono::steady_clock::now() >= scheduler.next_check) {
+			scheduler.next_check += std::chrono::milliseconds(MONITOR_INTERVAL_MS);
+			lock.unlock();
+			{
+				std::unique_lock<std::mutex> ulock(mtx);
+				monitorMemory();
+			}
+			lock.lock();
+			continue;
+		}
+
+		if (scheduler.queue.empty()) {
+			if (scheduler.wheel_size)
+				scheduler.cv.wait_until(lock, std::min(scheduler.next_tick, scheduler.next_check));
+			else
+				scheduler.cv.wait_until(lock, scheduler.next_check);
+			continue;
+		}
+
+		obs_source_t* source = scheduler.queue.front();
+		scheduler.queue.pop_front();
+		scheduler.queued.erase(source);
+		lock.unlock();
+
+		{
+			std::unique_lock<std::mutex> ulock(mtx);
+
+			auto it = sources.find(source);
+			if (it != sources.end()) {
+				uint32_t delay = sourceManager(it->second);
+				if (delay)
+					scheduleRetry(source, delay);
+			}
+		}
+
+		lock.lock();
+	}
 }
 
 void MemoryManager::updateSourceCache(obs_source_t* source)
 {
+	if (strcmp(obs_source_get_id(source), "ffmpeg_source") != 0)
+		return;
+
 	std::unique_lock<std::mutex> ulock(mtx);
 
 	updateSettings(source);
@@ -239,7 +496,7 @@ void MemoryManager::updateSourcesCache(void)
 	std::unique_lock<std::mutex> ulock(mtx);
 
 	for (auto data : sources)
-		updateSettings(data.second->source);
+		updateSettings(data.first);
 }
 
 void MemoryManager::registerSource(obs_source_t* source)
@@ -249,15 +506,24 @@ void MemoryManager::registerSource(obs_source_t* source)
 
 	std::unique_lock<std::mutex> ulock(mtx);
 
-	source_info* si = new source_info;
-	si->cached      = false;
-	si->size        = 0;
-	si->source      = source;
-	sources.emplace(obs_source_get_name(source), si);
+	source_info* si     = new source_info;
+	si->cached          = false;
+	si->size            = 0;
+	si->source          = source;
+	si->have_video      = false;
+	si->size_retries    = MAX_POOLS;
+	si->playing_retries = MAX_POOLS;
+	si->showing         = false;
+	si->last_shown      = 0;
+	si->show_count      = 0;
+	si->evicted         = false;
+	sources.emplace(source, si);
 	updateSource(source, false);
-	if (!watcher.running) {
-		watcher.running = true;
-		watcher.worker  = std::thread(&MemoryManager::monitorMemory, this);
+
+	std::unique_lock<std::mutex> slock(scheduler.mtx);
+	if (!scheduler.running) {
+		scheduler.running = true;
+		scheduler.worker  = std::thread(&MemoryManager::schedulerLoop, this);
 	}
 }
 
@@ -268,82 +534,19 @@ void MemoryManager::unregisterSource(obs_source_t * source)
 
 	mtx.lock();
 
-	auto it = sources.find(obs_source_get_name(source));
+	auto it = sources.find(source);
 
 	if (it == sources.end()) {
 		mtx.unlock();
 		return;
 	}
-	mtx.unlock();
-
-	for (auto& worker : it->second->workers) {
-		if (worker.joinable())
-			worker.join();
-	}
-
-	mtx.lock();
-	
-	it->second->workers.clear();
-	removeCachedMemory(it->second, true);
-
-	free(it->second);
-	sources.erase(obs_source_get_name(source));
-
-	if (!sources.size() && watcher.running) {
-		watcher.stop    = true;
-		mtx.unlock();
-		if (watcher.worker.joinable())
-			watcher.worker.join();
-
-		watcher.running = false;
-	} else {
-		mtx.unlock();
-	}
 
-}
+	// The worker only touches a source while holding mtx, so nothing refers to it past this point.
+	cancelPending(source);
+	source_info* si = it->second;
+	sources.erase(it);
+	removeCachedMemory(si, true);
+	delete si;
 
-void MemoryManager::monitorMemory()
-{
-// #ifdef WIN32
-// 	while (!watcher.stop) {
-// 		MEMORYSTATUSEX statex;
-// 		statex.dwLength = sizeof(statex);
-
-// 		if (!GlobalMemoryStatusEx(&statex))
-// 			return;
-
-// 		uint64_t memory_in_use               = statex.ullTotalPhys - statex.ullAvailPhys;
-// 		uint64_t memory_in_use_without_cache = memory_in_use - current_cached_size;
-// 		uint64_t totalMeory                  = statex.ullTotalPhys;
-// #ifdef __APPLE__
-// 		uint64_t totalMeory = g_util_osx->getTotalPhysicalMemory();
-// 		uint64_t availableMemory = g_util_osx->getAvailableMemory();
-// 		uint64_t memory_in_use = totalMeory - availableMemory;
-// 		uint64_t memory_in_use_without_cache =
-// 			memory_in_use - current_cached_size;
-// #endif
-// 		std::unique_lock<std::mutex> ulock(mtx);
-
-// 		float memory_load =
-// 			(float)(memory_in_use_without_cache + current_cached_size) / (float)totalMeory * 100;
-// 		auto it = sources.begin();
-// 		if (memory_load >= UPPER_LIMIT) {
-// 			while (memory_load >= (UPPER_LIMIT - 10) && it != sources.end()) {
-// 				removeCachedMemory(it->second, false);
-// 				memory_load =
-// 					(float)(memory_in_use_without_cache + current_cached_size) / (float)totalMeory * 100;
-// 				it++;
-// 			}
-// 		} else if (memory_load < LOWER_LIMIT) {
-// 			while (memory_load < (LOWER_LIMIT + 10) && it != sources.end()) {
-// 				if (shouldCacheSource(it->second))
-// 					addCachedMemory(it->second);
-// 				memory_load =
-// 					(float)(memory_in_use_without_cache + current_cached_size) / (float)totalMeory * 100;
-// 				it++;
-// 			}
-// 		}
-// 		std::this_thread::sleep_for(std::chrono::milliseconds(500));
-// 	}
-// #endif
+	mtx.unlock();
 }
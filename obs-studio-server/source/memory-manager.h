@@ -24,6 +24,10 @@
 #include <algorithm>
 #include <vector>
 #include <thread>
+#include <deque>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_set>
 #include <shared.hpp>
 
 #ifdef WIN32
@@ -36,14 +40,42 @@
 #define UPPER_LIMIT 80
 #define LOWER_LIMIT 50
 
+// Delays between two attempts when the media file isn't ready yet
+#define SIZE_RETRY_DELAY_MS 500
+#define PLAYING_RETRY_DELAY_MS 100
+
+// Interval of the memory pressure check
+#define MONITOR_INTERVAL_MS 500
+
+// Timer wheel layout, a delay longer than a full turn waits for extra rounds
+#define WHEEL_TICK_MS 100
+#define WHEEL_SLOTS 16
+
 struct source_info
 {
 	bool          cached;
 	uint64_t      size;
 	obs_source_t* source;
-	std::vector<std::thread> workers;
-	std::mutex    mtx;
 	bool          have_video;
+	int32_t       size_retries;
+	int32_t       playing_retries;
+	bool          showing;
+	uint64_t      last_shown;
+	uint32_t      show_count;
+	bool          evicted;
+};
+
+struct media_cache_stats
+{
+	uint64_t total_memory;
+	uint64_t available_memory;
+	uint64_t process_rss;
+	uint64_t allowed_cached_size;
+	uint64_t cached_size;
+	uint32_t tracked_sources;
+	uint32_t cached_sources;
+	uint64_t evictions;
+	uint64_t readmissions;
 };
 
 class MemoryManager {
@@ -56,25 +88,49 @@ class MemoryManager {
 
 	private:
 	MemoryManager();
+	~MemoryManager();
 
 	public:
 	MemoryManager(MemoryManager const&) = delete;
 	void operator=(MemoryManager const&) = delete;
 
 	private:
-	std::map<const char*, source_info*> sources;
+	std::map<obs_source_t*, source_info*> sources;
 
+	// Guards sources and the cached sizes, only held for short, non-blocking steps.
 	std::mutex mtx;
+	uint64_t   total_memory;
 	uint64_t   available_memory;
+	uint64_t   process_rss;
 	uint64_t   current_cached_size;
 	uint64_t   allowed_cached_size;
+	uint64_t   max_cached_size;
+	uint64_t   evictions;
+	uint64_t   readmissions;
 
+	struct timer_entry
+	{
+		obs_source_t* source;
+		uint32_t      rounds;
+	};
+
+	// Single cache worker, fed by a queue that holds each source at most once.
+	// Retries are parked in a timer wheel instead of sleeping.
 	struct
 	{
-		std::thread worker;
-		bool        stop = false;
-		bool        running = false;
-	} watcher;
+		std::thread                           worker;
+		std::mutex                            mtx;
+		std::condition_variable               cv;
+		std::deque<obs_source_t*>             queue;
+		std::unordered_set<obs_source_t*>     queued;
+		std::vector<timer_entry>              wheel[WHEEL_SLOTS];
+		size_t                                wheel_size = 0;
+		size_t                                wheel_pos  = 0;
+		std::chrono::steady_clock::time_point next_tick;
+		std::chrono::steady_clock::time_point next_check;
+		bool                                  stop    = false;
+		bool                                  running = false;
+	} scheduler;
 
 	public:
 	void registerSource(obs_source_t* source);
@@ -83,14 +139,25 @@ class MemoryManager {
 	void updateSourceCache(obs_source_t* source);
 	void updateSourcesCache(void);
 
+	media_cache_stats getStats(void);
+
 	private:
 	void calculateRawSize(source_info* si);
 	bool shouldCacheSource(source_info* si);
+	bool updateMemoryStatus(void);
+
+	std::vector<source_info*> admissionCandidates(void);
 	void updateSettings(obs_source_t* source);
 
-	void addCachedMemory(source_info* si);
-	void removeCachedMemory(source_info* si, bool cacheNewFiles);
+	uint32_t addCachedMemory(source_info* si);
+	void     removeCachedMemory(source_info* si, bool cacheNewFiles);
+
+	uint32_t sourceManager(source_info* si);
+	void     monitorMemory(void);
 
-	void sourceManager(source_info* si);
-	void monitorMemory(void);
+	void enqueue(obs_source_t* source);
+	void scheduleRetry(obs_source_t* source, uint32_t delay_ms);
+	void advanceWheel(void);
+	void cancelPending(obs_source_t* source);
+	void schedulerLoop(void);
 };
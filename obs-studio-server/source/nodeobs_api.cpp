@@ -26,6 +26,11 @@
 #include "osn-volmeter.hpp"
 #include "osn-fader.hpp"
 #include "nodeobs_autoconfig.h"
+#include "memory-manager.h"
+#include "disk-replay-output.h"
+#include "encoder-registry.h"
+#include "performance-sampler.h"
+#include "source-profiler.h"
 #include "util/lexer.h"
 #include "util-crashmanager.h"
 #include "util-metricsprovider.h"
@@ -89,15 +94,12 @@
 #define TBYTE (1024ULL * 1024ULL * 1024ULL * 1024ULL)
 
 std::string g_moduleDirectory = "";
-os_cpu_usage_info_t* cpuUsageInfo      = nullptr;
 #ifdef WIN32
 std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
 #endif
 std::string                                            slobs_plugin;
 std::vector<std::pair<std::string, obs_module_t*>>     obsModules;
 OBS_API::LogReport                                     logReport;
-OBS_API::OutputStats                                   streamingOutputStats;
-OBS_API::OutputStats                                   recordingOutputStats;
 std::mutex                                             logMutex;
 std::string                                            currentVersion;
 std::string                                            username("unknown");
@@ -117,6 +119,12 @@ void OBS_API::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("OBS_API_destroyOBS_API", std::vector<ipc::type>{}, OBS_API_destroyOBS_API));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_API_getPerformanceStatistics", std::vector<ipc::type>{}, OBS_API_getPerformanceStatistics));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_API_getPerformanceSamples", std::vector<ipc::type>{ipc::type::UInt64}, OBS_API_getPerformanceSamples));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_API_getOutputSamples", std::vector<ipc::type>{ipc::type::UInt64}, OBS_API_getOutputSamples));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_API_getMediaCacheStats", std::vector<ipc::type>{}, OBS_API_getMediaCacheStats));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "SetWorkingDirectory", std::vector<ipc::type>{ipc::type::String}, SetWorkingDirectory));
 	cls->register_function(
@@ -676,6 +684,7 @@ void OBS_API::OBS_API_initAPI(
 
 	std::vector<char> userData = std::vector<char>(1024);
 	os_get_config_path(userData.data(), userData.capacity() - 1, "slobs-client/plugin_config");
+	SourceProfiler::initialize();
     if (!obs_startup(locale.c_str(), userData.data(), NULL)) {
             // TODO: We should return an error code if obs fails to initialize.
             // This was added as a temporary measure to detect what could be happening in some
@@ -730,7 +739,6 @@ void OBS_API::OBS_API_initAPI(
 
 	osn::Source::initialize_global_signals();
 
-	cpuUsageInfo = os_cpu_usage_info_start();
 	ConfigManager::getInstance().setAppdataPath(appdata);
 
 	/* Set global private settings for whomever it concerns */
@@ -759,10 +767,17 @@ void OBS_API::OBS_API_initAPI(
 		std::string data_path = g_moduleDirectory + "/enc-amf_old/data/obs-plugins/enc-amf/";
 		int res = obs_open_module(&module, module_path.c_str(), data_path.c_str());
 
-		if (res == MODULE_SUCCESS)
+		if (res == MODULE_SUCCESS) {
 			obs_init_module(module);
+			EncoderRegistry::GetInstance().invalidate();
+		}
 	}
 
+	// Enumerate encoder capabilities once, settings, service and autoconfig share them
+	EncoderRegistry::GetInstance().refresh();
+
+	DiskReplayOutput::Register();
+
 	OBS_service::createService();
 	OBS_service::createStreamingOutput();
 	OBS_service::createRecordingOutput();
@@ -796,6 +811,10 @@ void OBS_API::OBS_API_initAPI(
 	obs_set_replay_buffer_rendering_mode(
 		useStreamOutput ? OBS_STREAMING_REPLAY_BUFFER_RENDERING : OBS_RECORDING_REPLAY_BUFFER_RENDERING);
 
+	// Statistics are sampled in the background, polls only read the latest sample
+	PerformanceSampler::GetInstance().start();
+	SourceProfiler::GetInstance().start();
+
 	util::CrashManager::setAppState("idle");
 
 	// We are returning a video result here because the frontend needs to know if we sucessfully
@@ -830,24 +849,117 @@ void OBS_API::OBS_API_getPerformanceStatistics(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	performance_sample sample = PerformanceSampler::GetInstance().latest();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+
+	rval.push_back(ipc::value(sample.cpu));
+	rval.push_back(ipc::value(sample.dropped_frames));
+	rval.push_back(ipc::value(sample.dropped_frames_percent));
+
+	rval.push_back(ipc::value(sample.streaming_kbps));
+	rval.push_back(ipc::value(sample.streaming_mb));
+
+	rval.push_back(ipc::value(sample.recording_kbps));
+	rval.push_back(ipc::value(sample.recording_mb));
+
+	rval.push_back(ipc::value(sample.fps));
+	rval.push_back(ipc::value(sample.render_ms));
+	rval.push_back(ipc::value(sample.memory_mb));
+	rval.push_back(ipc::value(formatDiskSpace(sample.disk_free)));
+
+	recording_start_stats recordingStart = OBS_service::getRecordingStartStats();
+	rval.push_back(ipc::value(recordingStart.starts));
+	rval.push_back(ipc::value(recordingStart.warm_starts));
+	rval.push_back(ipc::value(recordingStart.last_ms));
+	rval.push_back(ipc::value(recordingStart.average_ms));
+	rval.push_back(ipc::value(recordingStart.max_ms));
+	AUTO_DEBUG;
+}
+
+void OBS_API::OBS_API_getPerformanceSamples(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<performance_sample> samples;
+	uint64_t sequence = PerformanceSampler::GetInstance().since(args[0].value_union.ui64, samples);
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(sequence));
+	rval.push_back(ipc::value((uint32_t)samples.size()));
+
+	for (auto& sample : samples) {
+		rval.push_back(ipc::value(sample.sequence));
+		rval.push_back(ipc::value(sample.timestamp));
+		rval.push_back(ipc::value(sample.cpu));
+		rval.push_back(ipc::value(sample.dropped_frames));
+		rval.push_back(ipc::value(sample.dropped_frames_percent));
+		rval.push_back(ipc::value(sample.streaming_kbps));
+		rval.push_back(ipc::value(sample.streaming_mb));
+		rval.push_back(ipc::value(sample.recording_kbps));
+		rval.push_back(ipc::value(sample.recording_mb));
+		rval.push_back(ipc::value(sample.fps));
+		rval.push_back(ipc::value(sample.render_ms));
+		rval.push_back(ipc::value(sample.memory_mb));
+		rval.push_back(ipc::value(sample.disk_free));
+	}
+	AUTO_DEBUG;
+}
 
-	rval.push_back(ipc::value(getCPU_Percentage()));
-	rval.push_back(ipc::value(getNumberOfDroppedFrames()));
-	rval.push_back(ipc::value(getDroppedFramesPercentage()));
+void OBS_API::OBS_API_getOutputSamples(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<performance_sample> samples;
+	uint64_t sequence = PerformanceSampler::GetInstance().since(args[0].value_union.ui64, samples);
 
-	getCurrentOutputStats(OBS_service::getStreamingOutput(), streamingOutputStats);
-	rval.push_back(ipc::value(streamingOutputStats.kbitsPerSec));
-	rval.push_back(ipc::value(streamingOutputStats.dataOutput));
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(sequence));
+	rval.push_back(ipc::value((uint32_t)samples.size()));
+	rval.push_back(ipc::value((uint32_t)SAMPLER_OUTPUTS));
+
+	for (auto& sample : samples) {
+		rval.push_back(ipc::value(sample.sequence));
+		rval.push_back(ipc::value(sample.timestamp));
+
+		for (auto& output : sample.outputs) {
+			rval.push_back(ipc::value((uint32_t)output.active));
+			rval.push_back(ipc::value((uint32_t)output.reconnecting));
+			rval.push_back(ipc::value(output.bytes));
+			rval.push_back(ipc::value(output.kbps));
+			rval.push_back(ipc::value(output.dropped_frames));
+			rval.push_back(ipc::value(output.total_frames));
+			rval.push_back(ipc::value(output.congestion));
+			rval.push_back(ipc::value(output.connect_time_ms));
+			rval.push_back(ipc::value(output.reconnects));
+			rval.push_back(ipc::value(output.skipped_frames));
+		}
+	}
+	AUTO_DEBUG;
+}
 
-	getCurrentOutputStats(OBS_service::getRecordingOutput(), recordingOutputStats);
-	rval.push_back(ipc::value(recordingOutputStats.kbitsPerSec));
-	rval.push_back(ipc::value(recordingOutputStats.dataOutput));
+void OBS_API::OBS_API_getMediaCacheStats(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	media_cache_stats stats = MemoryManager::GetInstance().getStats();
 
-	rval.push_back(ipc::value(getCurrentFrameRate()));
-	rval.push_back(ipc::value(getAverageTimeToRenderFrame()));
-	rval.push_back(ipc::value(getMemoryUsage()));
-	rval.push_back(ipc::value(getDiskSpaceAvailable()));
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(stats.total_memory));
+	rval.push_back(ipc::value(stats.available_memory));
+	rval.push_back(ipc::value(stats.process_rss));
+	rval.push_back(ipc::value(stats.allowed_cached_size));
+	rval.push_back(ipc::value(stats.cached_size));
+	rval.push_back(ipc::value(stats.tracked_sources));
+	rval.push_back(ipc::value(stats.cached_sources));
+	rval.push_back(ipc::value(stats.evictions));
+	rval.push_back(ipc::value(stats.readmissions));
 	AUTO_DEBUG;
 }
 
@@ -1335,7 +1447,8 @@ void OBS_API::destroyOBS_API(void)
 {
 	blog(LOG_DEBUG, "OBS_API::destroyOBS_API started");
 
-	os_cpu_usage_info_destroy(cpuUsageInfo);
+	PerformanceSampler::GetInstance().stop();
+	SourceProfiler::GetInstance().stop();
 
 #ifdef _WIN32
 	config_t* basicConfig         = ConfigManager::getInstance().getBasic();
@@ -1423,6 +1536,9 @@ void OBS_API::destroyOBS_API(void)
 	
 		obs_shutdown();
 	}
+	SourceProfiler::finalize();
+
+	ConfigManager::getInstance().stopPersistence();
 
 	// Release each obs module (dlls for windows)
 	// TODO: We should release these modules (dlls) manually and not let the garbage
@@ -1581,115 +1697,12 @@ bool OBS_API::openAllModules(int& video_err)
 		os_closedir(plugin_dir);
 	}
 
+	EncoderRegistry::GetInstance().invalidate();
 	return true;
 }
 
-double OBS_API::getCPU_Percentage(void)
-{
-	double cpuPercentage = os_cpu_usage_info_query(cpuUsageInfo);
-
-	cpuPercentage *= 10;
-	cpuPercentage = trunc(cpuPercentage);
-	cpuPercentage /= 10;
-
-	return cpuPercentage;
-}
-
-int OBS_API::getNumberOfDroppedFrames(void)
-{
-	obs_output_t* streamOutput = OBS_service::getStreamingOutput();
-
-	int totalDropped = 0;
-
-	if (streamOutput && obs_output_active(streamOutput)) {
-		totalDropped = obs_output_get_frames_dropped(streamOutput);
-	}
-
-	return totalDropped;
-}
-
-double OBS_API::getDroppedFramesPercentage(void)
-{
-	obs_output_t* streamOutput = OBS_service::getStreamingOutput();
-
-	double percent = 0;
-
-	if (streamOutput && obs_output_active(streamOutput)) {
-		int totalDropped = obs_output_get_frames_dropped(streamOutput);
-		int totalFrames  = obs_output_get_total_frames(streamOutput);
-		if (totalFrames == 0) {
-			percent = 0.0;
-		} else {
-			percent = (double)totalDropped / (double)totalFrames * 100.0;
-		}
-	}
-
-	return percent;
-}
-
-void OBS_API::getCurrentOutputStats(obs_output_t* output, OBS_API::OutputStats &outputStats)
-{
-	outputStats.kbitsPerSec = 0.0;
-	outputStats.dataOutput  = 0.0;
-
-	if (!output) {
-		return;
-	}
-
-	if (obs_output_active(output)) {
-		uint64_t bytesSent = obs_output_get_total_bytes(output);
-		uint64_t bytesSentTime = os_gettime_ns();
-
-		if (bytesSent < outputStats.lastBytesSent)
-			bytesSent = 0;
-		if (bytesSent == 0)
-			outputStats.lastBytesSent = 0;
-
-		uint64_t bitsBetween = (bytesSent - outputStats.lastBytesSent) * 8;
-
-		double timePassed = double(bytesSentTime - outputStats.lastBytesSentTime) / 1000000000.0;
-		if (timePassed < std::numeric_limits<double>::epsilon()
-		    && timePassed > -std::numeric_limits<double>::epsilon()) {
-			outputStats.kbitsPerSec = 0.0;
-		} else {
-			outputStats.kbitsPerSec = double(bitsBetween) / timePassed / 1000.0;
-		}
-
-		outputStats.lastBytesSent = bytesSent;
-		outputStats.lastBytesSentTime = bytesSentTime;
-		outputStats.dataOutput = bytesSent / (1024.0 * 1024.0);
-	}
-}
-
-double OBS_API::getCurrentFrameRate(void)
-{
-	return obs_get_active_fps();
-}
-
-double OBS_API::getAverageTimeToRenderFrame()
+std::string OBS_API::formatDiskSpace(uint64_t bytes)
 {
-	return (double)obs_get_average_frame_time_ns() / 1000000.0;
-}
-
-std::string OBS_API::getDiskSpaceAvailable()
-{
-	const char* path = nullptr;
-	const char* mode = config_get_string(ConfigManager::getInstance().getBasic(), "Output", "Mode");
-
-	if (strcmp(mode, "Advanced") == 0) {
-		const char* advanced_mode = config_get_string(ConfigManager::getInstance().getBasic(), "AdvOut", "RecType");
-
-		if (strcmp(advanced_mode, "FFmpeg") == 0) {
-			path = config_get_string(ConfigManager::getInstance().getBasic(), "AdvOut", "FFFilePath");
-		} else {
-			path = config_get_string(ConfigManager::getInstance().getBasic(), "AdvOut", "RecFilePath");
-		}
-	} else {
-		path = config_get_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "FilePath");
-	}
-
-	uint64_t bytes = os_get_free_disk_space(path);
-
 	double free_bytes = 0;
 	std::string type;
 
@@ -1709,11 +1722,6 @@ std::string OBS_API::getDiskSpaceAvailable()
 	return remainingHDSpace.str();
 }
 
-double OBS_API::getMemoryUsage()
-{
-	return (double)os_get_proc_resident_size() / (1024.0 * 1024.0);
-}
-
 const std::vector<std::string>& OBS_API::getOBSLogErrors()
 {
 	return logReport.errors;
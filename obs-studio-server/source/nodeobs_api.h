@@ -70,14 +70,6 @@ class OBS_API
 		std::queue<std::string>  general;
 	};
 
-    struct OutputStats
-    {
-        double kbitsPerSec = 0;
-        double dataOutput= 0;
-        uint64_t lastBytesSent = 0;
-        uint64_t lastBytesSentTime = 0;
-    };
-
     public:
 	OBS_API();
 	~OBS_API();
@@ -99,6 +91,21 @@ class OBS_API
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
+	static void OBS_API_getPerformanceSamples(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void OBS_API_getOutputSamples(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void OBS_API_getMediaCacheStats(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
 	static void SetWorkingDirectory(
 	    void*                          data,
 	    const int64_t                  id,
@@ -127,14 +134,7 @@ class OBS_API
 	static void initAPI(void);
 	static bool openAllModules(int& video_err);
 
-	static double getCPU_Percentage(void);
-	static int    getNumberOfDroppedFrames(void);
-	static double getDroppedFramesPercentage(void);
-	static double getCurrentFrameRate(void);
-	static double getAverageTimeToRenderFrame();
-	static std::string getDiskSpaceAvailable();
-	static double getMemoryUsage();
-	static void getCurrentOutputStats(obs_output_t *output, OBS_API::OutputStats &outputStats);
+	static std::string formatDiskSpace(uint64_t bytes);
 
 
     static const std::vector<std::string>& getOBSLogErrors();
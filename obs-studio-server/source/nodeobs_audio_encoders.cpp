@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "nodeobs_audio_encoders.h"
+#include "encoder-registry.h"
 
 static const std::string encoders[] = {
     "ffmpeg_aac",
@@ -48,105 +49,17 @@ static const char* EncoderName(const char* id)
 
 static std::map<int, const char*> bitrateMap;
 static std::string                channelSetup;
+static uint64_t                   sampleRate         = 0;
+static uint64_t                   registryGeneration = 0;
 
-static void HandleIntProperty(obs_property_t* prop, const char* id)
+static void HandleEncoderBitrates(const char* id)
 {
-	const int max_ = obs_property_int_max(prop);
-	const int step = obs_property_int_step(prop);
-
-	for (int i = obs_property_int_min(prop); i <= max_; i += step)
-		bitrateMap[i] = id;
-}
-
-static void HandleListProperty(obs_property_t* prop, const char* id)
-{
-	obs_combo_format format = obs_property_list_format(prop);
-	if (format != OBS_COMBO_FORMAT_INT) {
-		blog(
-		    LOG_ERROR,
-		    "Encoder '%s' (%s) returned bitrate "
-		    "OBS_PROPERTY_LIST property of unhandled "
-		    "format %d",
-		    EncoderName(id),
-		    id,
-		    static_cast<int>(format));
+	std::vector<int> bitrates;
+	if (!EncoderRegistry::GetInstance().bitrates(id, sampleRate, bitrates))
 		return;
-	}
-
-	const size_t count = obs_property_list_item_count(prop);
-	for (size_t i = 0; i < count; i++) {
-		if (obs_property_list_item_disabled(prop, i))
-			continue;
 
-		int bitrate         = static_cast<int>(obs_property_list_item_int(prop, i));
+	for (int bitrate : bitrates)
 		bitrateMap[bitrate] = id;
-	}
-}
-
-static void HandleSampleRate(obs_property_t* prop, const char* id)
-{
-	auto                                               ReleaseData = [](obs_data_t* data) { obs_data_release(data); };
-	std::unique_ptr<obs_data_t, decltype(ReleaseData)> data{obs_encoder_defaults(id), ReleaseData};
-
-	if (!data) {
-		blog(
-		    LOG_ERROR,
-		    "Failed to get defaults for encoder '%s' (%s) "
-		    "while populating bitrate map",
-		    EncoderName(id),
-		    id);
-		return;
-	}
-
-	uint64_t sampleRate = config_get_uint(ConfigManager::getInstance().getBasic(), "Audio",
-			"SampleRate");
-
-	obs_data_set_int(data.get(), "samplerate", sampleRate);
-
-	obs_property_modified(prop, data.get());
-}
-
-static void HandleEncoderProperties(const char* id)
-{
-	auto DestroyProperties = [](obs_properties_t* props) { obs_properties_destroy(props); };
-	std::unique_ptr<obs_properties_t, decltype(DestroyProperties)> props{obs_get_encoder_properties(id),
-	                                                                     DestroyProperties};
-
-	if (!props) {
-		blog(
-		    LOG_ERROR,
-		    "Failed to get properties for encoder "
-		    "'%s' (%s)",
-		    EncoderName(id),
-		    id);
-		return;
-	}
-
-	obs_property_t* samplerate = obs_properties_get(props.get(), "samplerate");
-	if (samplerate)
-		HandleSampleRate(samplerate, id);
-
-	obs_property_t* bitrate = obs_properties_get(props.get(), "bitrate");
-
-	obs_property_type type = obs_property_get_type(bitrate);
-	switch (type) {
-	case OBS_PROPERTY_INT:
-		return HandleIntProperty(bitrate, id);
-
-	case OBS_PROPERTY_LIST:
-		return HandleListProperty(bitrate, id);
-
-	default:
-		break;
-	}
-
-	blog(
-	    LOG_ERROR,
-	    "Encoder '%s' (%s) returned bitrate property "
-	    "of unhandled type %d",
-	    EncoderName(id),
-	    id,
-	    static_cast<int>(type));
 }
 
 static const char* GetCodec(const char* id)
@@ -182,37 +95,28 @@ void LimitBitrate(std::map<int, const char*>& values, int maximumBitrate)
 static const std::string aac_ = "AAC";
 static void              PopulateBitrateMap()
 {
-	// Get the current channel setup and check if it changed, if that is the case the bitrate map could need an update
+	// Get the current channel setup and sample rate and check if they changed, if that is the case the bitrate map could need an update
 	auto currentChannelSetup =
 	    std::string(std::string(config_get_string(ConfigManager::getInstance().getBasic(), "Audio", "ChannelSetup")));
-
-	if (currentChannelSetup != channelSetup) {
-		channelSetup = currentChannelSetup;
+	uint64_t currentSampleRate = config_get_uint(ConfigManager::getInstance().getBasic(), "Audio", "SampleRate");
+	uint64_t currentGeneration = EncoderRegistry::GetInstance().generation();
+
+	if (currentChannelSetup != channelSetup || currentSampleRate != sampleRate
+	    || currentGeneration != registryGeneration) {
+		channelSetup       = currentChannelSetup;
+		sampleRate         = currentSampleRate;
+		registryGeneration = currentGeneration;
 		bitrateMap.clear();
 
-		HandleEncoderProperties(fallbackEncoder.c_str());
+		HandleEncoderBitrates(fallbackEncoder.c_str());
 
-		const char* id = nullptr;
-		for (size_t i = 0; obs_enum_encoder_types(i, &id); i++) {
-			auto Compare = [=](const std::string& val) { return val == NullToEmpty(id); };
+		for (const char* id : EncoderRegistry::GetInstance().encodersForCodec(OBS_ENCODER_AUDIO, aac_.c_str())) {
+			auto Compare = [=](const std::string& val) { return val == id; };
 
 			if (find_if(begin(encoders), end(encoders), Compare) != end(encoders))
 				continue;
 
-			if (aac_ != GetCodec(NullToEmpty(id)))
-				continue;
-
-			// A corrupted encoder dll will fail when requesting it's properties here by
-			// calling "obs_get_encoder_properties", this try-catch block will make sure
-			// that this encoder won't be used. A good solution would be checking this
-			// when starting obs (checking if every encoder/module is valid) and/or
-			// showing the user why the encoder why disabled (invalid version, need to
-			// update, etc)
-			try {
-				HandleEncoderProperties(id);
-			} catch (...) {
-				continue;
-			}
+			HandleEncoderBitrates(id);
 		}
 
 		for (auto& encoder : encoders) {
@@ -222,7 +126,7 @@ static void              PopulateBitrateMap()
 			if (aac_ != GetCodec(encoder.c_str()))
 				continue;
 
-			HandleEncoderProperties(encoder.c_str());
+			HandleEncoderBitrates(encoder.c_str());
 		}
 
 		if (bitrateMap.empty()) {
@@ -21,6 +21,7 @@
 #include <future>
 #include "error.hpp"
 #include "shared.hpp"
+#include "encoder-registry.h"
 
 enum class Type
 {
@@ -273,20 +274,15 @@ void autoConfig::WaitPendingTests(double timeout)
 
 void autoConfig::TestHardwareEncoding(void)
 {
-	size_t      idx = 0;
-	const char* id;
-	while (obs_enum_encoder_types(idx++, &id)) {
-		if (id == nullptr)
-			continue;
-		if (strcmp(id, "jim_nvenc") == 0)
-			hardwareEncodingAvailable = nvencAvailable = true;
-		else if (strcmp(id, "obs_qsv11") == 0)
-			hardwareEncodingAvailable = qsvAvailable = true;
-		else if (strcmp(id, "amd_amf_h264") == 0)
-			hardwareEncodingAvailable = vceAvailable = true;
-		else if (strcmp(id, "vt_h264_hw") == 0)
-			hardwareEncodingAvailable = appleHWAvailable = true;
-	}
+	EncoderRegistry& registry = EncoderRegistry::GetInstance();
+	if (registry.available("jim_nvenc"))
+		hardwareEncodingAvailable = nvencAvailable = true;
+	if (registry.available("obs_qsv11"))
+		hardwareEncodingAvailable = qsvAvailable = true;
+	if (registry.available("amd_amf_h264"))
+		hardwareEncodingAvailable = vceAvailable = true;
+	if (registry.available("vt_h264_hw"))
+		hardwareEncodingAvailable = appleHWAvailable = true;
 }
 
 static inline void string_depad_key(std::string& key)
@@ -1574,7 +1570,7 @@ void autoConfig::SaveStreamSettings()
 			GetEncoderDisplayName(streamingEncoder));
 	config_remove_value(ConfigManager::getInstance().getBasic(), "SimpleOutput", "UseAdvanced");
 
-	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(ConfigManager::getInstance().getBasic());
 	
 	eventsMutex.lock();
 	events.push(AutoConfigInfo("stopping_step", "saving_service", 100));
@@ -1608,7 +1604,7 @@ void autoConfig::SaveSettings()
 			config_get_string(ConfigManager::getInstance().getBasic(), "Video", "FPSCommon");
 	}
 
-	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(ConfigManager::getInstance().getBasic());
 
 	eventsMutex.lock();
 	events.push(AutoConfigInfo("stopping_step", "saving_settings", 100));
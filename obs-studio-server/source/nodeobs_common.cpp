@@ -218,6 +218,25 @@ void OBS_content::Register(ipc::server& srv)
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
 	    OBS_content_setDrawGuideLines));
 
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_setDisplayRenderBudget",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::Int32},
+	    OBS_content_setDisplayRenderBudget));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_setDisplayPaused",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
+	    OBS_content_setDisplayPaused));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_markDisplayDirty", std::vector<ipc::type>{ipc::type::String}, OBS_content_markDisplayDirty));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_createSharedMemoryDisplay",
+	    std::vector<ipc::type>{
+	        ipc::type::String, ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::Int32},
+	    OBS_content_createSharedMemoryDisplay));
+
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_content_createIOSurface",
 	    std::vector<ipc::type>{ipc::type::String},
@@ -373,6 +392,13 @@ void OBS_content::OBS_content_resizeDisplay(
 
 	OBS::Display* display = value->second;
 
+	if (display->IsShared()) {
+		display->SetSize(args[1].value_union.ui32, args[2].value_union.ui32);
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		AUTO_DEBUG;
+		return;
+	}
+
 	display->m_gsInitData.cx = args[1].value_union.ui32;
 	display->m_gsInitData.cy = args[2].value_union.ui32;
 
@@ -383,6 +409,7 @@ void OBS_content::OBS_content_resizeDisplay(
 
     // Store new size.
     display->UpdatePreviewArea();
+    display->MarkDirty();
 
 #ifdef WIN32
 	display->SetSize(display->m_gsInitData.cx, display->m_gsInitData.cy);
@@ -633,6 +660,102 @@ void OBS_content::OBS_content_setDrawGuideLines(
 	AUTO_DEBUG;
 }
 
+void OBS_content::OBS_content_setDisplayRenderBudget(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+
+	it->second->SetRenderBudget(args[1].value_union.ui32, (bool)args[2].value_union.i32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_setDisplayPaused(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+
+	it->second->SetPaused((bool)args[1].value_union.i32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_markDisplayDirty(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+
+	it->second->MarkDirty();
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_createSharedMemoryDisplay(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto found = displays.find(args[0].value_str);
+	if (found != displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Duplicate key provided to createSharedMemoryDisplay: " + args[0].value_str));
+		return;
+	}
+
+	enum obs_video_rendering_mode mode = OBS_MAIN_VIDEO_RENDERING;
+	switch (args[4].value_union.i32) {
+	case 1:
+		mode = OBS_STREAMING_VIDEO_RENDERING;
+		break;
+	case 2:
+		mode = OBS_RECORDING_VIDEO_RENDERING;
+		break;
+	}
+
+	OBS::Display* display = nullptr;
+	try {
+		display = new OBS::Display(args[2].value_union.ui32, args[3].value_union.ui32, mode, args[1].value_str);
+	} catch (const std::exception& e) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value(std::string(e.what())));
+		return;
+	}
+	displays.insert_or_assign(args[0].value_str, display);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(display->GetSharedMemoryName()));
+	rval.push_back(ipc::value((uint64_t)display->GetSharedMemorySize()));
+	AUTO_DEBUG;
+}
+
 void OBS_content::OBS_content_createIOSurface(
     void*                          data,
     const int64_t                  id,
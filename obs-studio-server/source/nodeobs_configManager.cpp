@@ -23,9 +23,37 @@
 #include <windows.h>
 #endif
 
+#include <algorithm>
 #include <util/platform.h>
 #include "shared.hpp"
 
+// A config is written once it has been left alone for SAVE_DELAY, but never
+// later than SAVE_MAX_DELAY after its first pending change.
+static const std::chrono::milliseconds SAVE_DELAY(1000);
+static const std::chrono::milliseconds SAVE_MAX_DELAY(5000);
+
+// Set while the current thread may hold persist_mtx or save_mtx. The crash
+// handler runs on the crashing thread and must not touch mutexes it owns.
+static thread_local bool persisting = false;
+
+struct persisting_scope
+{
+	bool previous;
+	persisting_scope() : previous(persisting)
+	{
+		persisting = true;
+	}
+	~persisting_scope()
+	{
+		persisting = previous;
+	}
+};
+
+ConfigManager::~ConfigManager()
+{
+	stopPersistence();
+}
+
 void ConfigManager::setAppdataPath(std::string path)
 {
 	appdata = path;
@@ -64,7 +92,7 @@ void initGlobalDefault(config_t* config)
 	config_set_default_bool(config, "General", "BrowserHWAccel", true);
 	config_set_default_bool(config, "General", "fileCaching", true);
 
-	config_save_safe(config, "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(config);
 }
 
 static const double scaled_vals[] = {1.0, 1.25, (1.0 / 0.75), 1.5, (1.0 / 0.6), 1.75, 2.0, 2.25, 2.5, 2.75, 3.0, 0.0};
@@ -98,25 +126,25 @@ void initBasicDefault(config_t* config)
 		track          = 1ULL << (track - 1);
 		config_set_uint(config, "AdvOut", "RecTracks", track);
 		config_remove_value(config, "AdvOut", "RecTrackIndex");
-		config_save_safe(config, "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(config);
 	}
 	if (config_has_user_value(config, "AdvOut", "nameTrack3")) {
 		std::string trackName = config_get_string(config, "AdvOut", "nameTrack3");
 		config_set_string(config, "AdvOut", "Track3Name", trackName.c_str());
 		config_remove_value(config, "AdvOut", "nameTrack3");
-		config_save_safe(config, "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(config);
 	}
 	if (config_has_user_value(config, "AdvOut", "nameTrack4")) {
 		std::string trackName = config_get_string(config, "AdvOut", "nameTrack4");
 		config_set_string(config, "AdvOut", "Track4Name", trackName.c_str());
 		config_remove_value(config, "AdvOut", "nameTrack4");
-		config_save_safe(config, "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(config);
 	}
 	if (config_has_user_value(config, "AdvOut", "nameTrack5")) {
 		std::string trackName = config_get_string(config, "AdvOut", "nameTrack5");
 		config_set_string(config, "AdvOut", "Track5Name", trackName.c_str());
 		config_remove_value(config, "AdvOut", "nameTrack5");
-		config_save_safe(config, "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(config);
 	}
 
 	config_set_default_string(config, "Output", "Mode", "Simple");
@@ -136,6 +164,9 @@ void initBasicDefault(config_t* config)
 	config_set_default_bool(config, "SimpleOutput", "RecRB", true);
 	config_set_default_int(config, "SimpleOutput", "RecRBTime", 20);
 	config_set_default_int(config, "SimpleOutput", "RecRBSize", 512);
+	config_set_default_bool(config, "SimpleOutput", "RecRBDisk", false);
+	config_set_default_int(config, "SimpleOutput", "RecRBMemSize", 256);
+	config_set_default_int(config, "SimpleOutput", "RecRBDiskSize", 4096);
 	config_set_default_string(config, "SimpleOutput", "RecRBPrefix", "Replay");
 	config_set_default_bool(config, "SimpleOutput", "replayBufferUseStreamOutput", true);
 	config_set_default_string(config, "SimpleOutput", "Profile", "main");
@@ -173,6 +204,9 @@ void initBasicDefault(config_t* config)
 	config_set_default_bool(config, "AdvOut", "RecRB", true);
 	config_set_default_uint(config, "AdvOut", "RecRBTime", 20);
 	config_set_default_int(config, "AdvOut", "RecRBSize", 512);
+	config_set_default_bool(config, "AdvOut", "RecRBDisk", false);
+	config_set_default_int(config, "AdvOut", "RecRBMemSize", 256);
+	config_set_default_int(config, "AdvOut", "RecRBDiskSize", 4096);
 	config_set_default_bool(config, "AdvOut", "replayBufferUseStreamOutput", true);
 
 	config_set_default_uint(config, "Video", "BaseCX", cx);
@@ -182,7 +216,7 @@ void initBasicDefault(config_t* config)
 	if (!config_has_user_value(config, "Video", "BaseCX") || !config_has_user_value(config, "Video", "BaseCY")) {
 		config_set_uint(config, "Video", "BaseCX", cx);
 		config_set_uint(config, "Video", "BaseCY", cy);
-		config_save_safe(config, "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(config);
 	}
 
 	config_set_default_string(config, "Output", "FilenameFormatting", "%CCYY-%MM-%DD %hh-%mm-%ss");
@@ -220,7 +254,7 @@ void initBasicDefault(config_t* config)
 	if (!config_has_user_value(config, "Video", "OutputCX") || !config_has_user_value(config, "Video", "OutputCY")) {
 		config_set_uint(config, "Video", "OutputCX", scale_cx);
 		config_set_uint(config, "Video", "OutputCY", scale_cy);
-		config_save_safe(config, "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(config);
 	}
 
 	config_set_default_uint(config, "Video", "FPSType", 0);
@@ -239,16 +273,121 @@ void initBasicDefault(config_t* config)
 	
 	if (config_get_uint(config, "Audio", "SampleRate") == 0 ) {
 		config_set_uint(config, "Audio", "SampleRate", 44100);
-		config_save_safe(config, "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(config);
 	}
 	config_set_default_uint(config, "Audio", "SampleRate", 44100);
 	config_set_default_string(config, "Audio", "ChannelSetup", "Stereo");
 
-	config_save_safe(config, "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(config);
+}
+
+void ConfigManager::markDirty(config_t* config)
+{
+	if (!config)
+		return;
+
+	if (config == basic)
+		basic_changes++;
+
+	{
+		persisting_scope             scope;
+		std::unique_lock<std::mutex> lock(persist_mtx);
+		auto                         now = std::chrono::steady_clock::now();
+		if (dirty.empty())
+			first_change = now;
+		last_change = now;
+		dirty.insert(config);
+
+		if (!persist_stop) {
+			if (!persist_worker.joinable())
+				persist_worker = std::thread(&ConfigManager::persistenceWorker, this);
+			persist_cv.notify_one();
+			return;
+		}
+	}
+
+	// Persistence was stopped during shutdown, nothing will come back for it
+	flush();
+}
+
+uint64_t ConfigManager::getBasicChanges(void)
+{
+	return basic_changes;
+}
+
+void ConfigManager::persistenceWorker(void)
+{
+	persisting_scope             scope;
+	std::unique_lock<std::mutex> lock(persist_mtx);
+	while (!persist_stop) {
+		if (dirty.empty()) {
+			persist_cv.wait(lock);
+			continue;
+		}
+
+		auto deadline = std::min(last_change + SAVE_DELAY, first_change + SAVE_MAX_DELAY);
+		if (std::chrono::steady_clock::now() < deadline) {
+			persist_cv.wait_until(lock, deadline);
+			continue;
+		}
+
+		lock.unlock();
+		flush();
+		lock.lock();
+	}
+}
+
+void ConfigManager::flush(bool wait)
+{
+	// Locking a mutex the crashing thread already owns is undefined, give up instead
+	if (!wait && persisting)
+		return;
+
+	// save_mtx is held from taking the pending set until the last write so a
+	// caller returning from flush knows no save of its configs is in flight.
+	persisting_scope             scope;
+	std::unique_lock<std::mutex> save_lock(save_mtx, std::defer_lock);
+	std::unique_lock<std::mutex> lock(persist_mtx, std::defer_lock);
+	if (wait) {
+		save_lock.lock();
+		lock.lock();
+	} else if (!save_lock.try_lock() || !lock.try_lock()) {
+		// Another thread is saving
+		return;
+	}
+
+	std::set<config_t*> configs;
+	configs.swap(dirty);
+	lock.unlock();
+
+	// config_save_safe writes to a temporary file and renames it over the
+	// original, so an interrupted save never leaves a truncated ini behind
+	for (config_t* config : configs)
+		config_save_safe(config, "tmp", nullptr);
+}
+
+void ConfigManager::stopPersistence(void)
+{
+	{
+		persisting_scope             scope;
+		std::unique_lock<std::mutex> lock(persist_mtx);
+		persist_stop = true;
+	}
+	persist_cv.notify_one();
+
+	if (persist_worker.joinable())
+		persist_worker.join();
+
+	flush();
+	dropJsonFiles();
 }
 
 void ConfigManager::reloadConfig(void)
 {
+	flush();
+	dropJsonFiles();
+	basic_changes++;
+
 	if (basic) {
 		config_close(basic);
 		basic = nullptr;
@@ -313,3 +452,81 @@ std::string ConfigManager::getRecord()
 	return appdata + "/recordEncoder.json";
 #endif
 };
+
+static bool StatJsonFile(const std::string& path, int64_t& mtime, int64_t& size)
+{
+	struct stat info;
+	if (os_stat(path.c_str(), &info) != 0)
+		return false;
+
+	mtime = int64_t(info.st_mtime);
+	size  = int64_t(info.st_size);
+	return true;
+}
+
+// The caller keeps its settings after saving them, a round trip through JSON also copies nested objects and arrays
+static obs_data_t* CopyJsonData(obs_data_t* data)
+{
+	const char* json = obs_data_get_json(data);
+	return json ? obs_data_create_from_json(json) : obs_data_create();
+}
+
+void ConfigManager::dropJsonFiles(void)
+{
+	std::unique_lock<std::mutex> lock(json_mtx);
+	for (auto& file : json_files)
+		obs_data_release(file.second.data);
+	json_files.clear();
+}
+
+obs_data_t* ConfigManager::loadJson(const std::string& path)
+{
+	int64_t mtime = 0;
+	int64_t size  = 0;
+	bool    found = StatJsonFile(path, mtime, size);
+
+	std::unique_lock<std::mutex> lock(json_mtx);
+	auto                         cached = json_files.find(path);
+	if (cached != json_files.end()) {
+		if (found && cached->second.mtime == mtime && cached->second.size == size) {
+			obs_data_addref(cached->second.data);
+			return cached->second.data;
+		}
+
+		obs_data_release(cached->second.data);
+		json_files.erase(cached);
+	}
+
+	// The backup is still used when the file itself is missing or corrupted
+	obs_data_t* data = obs_data_create_from_json_file_safe(path.c_str(), "bak");
+	if (!data || !found)
+		return data;
+
+	json_file& file = json_files[path];
+	file.data       = data;
+	file.mtime      = mtime;
+	file.size       = size;
+	obs_data_addref(data);
+	return data;
+}
+
+bool ConfigManager::saveJson(obs_data_t* data, const std::string& path)
+{
+	std::unique_lock<std::mutex> lock(json_mtx);
+	auto                         cached = json_files.find(path);
+	if (cached != json_files.end()) {
+		obs_data_release(cached->second.data);
+		json_files.erase(cached);
+	}
+
+	if (!obs_data_save_json_safe(data, path.c_str(), "tmp", "bak"))
+		return false;
+
+	json_file file;
+	if (!StatJsonFile(path, file.mtime, file.size))
+		return true;
+
+	file.data        = CopyJsonData(data);
+	json_files[path] = file;
+	return true;
+}
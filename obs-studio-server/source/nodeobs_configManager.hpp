@@ -17,8 +17,15 @@
 ******************************************************************************/
 
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <obs.h>
+#include <set>
 #include <string>
+#include <thread>
 #include <util/config-file.h>
 
 class ConfigManager {
@@ -30,6 +37,7 @@ public:
 	}
 private:
 	ConfigManager() {};
+	~ConfigManager();
 public:
 	ConfigManager(ConfigManager const&) = delete;
 	void operator=(ConfigManager const&) = delete;
@@ -43,6 +51,32 @@ private:
 
 	config_t * getConfig(std::string name);
 
+	// Write-behind persistence: setters mark a config dirty and a worker saves
+	// it once changes have settled, instead of rewriting the ini on every call.
+	std::set<config_t*>                   dirty;
+	std::mutex                            persist_mtx;
+	std::mutex                            save_mtx;
+	std::condition_variable               persist_cv;
+	std::thread                           persist_worker;
+	bool                                  persist_stop = false;
+	std::chrono::steady_clock::time_point first_change;
+	std::chrono::steady_clock::time_point last_change;
+	std::atomic<uint64_t>                 basic_changes{0};
+
+	void persistenceWorker(void);
+
+	// Parsed JSON settings files, reparsed only when the file changed on disk
+	struct json_file
+	{
+		obs_data_t* data  = nullptr;
+		int64_t     mtime = 0;
+		int64_t     size  = 0;
+	};
+	std::map<std::string, json_file> json_files;
+	std::mutex                       json_mtx;
+
+	void dropJsonFiles(void);
+
 public:
 	void setAppdataPath(std::string path);
 	config_t* getGlobal();
@@ -51,4 +85,22 @@ public:
 	std::string getStream();
 	std::string getRecord();
 	void reloadConfig(void);
+
+	void markDirty(config_t* config);
+	// Bumped whenever basic.ini is marked dirty, lets callers cache state derived from it
+	uint64_t getBasicChanges(void);
+	// Writes every pending config now. With wait set to false it gives up
+	// when the calling thread is inside the persistence code or another thread
+	// is saving, instead of blocking (used from the crash handler).
+	void flush(bool wait = true);
+	void stopPersistence(void);
+
+	// Settings stored in a JSON file such as getStream() or getRecord(). The
+	// parsed content is cached and only read again when the modification
+	// time or size of the file changed. Returns a reference to the cached
+	// content that the caller releases and must not modify, nullptr if the
+	// file cannot be read.
+	obs_data_t* loadJson(const std::string& path);
+	// Writes the settings with a backup and refreshes the cached content
+	bool saveJson(obs_data_t* data, const std::string& path);
 };
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include <map>
 #include <string>
 #include "nodeobs_api.h"
+#include "source-profiler.h"
 
 #include <graphics/matrix4.h>
 #include <graphics/vec4.h>
@@ -32,6 +33,11 @@ extern std::string currentScene; /* defined in OBS_content.cpp */
 
 static const uint32_t grayPaddingArea = 10ul;
 
+// Displays that skip unchanged frames still redraw this often, for content we cannot observe.
+static const uint64_t unchangedKeepAliveNs = 1000000000ull;
+// How often the window state is queried to detect hidden or minimized displays.
+static const uint64_t occlusionTestIntervalNs = 250000000ull;
+
 static void RecalculateApectRatioConstrainedSize(
     uint32_t  origW,
     uint32_t  origH,
@@ -242,9 +248,6 @@ OBS::Display::Display()
 #elif defined(__linux__) || defined(__FreeBSD__)
 #endif
 
-#ifdef WIN32
-	worker = std::thread(std::bind(&OBS::Display::SystemWorker, this));
-#endif
 	m_gsInitData.adapter         = 0;
 	m_gsInitData.cx              = 960;
 	m_gsInitData.cy              = 540;
@@ -255,6 +258,10 @@ OBS::Display::Display()
 	m_source                     = nullptr;
 	m_position.first             = 0;
 	m_position.second            = 0;
+#ifdef _WIN32
+	m_ourWindow    = NULL;
+	m_parentWindow = NULL;
+#endif
 
 	obs_enter_graphics();
 	m_gsSolidEffect = obs_get_base_effect(OBS_EFFECT_SOLID);
@@ -305,7 +312,7 @@ OBS::Display::Display()
 	m_boxTris->Update();
 
 	// Text
-	m_textVertices = new GS::VertexBuffer(65535);
+	m_textVertices = new GS::VertexBuffer(65535, true);
 	m_textEffect   = obs_get_base_effect(OBS_EFFECT_DEFAULT);
 	m_textTexture  = gs_texture_create_from_file((g_moduleDirectory + "/resources/roboto.png").c_str());
 	if (!m_textTexture) {
@@ -325,6 +332,9 @@ OBS::Display::Display()
 OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode) : Display()
 {
 #ifdef _WIN32
+	// Only windowed displays need the window thread, shared memory displays never start it.
+	worker = std::thread(std::bind(&OBS::Display::SystemWorker, this));
+
 	CreateWindowMessageQuestion question;
 	CreateWindowMessageAnswer   answer;
 
@@ -364,6 +374,7 @@ OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode)
 	m_renderingMode = mode;
 
 	obs_display_add_draw_callback(m_display, DisplayCallback, this);
+	obs_add_tick_callback(DisplayTick, this);
 }
 
 OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode, std::string sourceName)
@@ -371,13 +382,40 @@ OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode,
 {
 	m_source = obs_get_source_by_name(sourceName.c_str());
 	obs_source_inc_showing(m_source);
+	ConnectSourceSignals(true);
+}
+
+OBS::Display::Display(uint32_t maxWidth, uint32_t maxHeight, enum obs_video_rendering_mode mode, std::string sourceName)
+    : Display()
+{
+	m_frameExport = std::make_unique<FrameExport>();
+	if (!m_frameExport->create(maxWidth, maxHeight))
+		throw std::runtime_error("unable to create shared memory for the display");
+
+	m_gsInitData.cx = std::min(m_gsInitData.cx, maxWidth);
+	m_gsInitData.cy = std::min(m_gsInitData.cy, maxHeight);
+	UpdatePreviewArea();
+
+	m_renderingMode = mode;
+	if (!sourceName.empty()) {
+		m_source = obs_get_source_by_name(sourceName.c_str());
+		obs_source_inc_showing(m_source);
+		ConnectSourceSignals(true);
+	}
+
+	// Without a window there is no obs_display, the tick renders the frames instead.
+	obs_add_tick_callback(DisplayTick, this);
 }
 
 OBS::Display::~Display()
 {
-	obs_display_remove_draw_callback(m_display, DisplayCallback, this);
+	obs_remove_tick_callback(DisplayTick, this);
+	if (m_display)
+		obs_display_remove_draw_callback(m_display, DisplayCallback, this);
+	m_frameExport = nullptr;
 
 	if (m_source) {
+		ConnectSourceSignals(false);
 		obs_source_dec_showing(m_source);
 		obs_source_release(m_source);
 	}
@@ -399,32 +437,35 @@ OBS::Display::~Display()
 	obs_leave_graphics();
 
 #ifdef _WIN32
-	DestroyWindowMessageQuestion question;
-	DestroyWindowMessageAnswer   answer;
-
-	question.window = m_ourWindow;
-	PostThreadMessage(
-	    GetThreadId(worker.native_handle()),
-	    (UINT)SystemWorkerMessage::DestroyWindow,
-	    reinterpret_cast<intptr_t>(&question),
-	    reinterpret_cast<intptr_t>(&answer));
-
-	if (!answer.try_wait()) {
-		while (!answer.wait()) {
-			if (answer.called)
-				break;
-			Sleep(0);
+	// Shared memory displays have no window.
+	if (m_ourWindow) {
+		DestroyWindowMessageQuestion question;
+		DestroyWindowMessageAnswer   answer;
+
+		question.window = m_ourWindow;
+		PostThreadMessage(
+		    GetThreadId(worker.native_handle()),
+		    (UINT)SystemWorkerMessage::DestroyWindow,
+		    reinterpret_cast<intptr_t>(&question),
+		    reinterpret_cast<intptr_t>(&answer));
+
+		if (!answer.try_wait()) {
+			while (!answer.wait()) {
+				if (answer.called)
+					break;
+				Sleep(0);
+			}
 		}
-	}
 
-	if (!answer.success) {
-		std::cerr << "OBS::Display::~Display: " << answer.errorMessage << std::endl;
+		if (!answer.success) {
+			std::cerr << "OBS::Display::~Display: " << answer.errorMessage << std::endl;
+		}
 	}
 
-	PostThreadMessage(GetThreadId(worker.native_handle()), (UINT)SystemWorkerMessage::StopThread, NULL, NULL);
-
-	if (worker.joinable())
+	if (worker.joinable()) {
+		PostThreadMessage(GetThreadId(worker.native_handle()), (UINT)SystemWorkerMessage::StopThread, NULL, NULL);
 		worker.join();
+	}
 #endif
 }
 
@@ -445,6 +486,7 @@ void OBS::Display::SetPosition(uint32_t x, uint32_t y)
 
 	SetWindowPos( m_ourWindow, NULL, m_position.first, m_position.second, m_gsInitData.cx, m_gsInitData.cy, SWP_NOCOPYBITS | SWP_NOSIZE | SWP_NOACTIVATE);
 #endif
+	MarkDirty();
 }
 
 std::pair<uint32_t, uint32_t> OBS::Display::GetPosition()
@@ -537,6 +579,15 @@ void OBS::Display::setSizeCall(int step)
 
 void OBS::Display::SetSize(uint32_t width, uint32_t height)
 {
+	if (m_frameExport) {
+		// Frames are rendered at this size, the shared memory bounds it.
+		m_gsInitData.cx = std::min(width, m_frameExport->maxWidth());
+		m_gsInitData.cy = std::min(height, m_frameExport->maxHeight());
+		UpdatePreviewArea();
+		MarkDirty();
+		return;
+	}
+
 #ifdef WIN32
 	if (m_source != NULL) {
        std::string msg = "<" + std::string(__FUNCTION__) + "> Adjusting display size for source %s to %ldx%ld. hwnd %d";
@@ -562,6 +613,7 @@ void OBS::Display::SetSize(uint32_t width, uint32_t height)
 	// Store new size.
 	UpdatePreviewArea();
 #endif
+	MarkDirty();
 }
 
 std::pair<uint32_t, uint32_t> OBS::Display::GetSize()
@@ -582,6 +634,7 @@ std::pair<uint32_t, uint32_t> OBS::Display::GetPreviewSize()
 void OBS::Display::SetDrawUI(bool v /*= true*/)
 {
 	m_shouldDrawUI = v;
+	MarkDirty();
 }
 
 bool OBS::Display::GetDrawUI()
@@ -595,37 +648,44 @@ void OBS::Display::SetPaddingColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*
 	m_paddingColor[1] = float_t(g) / 255.0f;
 	m_paddingColor[2] = float_t(b) / 255.0f;
 	m_paddingColor[3] = float_t(a) / 255.0f;
+	MarkDirty();
 }
 
 void OBS::Display::SetPaddingSize(uint32_t pixels)
 {
 	m_paddingSize = pixels;
 	UpdatePreviewArea();
+	MarkDirty();
 }
 
 void OBS::Display::SetBackgroundColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
 	m_backgroundColor = a << 24 | b << 16 | g << 8 | r;
+	MarkDirty();
 }
 
 void OBS::Display::SetOutlineColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
 	m_outlineColor = a << 24 | b << 16 | g << 8 | r;
+	MarkDirty();
 }
 
 void OBS::Display::SetGuidelineColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
 	m_guidelineColor = a << 24 | b << 16 | g << 8 | r;
+	MarkDirty();
 }
 
 void OBS::Display::SetResizeBoxOuterColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
 	m_resizeOuterColor = a << 24 | b << 16 | g << 8 | r;
+	MarkDirty();
 }
 
 void OBS::Display::SetResizeBoxInnerColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
 	m_resizeInnerColor = a << 24 | b << 16 | g << 8 | r;
+	MarkDirty();
 }
 
 static void
@@ -1074,11 +1134,20 @@ void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 
 	dp->UpdatePreviewArea();
 
+	// Schedule the next frame of the render budget, keeping the cadence unless we fell behind.
+	uint64_t now       = os_gettime_ns();
+	uint64_t nextFrame = dp->m_nextFrameTime + dp->m_frameInterval;
+	dp->m_nextFrameTime = nextFrame > now ? nextFrame : now + dp->m_frameInterval;
+	dp->m_lastFrameTime = now;
+	dp->m_dirty         = false;
+
 	// Get proper source/base size.
 	uint32_t sourceW, sourceH;
 	if (dp->m_source) {
 		sourceW = obs_source_get_width(dp->m_source);
 		sourceH = obs_source_get_height(dp->m_source);
+		dp->m_lastSourceW = sourceW;
+		dp->m_lastSourceH = sourceH;
 		if (sourceW == 0)
 			sourceW = 1;
 		if (sourceH == 0)
@@ -1139,6 +1208,8 @@ void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 	// Source Rendering
 	obs_source_t* source = NULL;
 	if (dp->m_source) {
+		uint64_t renderBegin = os_gettime_ns();
+
 		/* If the the source is a transition it means this display 
 		 * is for Studio Mode and that the scene it contains is a 
 		 * duplicate of the current scene, apply selective recording
@@ -1165,6 +1236,7 @@ void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 		} else {
 			obs_source_video_render(dp->m_source);
 		}
+		SourceProfiler::GetInstance().record(dp->m_source, os_gettime_ns() - renderBegin);
 		
 		/* If we want to draw guidelines, we need a scene,
 		 * not a transition. This may not be a scene which
@@ -1347,4 +1419,141 @@ bool OBS::Display::GetDrawGuideLines(void)
 void OBS::Display::SetDrawGuideLines(bool drawGuideLines)
 {
 	m_drawGuideLines = drawGuideLines;
+	MarkDirty();
+}
+
+void OBS::Display::SetRenderBudget(uint32_t targetFps, bool skipUnchanged)
+{
+	m_frameInterval = targetFps > 0 ? (1000000000ull / targetFps) : 0;
+	m_skipUnchanged = skipUnchanged;
+	MarkDirty();
+}
+
+void OBS::Display::SetPaused(bool paused)
+{
+	m_paused = paused;
+	MarkDirty();
+}
+
+bool OBS::Display::GetPaused()
+{
+	return m_paused;
+}
+
+void OBS::Display::MarkDirty()
+{
+	m_dirty = true;
+}
+
+bool OBS::Display::IsShared()
+{
+	return m_frameExport != nullptr;
+}
+
+const std::string& OBS::Display::GetSharedMemoryName()
+{
+	static const std::string none;
+	return m_frameExport ? m_frameExport->name() : none;
+}
+
+size_t OBS::Display::GetSharedMemorySize()
+{
+	return m_frameExport ? m_frameExport->size() : 0;
+}
+
+void OBS::Display::DisplayTick(void* displayPtr, float seconds)
+{
+	// Ticks run on the graphics thread right before the displays are drawn, so
+	// toggling the display here decides whether it renders this frame. A disabled
+	// display keeps presenting its last frame, unlike an empty draw callback.
+	Display* dp = static_cast<Display*>(displayPtr);
+	if (dp->m_frameExport) {
+		if (dp->ShouldRender(os_gettime_ns())) {
+			dp->m_frameExport->render(
+			    dp->m_gsInitData.cx, dp->m_gsInitData.cy, dp->m_backgroundColor, DisplayCallback, dp);
+		}
+		return;
+	}
+
+	if (!dp->m_display)
+		return;
+
+	bool render = dp->ShouldRender(os_gettime_ns());
+	if (obs_display_enabled(dp->m_display) != render)
+		obs_display_set_enabled(dp->m_display, render);
+
+	UNUSED_PARAMETER(seconds);
+}
+
+bool OBS::Display::ShouldRender(uint64_t now)
+{
+	if (m_paused)
+		return false;
+
+	if (IsOccluded(now))
+		return false;
+
+	if (m_frameInterval > 0) {
+		// Allow half a canvas frame of jitter, otherwise 30 FPS on a 60 FPS
+		// canvas would regularly slip to every third frame.
+		uint64_t slack = obs_get_frame_interval_ns() / 2;
+		if (now + slack < m_nextFrameTime)
+			return false;
+	}
+
+	if (m_skipUnchanged && m_source && !m_dirty
+	    && obs_source_get_type(m_source) != OBS_SOURCE_TYPE_TRANSITION) {
+		bool resized = (obs_source_get_width(m_source) != m_lastSourceW)
+		               || (obs_source_get_height(m_source) != m_lastSourceH);
+		if (!resized && (now - m_lastFrameTime) < unchangedKeepAliveNs)
+			return false;
+	}
+
+	return true;
+}
+
+bool OBS::Display::IsOccluded(uint64_t now)
+{
+#ifdef _WIN32
+	if (!m_ourWindow)
+		return false;
+
+	if ((now - m_lastOcclusionTest) >= occlusionTestIntervalNs) {
+		// Our window is a child of the client window, so this also catches a hidden parent.
+		HWND root           = GetAncestor(m_parentWindow, GA_ROOT);
+		m_occluded          = !IsWindowVisible(m_ourWindow) || (root && IsIconic(root));
+		m_lastOcclusionTest = now;
+	}
+	return m_occluded;
+#else
+	UNUSED_PARAMETER(now);
+	return false;
+#endif
+}
+
+void OBS::Display::SourceChanged(void* displayPtr, calldata_t* data)
+{
+	static_cast<Display*>(displayPtr)->MarkDirty();
+	UNUSED_PARAMETER(data);
+}
+
+void OBS::Display::ConnectSourceSignals(bool connect)
+{
+	if (!m_source)
+		return;
+
+	std::vector<const char*> signals = {"filter_add", "filter_remove", "reorder_filters"};
+	if (obs_scene_from_source(m_source)) {
+		signals.insert(
+		    signals.end(),
+		    {"item_add", "item_remove", "reorder", "refresh", "item_visible", "item_select", "item_transform"});
+	}
+
+	signal_handler_t* sh = obs_source_get_signal_handler(m_source);
+	for (const char* signal : signals) {
+		if (connect)
+			signal_handler_connect(sh, signal, SourceChanged, this);
+		else
+			signal_handler_disconnect(sh, signal, SourceChanged, this);
+	}
 }
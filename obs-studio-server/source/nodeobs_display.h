@@ -19,10 +19,12 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <system_error>
 #include <thread>
 #include <vector>
+#include "frame-export.h"
 #include "gs-vertexbuffer.h"
 #include "obs.h"
 #include "ipc-server.hpp"
@@ -63,6 +65,10 @@ namespace OBS
 		Display(uint64_t windowHandle,
 		    enum obs_video_rendering_mode mode,
 		    std::string                   sourceName); // Create a Source-Specific one
+		Display(uint32_t maxWidth,
+		    uint32_t                      maxHeight,
+		    enum obs_video_rendering_mode mode,
+		    std::string                   sourceName); // Render into shared memory, the source is optional
 		~Display();
 
 		void                          SetPosition(uint32_t x, uint32_t y);
@@ -88,8 +94,27 @@ namespace OBS
 		void SetDrawGuideLines(bool drawGuideLines);
 		void UpdatePreviewArea();
 
+		// Render budget
+		/// Limit the display to targetFps frames per second (0 = follow the canvas).
+		/// With skipUnchanged, source displays are only redrawn when something visible changed.
+		/// Displays in a minimized or hidden window stop rendering on Windows only.
+		void SetRenderBudget(uint32_t targetFps, bool skipUnchanged);
+		void SetPaused(bool paused);
+		bool GetPaused();
+		void MarkDirty();
+
+		// Shared memory frames, only for displays without a window
+		bool               IsShared();
+		const std::string& GetSharedMemoryName();
+		size_t             GetSharedMemorySize();
+
 		private:
 		static void DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy);
+		static void DisplayTick(void* displayPtr, float seconds);
+		static void SourceChanged(void* displayPtr, calldata_t* data);
+		bool        ShouldRender(uint64_t now);
+		bool        IsOccluded(uint64_t now);
+		void        ConnectSourceSignals(bool connect);
 		static bool DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item, void* param);
 		void        setSizeCall(int step);
 
@@ -132,6 +157,19 @@ namespace OBS
 
 		enum obs_video_rendering_mode m_renderingMode = OBS_MAIN_VIDEO_RENDERING;
 
+		// Render budget, evaluated on the graphics thread before displays are drawn.
+		std::atomic<uint64_t> m_frameInterval = 0; // ns, 0 = every canvas frame
+		std::atomic<bool>     m_skipUnchanged = false;
+		std::atomic<bool>     m_paused        = false;
+		std::atomic<bool>     m_dirty         = true;
+		uint64_t              m_nextFrameTime = 0;
+		uint64_t              m_lastFrameTime = 0;
+		uint32_t              m_lastSourceW = 0, m_lastSourceH = 0;
+		bool                  m_occluded          = false;
+		uint64_t              m_lastOcclusionTest = 0;
+
+		std::unique_ptr<FrameExport> m_frameExport;
+
 #if defined(_WIN32)
 		HWND              m_ourWindow;
 		HWND              m_parentWindow;
@@ -25,6 +25,11 @@
 #include "error.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
+#include "disk-replay-output.h"
+#include "encoder-planner.h"
+#include "encoder-registry.h"
+#include "performance-sampler.h"
+#include "source-registry.h"
 
 #ifdef __APPLE__
 #include <sys/types.h>
@@ -66,6 +71,31 @@ std::mutex             signalMutex;
 std::queue<SignalInfo> outputSignal;
 std::thread            releaseWorker;
 
+// Streaming outputs stopped with a stream delay keep sending until their buffer is
+// empty. Each one holds a reference here until its stop signal, or a timer set to
+// the remaining delay if that signal never comes, lets releaseWorker drop it.
+struct DrainingOutput
+{
+	obs_output_t*                         output;
+	std::chrono::steady_clock::time_point deadline;
+};
+std::mutex                  releaseMutex;
+std::condition_variable     releaseCv;
+std::vector<DrainingOutput> drainingOutputs;
+bool                        releaseWorkerStop = false;
+
+// With pre-warm enabled the recording output and its encoders are kept configured
+// between recordings and only rebuilt when basic.ini changed or an encoder they
+// use was replaced, so a start only has to pick the file name.
+bool                  recordingPrewarm             = false;
+bool                  recordingPrepared            = false;
+bool                  preparedSimpleMode           = false;
+bool                  preparedUseStreamEncoder     = false;
+bool                  preparedUsingRecordingPreset = false;
+bool                  preparedFfmpegOutput         = false;
+uint64_t              preparedConfigChanges        = 0;
+recording_start_stats recordingStartStats;
+
 static constexpr int kSoundtrackArchiveEncoderIdx = 1;
 static constexpr int kSoundtrackArchiveTrackIdx = 5;
 static obs_encoder_t *archiveEncoder = nullptr;
@@ -109,6 +139,10 @@ void OBS_service::Register(ipc::server& srv)
 	    "OBS_service_startVirtualWebcam", std::vector<ipc::type>{}, OBS_service_startVirtualWebcam));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_service_stopVirtualWebcan", std::vector<ipc::type>{}, OBS_service_stopVirtualWebcan));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_service_setRecordingPrewarm", std::vector<ipc::type>{ipc::type::Int32}, OBS_service_setRecordingPrewarm));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_service_getEncoderPlan", std::vector<ipc::type>{}, OBS_service_getEncoderPlan));
 
 	srv.register_collection(cls);
 }
@@ -162,6 +196,9 @@ void OBS_service::OBS_service_startStreaming(
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	}
 
+	// Starting the stream can replace the encoders a prepared recording shares
+	refreshRecordingPrewarm();
+
 	AUTO_DEBUG;
 }
 
@@ -236,6 +273,7 @@ void OBS_service::OBS_service_stopReplayBuffer(
 	stopReplayBuffer((bool)args[0].value_union.i32);
 	rpUsesRec    = false;
 	rpUsesStream = false;
+	refreshRecordingPrewarm();
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
@@ -244,6 +282,8 @@ bool OBS_service::resetAudioContext(bool reload)
 {
 	struct obs_audio_info ai;
 
+	recordingPrepared = false;
+
 	if (reload)
 		ConfigManager::getInstance().reloadConfig();
 
@@ -397,7 +437,7 @@ void GetFPSCommon(config_t* basicConfig, uint32_t& num, uint32_t& den)
 		den = 1;
 		config_set_uint(basicConfig, "Video", "FPSType", 0);
 		config_set_string(basicConfig, "Video", "FPSCommon", "30");
-		config_save_safe(basicConfig, "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(basicConfig);
 	}
 }
 
@@ -423,6 +463,8 @@ int OBS_service::resetVideoContext(bool reload)
 {
 	obs_video_info ovi;
 	std::string    gslib = "";
+
+	recordingPrepared = false;
 #ifdef _WIN32
 	gslib = "libobs-d3d11.dll";
 #else
@@ -500,7 +542,7 @@ int OBS_service::resetVideoContext(bool reload)
 
 	ovi.scale_type = GetScaleType(ConfigManager::getInstance().getBasic());
 
-	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(ConfigManager::getInstance().getBasic());
 	blog(LOG_INFO, "About to reset the video context");
 	try {
 		return obs_reset_video(&ovi);
@@ -512,19 +554,7 @@ int OBS_service::resetVideoContext(bool reload)
 
 const char* FindAudioEncoderFromCodec(const char* type)
 {
-	const char* alt_enc_id = nullptr;
-	size_t      i          = 0;
-
-	while (obs_enum_encoder_types(i++, &alt_enc_id)) {
-		if (alt_enc_id == nullptr)
-			continue;
-		const char* codec = obs_get_encoder_codec(alt_enc_id);
-		if (strcmp(type, codec) == 0) {
-			return alt_enc_id;
-		}
-	}
-
-	return nullptr;
+	return EncoderRegistry::GetInstance().findByCodec(type);
 }
 
 bool OBS_service::createAudioEncoder(
@@ -862,9 +892,20 @@ bool OBS_service::createRecordingOutput(void)
 	return true;
 }
 
+// Long replay windows keep their older packets in a file instead of memory
+static const char* ReplayBufferOutputType(bool isSimpleMode)
+{
+	bool diskBacked =
+	    config_get_bool(ConfigManager::getInstance().getBasic(), isSimpleMode ? "SimpleOutput" : "AdvOut", "RecRBDisk");
+	return diskBacked ? DISK_REPLAY_OUTPUT_ID : "replay_buffer";
+}
+
 void OBS_service::createReplayBufferOutput(void)
 {
-	replayBufferOutput = obs_output_create("replay_buffer", "ReplayBuffer", nullptr, nullptr);
+	const char* currentOutputMode = config_get_string(ConfigManager::getInstance().getBasic(), "Output", "Mode");
+	bool        isSimpleMode      = !currentOutputMode || strcmp(currentOutputMode, "Simple") == 0;
+
+	replayBufferOutput = obs_output_create(ReplayBufferOutputType(isSimpleMode), "ReplayBuffer", nullptr, nullptr);
 	connectOutputSignals();
 }
 
@@ -897,6 +938,34 @@ void OBS_service::updateStreamingEncoders(bool isSimpleMode)
 	}
 }
 
+// Dynamic bitrate lowers the bitrate of the stream encoder at runtime, which must not leak into files
+static bool streamEncodersShareable(void)
+{
+	return !config_get_bool(ConfigManager::getInstance().getBasic(), "Output", "DynamicBitrate");
+}
+
+// Encoders feeding a file output, replaced by the ones of the stream or of the running recording when
+// those already produce the same stream
+static obs_encoder_t* fileVideoEncoder(bool useStreamEncoder)
+{
+	if (useStreamEncoder)
+		return videoStreamingEncoder;
+	if (!streamEncodersShareable())
+		return videoRecordingEncoder;
+	obs_encoder_t* recording = recordingOutput ? obs_output_get_video_encoder(recordingOutput) : nullptr;
+	return EncoderPlanner::share(videoRecordingEncoder, {videoStreamingEncoder, recording});
+}
+
+static obs_encoder_t* fileSimpleAudioEncoder(bool useStreamEncoder)
+{
+	if (useStreamEncoder)
+		return audioSimpleStreamingEncoder;
+	if (!streamEncodersShareable())
+		return audioSimpleRecordingEncoder;
+	obs_encoder_t* recording = recordingOutput ? obs_output_get_audio_encoder(recordingOutput, 0) : nullptr;
+	return EncoderPlanner::share(audioSimpleRecordingEncoder, {audioSimpleStreamingEncoder, recording});
+}
+
 bool OBS_service::startStreaming(void)
 {
 	const char* type = obs_service_get_output_type(service);
@@ -919,10 +988,18 @@ bool OBS_service::startStreaming(void)
 	updateService();
 	updateStreamingOutput();
 
-	obs_output_set_video_encoder(streamingOutput, videoStreamingEncoder);
+	// A recording or replay buffer started first may already encode the same stream
+	bool shareable = streamEncodersShareable();
+	obs_output_set_video_encoder(
+	    streamingOutput,
+	    shareable ? EncoderPlanner::share(videoStreamingEncoder, {videoRecordingEncoder}) : videoStreamingEncoder);
 
 	if (isSimpleMode)
-		obs_output_set_audio_encoder(streamingOutput, audioSimpleStreamingEncoder, 0);
+		obs_output_set_audio_encoder(
+		    streamingOutput,
+		    shareable ? EncoderPlanner::share(audioSimpleStreamingEncoder, {audioSimpleRecordingEncoder})
+		              : audioSimpleStreamingEncoder,
+		    0);
 	else
 		obs_output_set_audio_encoder(
 		    streamingOutput,
@@ -1109,8 +1186,10 @@ bool OBS_service::updateRecordingEncoders(bool isSimpleMode)
 	return useStreamEncoder;
 }
 
-bool OBS_service::startRecording(void)
+bool OBS_service::prepareRecording(void)
 {
+	recordingPrepared = false;
+
 	if (recordingOutput)
 		obs_output_release(recordingOutput);
 
@@ -1138,14 +1217,10 @@ bool OBS_service::startRecording(void)
 			useStreamEncoder = updateRecordingEncoders(isSimpleMode);
 		}
 	}
-	updateFfmpegOutput(isSimpleMode, recordingOutput);
 
-	obs_output_set_video_encoder(recordingOutput, useStreamEncoder ? videoStreamingEncoder : videoRecordingEncoder);
+	obs_output_set_video_encoder(recordingOutput, fileVideoEncoder(useStreamEncoder));
 	if (isSimpleMode) {
-		obs_output_set_audio_encoder(recordingOutput,
-			                         useStreamEncoder
-			                         ? audioSimpleStreamingEncoder
-			                         : audioSimpleRecordingEncoder, 0);
+		obs_output_set_audio_encoder(recordingOutput, fileSimpleAudioEncoder(useStreamEncoder), 0);
 	} else {
 		int tracks = int(config_get_int(ConfigManager::getInstance().getBasic(), "AdvOut", "RecTracks"));
 		int idx    = 0;
@@ -1157,6 +1232,70 @@ bool OBS_service::startRecording(void)
 		}
 	}
 
+	preparedSimpleMode           = isSimpleMode;
+	preparedUseStreamEncoder     = useStreamEncoder;
+	preparedUsingRecordingPreset = usingRecordingPreset;
+	preparedFfmpegOutput         = ffmpegOutput;
+	preparedConfigChanges        = ConfigManager::getInstance().getBasicChanges();
+	recordingPrepared            = true;
+	return true;
+}
+
+bool OBS_service::isRecordingPrepared(void)
+{
+	if (!recordingPrepared || !recordingOutput || obs_output_active(recordingOutput))
+		return false;
+
+	if (preparedConfigChanges != ConfigManager::getInstance().getBasicChanges())
+		return false;
+
+	if (preparedFfmpegOutput != ffmpegOutput)
+		return false;
+
+	// The lossless preset is a ffmpeg_output with its own encoders
+	if (preparedFfmpegOutput)
+		return true;
+
+	// Starting the stream or the replay buffer may have recreated or started sharing the encoders
+	if (obs_output_get_video_encoder(recordingOutput) != fileVideoEncoder(preparedUseStreamEncoder))
+		return false;
+
+	if (preparedSimpleMode)
+		return obs_output_get_audio_encoder(recordingOutput, 0) == fileSimpleAudioEncoder(preparedUseStreamEncoder);
+
+	int tracks = int(config_get_int(ConfigManager::getInstance().getBasic(), "AdvOut", "RecTracks"));
+	int idx    = 0;
+	for (int i = 0; i < MAX_AUDIO_MIXES; i++) {
+		if ((tracks & (1 << i)) != 0) {
+			if (obs_output_get_audio_encoder(recordingOutput, idx) != aacTracks[i])
+				return false;
+			idx++;
+		}
+	}
+	return true;
+}
+
+void OBS_service::refreshRecordingPrewarm(void)
+{
+	if (!recordingPrewarm || isRecording || isRecordingPrepared())
+		return;
+
+	if (!prepareRecording())
+		blog(LOG_WARNING, "Failed to prepare the recording output");
+}
+
+bool OBS_service::startRecording(void)
+{
+	auto begin = std::chrono::steady_clock::now();
+
+	bool warm = recordingPrewarm && isRecordingPrepared();
+	if (warm)
+		usingRecordingPreset = preparedUsingRecordingPreset;
+	else if (!prepareRecording())
+		return false;
+
+	updateFfmpegOutput(preparedSimpleMode, recordingOutput);
+
 	isRecording = obs_output_start(recordingOutput);
 	if (!isRecording) {
 		SignalInfo signal = SignalInfo("recording", "stop");
@@ -1174,7 +1313,20 @@ bool OBS_service::startRecording(void)
 		}
 		std::unique_lock<std::mutex> ulock(signalMutex);
 		outputSignal.push(signal);
+		return isRecording;
 	}
+
+	double elapsed_ms =
+	    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+	recordingStartStats.starts++;
+	if (warm)
+		recordingStartStats.warm_starts++;
+	recordingStartStats.last_ms = elapsed_ms;
+	recordingStartStats.max_ms  = std::max(recordingStartStats.max_ms, elapsed_ms);
+	recordingStartStats.average_ms +=
+	    (elapsed_ms - recordingStartStats.average_ms) / double(recordingStartStats.starts);
+
 	return isRecording;
 }
 
@@ -1186,15 +1338,13 @@ void OBS_service::stopStreaming(bool forceStop)
 		return;
 	}
 
+	drainStreamingOutput(streamingOutput);
+
 	if (forceStop)
 		obs_output_force_stop(streamingOutput);
 	else
 		obs_output_stop(streamingOutput);
 
-	waitReleaseWorker();
-
-	releaseWorker = std::thread(releaseStreamingOutput);
-
 	stopTwitchSoundtrackAudio();
 
 	isStreaming = false;
@@ -1264,20 +1414,25 @@ void OBS_service::updateReplayBufferOutput(bool isSimpleMode, bool useStreamEnco
 	obs_data_set_int(settings, "max_time_sec", rbTime);
 	obs_data_set_int(settings, "max_size_mb", usingRecordingPreset ? rbSize : 0);
 
+	// Budgets of the disk backed replay buffer, ignored by the in-memory one
+	const char* section = isSimpleMode ? "SimpleOutput" : "AdvOut";
+	int64_t     memSize = config_get_int(ConfigManager::getInstance().getBasic(), section, "RecRBMemSize");
+	int64_t     diskSize = config_get_int(ConfigManager::getInstance().getBasic(), section, "RecRBDiskSize");
+	obs_data_set_int(settings, "memory_mb", memSize);
+	obs_data_set_int(settings, "disk_mb", diskSize);
+
 	if (!isSimpleMode) {
 		bool        usesBitrate = false;
-		obs_data_t* streamEncSettings =
-		    obs_data_create_from_json_file_safe(ConfigManager::getInstance().getStream().c_str(), "bak");
-		obs_data_t* recordEncSettings =
-		    obs_data_create_from_json_file_safe(ConfigManager::getInstance().getRecord().c_str(), "bak");
+		obs_data_t* encSettings = ConfigManager::getInstance().loadJson(
+		    useStreamEncoder ? ConfigManager::getInstance().getStream() : ConfigManager::getInstance().getRecord());
 
-		const char* rate_control =
-		    obs_data_get_string(useStreamEncoder ? streamEncSettings : recordEncSettings, "rate_control");
+		const char* rate_control = obs_data_get_string(encSettings, "rate_control");
 		if (!rate_control)
 			rate_control = "";
 		usesBitrate = astrcmpi(rate_control, "CBR") == 0 || astrcmpi(rate_control, "VBR") == 0
 		              || astrcmpi(rate_control, "ABR") == 0;
 		obs_data_set_int(settings, "max_size_mb", usesBitrate ? 0 : rbSize);
+		obs_data_release(encSettings);
 	}
 
 	obs_output_update(replayBufferOutput, settings);
@@ -1289,16 +1444,16 @@ bool OBS_service::startReplayBuffer(void)
 	if (replayBufferOutput)
 		obs_output_release(replayBufferOutput);
 
-	replayBufferOutput = obs_output_create("replay_buffer", "ReplayBuffer", nullptr, nullptr);
+	std::string     currentOutputMode = config_get_string(ConfigManager::getInstance().getBasic(), "Output", "Mode");
+	bool            isSimpleMode      = currentOutputMode.compare("Simple") == 0;
+	bool useStreamEncoder = false;
+
+	replayBufferOutput = obs_output_create(ReplayBufferOutputType(isSimpleMode), "ReplayBuffer", nullptr, nullptr);
 	if (!replayBufferOutput)
 		return false;
 
 	connectOutputSignals();
 
-	std::string     currentOutputMode = config_get_string(ConfigManager::getInstance().getBasic(), "Output", "Mode");
-	bool            isSimpleMode      = currentOutputMode.compare("Simple") == 0;
-	bool useStreamEncoder = false;
-
 	if (obs_get_multiple_rendering()
 	    && obs_get_replay_buffer_rendering_mode() == OBS_STREAMING_REPLAY_BUFFER_RENDERING) {
 		updateStreamingEncoders(isSimpleMode);
@@ -1315,13 +1470,9 @@ bool OBS_service::startReplayBuffer(void)
 	updateFfmpegOutput(isSimpleMode, replayBufferOutput);
 	updateReplayBufferOutput(isSimpleMode, useStreamEncoder);
 
-	obs_output_set_video_encoder(replayBufferOutput, useStreamEncoder ? videoStreamingEncoder : videoRecordingEncoder);
+	obs_output_set_video_encoder(replayBufferOutput, fileVideoEncoder(useStreamEncoder));
 	if (isSimpleMode) {
-		obs_output_set_audio_encoder(replayBufferOutput,
-			                         useStreamEncoder
-			                         ? audioSimpleStreamingEncoder
-			                         : audioSimpleRecordingEncoder,
-									 0);
+		obs_output_set_audio_encoder(replayBufferOutput, fileSimpleAudioEncoder(useStreamEncoder), 0);
 	} else {
 		int tracks = int(config_get_int(ConfigManager::getInstance().getBasic(), "AdvOut", "RecTracks"));
 		int idx    = 0;
@@ -1443,17 +1594,7 @@ int OBS_service::GetAdvancedAudioBitrate(int i)
 
 bool OBS_service::EncoderAvailable(const char* encoder)
 {
-	const char* val;
-	int         i = 0;
-
-	while (obs_enum_encoder_types(i++, &val)) {
-		if (val == nullptr)
-			continue;
-		if (strcmp(val, encoder) == 0)
-			return true;
-	}
-
-	return false;
+	return EncoderRegistry::GetInstance().available(encoder);
 }
 
 void OBS_service::updateVideoStreamingEncoder(bool isSimpleMode)
@@ -1512,7 +1653,7 @@ void OBS_service::updateVideoStreamingEncoder(bool isSimpleMode)
 		if (videoBitrate == 0) {
 			videoBitrate = 2500;
 			config_set_uint(ConfigManager::getInstance().getBasic(), "SimpleOutput", "VBitrate", videoBitrate);
-			config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+			ConfigManager::getInstance().markDirty(ConfigManager::getInstance().getBasic());
 		}
 
 		obs_data_set_string(h264Settings, "rate_control", "CBR");
@@ -2192,6 +2333,11 @@ void OBS_service::JSCallbackOutputSignal(void* data, calldata_t* params)
 
 	std::string signalReceived = signal.getSignal();
 
+	// A delayed stream still draining after a new one was started finishes
+	// silently, the client only knows about the current streaming output
+	if (signal.getOutputType().compare("streaming") == 0 && calldata_ptr(params, "output") != streamingOutput)
+		return;
+
 	if (signalReceived.compare("stop") == 0) {
 		signal.setCode((int)calldata_int(params, "code"));
 
@@ -2224,6 +2370,7 @@ void OBS_service::connectOutputSignals(void)
 {
 	if (streamingOutput) {
 		signal_handler* streamingOutputSignalHandler = obs_output_get_signal_handler(streamingOutput);
+		PerformanceSampler::GetInstance().connectOutput(streamingOutput, SAMPLER_STREAMING);
 
 		// Connect streaming output
 		for (int i = 0; i < streamingSignals.size(); i++) {
@@ -2237,6 +2384,7 @@ void OBS_service::connectOutputSignals(void)
 
 	if (recordingOutput) {
 		signal_handler* recordingOutputSignalHandler = obs_output_get_signal_handler(recordingOutput);
+		PerformanceSampler::GetInstance().connectOutput(recordingOutput, SAMPLER_RECORDING);
 
 		// Connect recording output
 		for (int i = 0; i < recordingSignals.size(); i++) {
@@ -2250,6 +2398,7 @@ void OBS_service::connectOutputSignals(void)
 
 	if (replayBufferOutput) {
 		signal_handler* replayBufferOutputSignalHandler = obs_output_get_signal_handler(replayBufferOutput);
+		PerformanceSampler::GetInstance().connectOutput(replayBufferOutput, SAMPLER_REPLAY_BUFFER);
 
 		// Connect replay buffer output
 		for (int i = 0; i < replayBufferSignals.size(); i++) {
@@ -2337,24 +2486,111 @@ void OBS_service::duplicate_encoder(obs_encoder_t** dst, obs_encoder_t* src, uin
 	}
 }
 
-void OBS_service::releaseStreamingOutput()
+void OBS_service::drainStreamingOutput(obs_output_t* output)
+{
+	std::unique_lock<std::mutex> lock(releaseMutex);
+
+	auto it = std::find_if(drainingOutputs.begin(), drainingOutputs.end(), [output](const DrainingOutput& draining) {
+		return draining.output == output;
+	});
+	// Stopping again while draining, e.g. a force stop to cancel the delay
+	if (it != drainingOutputs.end())
+		return;
+
+	// The stop signal can fire on the output's own thread before obs_output_stop
+	// returns, so the handler must be connected first
+	signal_handler_connect(obs_output_get_signal_handler(output), "stop", onDrainingOutputStop, nullptr);
+
+	auto delay = std::chrono::seconds(obs_output_get_active_delay(output));
+	drainingOutputs.push_back({obs_output_get_ref(output), std::chrono::steady_clock::now() + delay});
+
+	if (!releaseWorker.joinable())
+		releaseWorker = std::thread(releaseWorkerLoop);
+	releaseCv.notify_one();
+}
+
+void OBS_service::onDrainingOutputStop(void* data, calldata_t* params)
+{
+	obs_output_t* output = (obs_output_t*)calldata_ptr(params, "output");
+
+	std::unique_lock<std::mutex> lock(releaseMutex);
+	for (auto& draining : drainingOutputs) {
+		if (draining.output == output)
+			draining.deadline = std::chrono::steady_clock::now();
+	}
+	releaseCv.notify_one();
+}
+
+void OBS_service::releaseWorkerLoop(void)
 {
-	if (config_get_bool(ConfigManager::getInstance().getBasic(), "Output", "DelayEnable")) {
-		uint32_t delay = obs_output_get_active_delay(streamingOutput);
-		while (delay != 0) {
-			delay = obs_output_get_active_delay(streamingOutput);
+	std::unique_lock<std::mutex> lock(releaseMutex);
+	while (!releaseWorkerStop || !drainingOutputs.empty()) {
+		auto                       now = std::chrono::steady_clock::now();
+		auto                       next = std::chrono::steady_clock::time_point::max();
+		std::vector<obs_output_t*> drained;
+
+		for (auto it = drainingOutputs.begin(); it != drainingOutputs.end();) {
+			if (it->deadline > now && !releaseWorkerStop) {
+				next = std::min(next, it->deadline);
+				++it;
+			} else if (obs_output_active(it->output) && !releaseWorkerStop) {
+				// Timer ran out before the stop signal, check again once the
+				// delay that is still buffered could have been sent
+				uint32_t delay = std::max(obs_output_get_active_delay(it->output), uint32_t(1));
+				it->deadline   = now + std::chrono::seconds(delay);
+				next           = std::min(next, it->deadline);
+				++it;
+			} else {
+				drained.push_back(it->output);
+				it = drainingOutputs.erase(it);
+			}
 		}
+
+		if (!drained.empty()) {
+			// Releasing the last reference destroys the output, which must not
+			// happen while holding the lock its stop signal handler takes
+			lock.unlock();
+			for (obs_output_t* output : drained) {
+				signal_handler_disconnect(
+				    obs_output_get_signal_handler(output), "stop", onDrainingOutputStop, nullptr);
+				obs_output_release(output);
+			}
+			lock.lock();
+			continue;
+		}
+
+		if (next == std::chrono::steady_clock::time_point::max())
+			releaseCv.wait(lock);
+		else
+			releaseCv.wait_until(lock, next);
 	}
-	
-	obs_output_release(streamingOutput);
-	streamingOutput = nullptr;
 }
 
 void OBS_service::waitReleaseWorker()
 {
+	std::vector<obs_output_t*> outputs;
+	{
+		std::unique_lock<std::mutex> lock(releaseMutex);
+		for (auto& draining : drainingOutputs)
+			outputs.push_back(draining.output);
+	}
+
+	// Nothing is left to send the delayed data to on shutdown
+	for (obs_output_t* output : outputs) {
+		if (obs_output_active(output))
+			obs_output_force_stop(output);
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(releaseMutex);
+		releaseWorkerStop = true;
+	}
+	releaseCv.notify_one();
+
 	if (releaseWorker.joinable()) {
 		releaseWorker.join();
 	}
+	releaseWorkerStop = false;
 }
 
 void OBS_service::OBS_service_createVirtualWebcam(
@@ -2421,6 +2657,62 @@ void OBS_service::OBS_service_stopVirtualWebcan(
 	
 	obs_output_stop(virtualWebcamOutput);
 }
+void OBS_service::OBS_service_setRecordingPrewarm(
+	void*                          data,
+	const int64_t                  id,
+	const std::vector<ipc::value>& args,
+	std::vector<ipc::value>&       rval)
+{
+	recordingPrewarm = (bool)args[0].value_union.i32;
+	if (recordingPrewarm)
+		refreshRecordingPrewarm();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+static void PushEncoderPlan(std::vector<ipc::value>& rval, const char* name, obs_output_t* output)
+{
+	std::vector<obs_encoder_t*> encoders;
+	if (output) {
+		if (obs_output_get_video_encoder(output))
+			encoders.push_back(obs_output_get_video_encoder(output));
+		for (size_t i = 0; i < MAX_AUDIO_MIXES; i++) {
+			if (obs_output_get_audio_encoder(output, i))
+				encoders.push_back(obs_output_get_audio_encoder(output, i));
+		}
+	}
+
+	rval.push_back(ipc::value(name));
+	rval.push_back(ipc::value((uint32_t)(output && obs_output_active(output))));
+	rval.push_back(ipc::value((uint32_t)encoders.size()));
+	for (obs_encoder_t* encoder : encoders) {
+		const char* encoderName = obs_encoder_get_name(encoder);
+		rval.push_back(ipc::value(obs_encoder_get_type(encoder) == OBS_ENCODER_VIDEO ? "video" : "audio"));
+		rval.push_back(ipc::value(encoderName ? encoderName : ""));
+		rval.push_back(ipc::value(EncoderPlanner::digest(encoder)));
+	}
+}
+
+void OBS_service::OBS_service_getEncoderPlan(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)3));
+	PushEncoderPlan(rval, "streaming", streamingOutput);
+	PushEncoderPlan(rval, "recording", recordingOutput);
+	PushEncoderPlan(rval, "replay-buffer", replayBufferOutput);
+	AUTO_DEBUG;
+}
+
+recording_start_stats OBS_service::getRecordingStartStats(void)
+{
+	return recordingStartStats;
+}
+
 void OBS_service::stopAllOutputs()
 {
 	if (streamingOutput && obs_output_active(streamingOutput))
@@ -2450,8 +2742,6 @@ uint32_t oldMixer_desktopSource1 = 0;
 uint32_t oldMixer_desktopSource2 = 0;
 
 void OBS_service::startTwitchSoundtrackAudio(void) {
-	bool sourceExists = false;
-
 	if (!service)
 		return;
 
@@ -2462,18 +2752,7 @@ void OBS_service::startTwitchSoundtrackAudio(void) {
 	if (serviceName && strcmp(serviceName, "Twitch") != 0)
 		return;
 
-	obs_enum_sources(
-		[](void *param, obs_source_t *source) {
-			auto id = obs_source_get_id(source);
-			if(strcmp(id, "soundtrack_source") == 0) {
-				*reinterpret_cast<bool *>(param) = true;
-				return false;
-			}
-			return true;
-		},
-		&sourceExists);
-
-	if (!sourceExists)
+	if (!SourceRegistry::GetInstance().hasType("soundtrack_source"))
 		return;
 
 	// These are magic ints provided by OBS for default sources:
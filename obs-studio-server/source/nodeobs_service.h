@@ -19,6 +19,8 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
 #include <ipc-server.hpp>
 #include <map>
@@ -66,6 +68,9 @@
 
 #define MAX_AUDIO_MIXES 6
 
+// Formats a file name from a filename formatting string, throws if the result is invalid
+std::string GenerateSpecifiedFilename(const char* extension, bool noSpace, const char* format);
+
 class SignalInfo
 {
 	private:
@@ -110,6 +115,15 @@ class SignalInfo
 	};
 };
 
+struct recording_start_stats
+{
+	uint64_t starts      = 0;
+	uint64_t warm_starts = 0;
+	double   last_ms     = 0.0;
+	double   average_ms  = 0.0;
+	double   max_ms      = 0.0;
+};
+
 class OBS_service
 {
 	public:
@@ -195,16 +209,30 @@ class OBS_service
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
+	static void OBS_service_setRecordingPrewarm(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void OBS_service_getEncoderPlan(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
 
 	private:
 	static bool startStreaming(void);
 	static void stopStreaming(bool forceStop);
 	static bool startRecording(void);
+	static bool prepareRecording(void);
+	static bool isRecordingPrepared(void);
 	static bool startReplayBuffer(void);
 	static void stopReplayBuffer(bool forceStop);
 	static void stopRecording(void);
 
-	static void releaseStreamingOutput(void);
+	static void drainStreamingOutput(obs_output_t* output);
+	static void onDrainingOutputStop(void* data, calldata_t* params);
+	static void releaseWorkerLoop(void);
 
 	static void LoadRecordingPreset_h264(const char* encoder);
 	static void LoadRecordingPreset_Lossless(void);
@@ -295,6 +323,10 @@ class OBS_service
 
 	static bool useRecordingPreset();
 
+	// Recording pre-warm
+	static void                  refreshRecordingPrewarm(void);
+	static recording_start_stats getRecordingStartStats(void);
+
 	static void duplicate_encoder(obs_encoder_t** dst, obs_encoder_t* src, uint64_t trackIndex = 0);
 
 	static bool EncoderAvailable(const char* encoder);
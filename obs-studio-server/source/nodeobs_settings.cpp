@@ -21,6 +21,7 @@
 #include "nodeobs_api.h"
 #include "shared.hpp"
 #include "memory-manager.h"
+#include "encoder-registry.h"
 
 #ifdef WIN32
 #include <windows.h>
@@ -250,6 +251,7 @@ void OBS_settings::OBS_settings_saveSettings(
 	if (saveSettings(nameCategory, settings))
 	{
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		OBS_service::refreshRecordingPrewarm();
 	} else {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
 		rval.push_back(ipc::value("Failed to save settings"));
@@ -593,6 +595,9 @@ void OBS_settings::saveGeneralSettings(std::vector<SubCategory> generalSettings,
 	config_t* config;
 	pathConfigDirectory += "global.ini";
 
+	// global.ini is edited on disk here, write out pending changes first
+	ConfigManager::getInstance().flush();
+
 	int result = config_open(&config, pathConfigDirectory.c_str(), CONFIG_OPEN_EXISTING);
 
 	if (result != CONFIG_SUCCESS) {
@@ -1056,17 +1061,7 @@ bool OBS_settings::saveStreamSettings(std::vector<SubCategory> streamSettings)
 
 static bool EncoderAvailable(const char* encoder)
 {
-	const char* val;
-	int         i = 0;
-
-	while (obs_enum_encoder_types(i++, &val)) {
-		if (val == nullptr)
-			continue;
-		if (strcmp(val, encoder) == 0)
-			return true;
-	}
-
-	return false;
+	return EncoderRegistry::GetInstance().available(encoder);
 }
 
 void OBS_settings::getSimpleAvailableEncoders(std::vector<std::pair<std::string, ipc::value>>* encoders, bool recording)
@@ -1805,7 +1800,7 @@ SubCategory OBS_settings::getAdvancedOutputStreamingSettings(config_t* config, b
 		if (outputResString == NULL) {
 			outputResString = "1280x720";
 			config_set_string(config, "AdvOut", "RescaleRes", outputResString);
-			config_save_safe(config, "tmp", nullptr);
+			ConfigManager::getInstance().markDirty(config);
 		}
 
 		rescaleRes.currentValue.resize(strlen(outputResString));
@@ -1845,7 +1840,7 @@ SubCategory OBS_settings::getAdvancedOutputStreamingSettings(config_t* config, b
 	if (encoderID == NULL) {
 		encoderID = "obs_x264";
 		config_set_string(config, "AdvOut", "Encoder", encoderID);
-		config_save_safe(config, "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(config);
 	}
 
 	struct stat buffer;
@@ -1874,12 +1869,13 @@ SubCategory OBS_settings::getAdvancedOutputStreamingSettings(config_t* config, b
 			streamingEncoder = obs_video_encoder_create(encoderID, "streaming_h264", nullptr, nullptr);
 			OBS_service::setStreamingEncoder(streamingEncoder);
 
-			if (!obs_data_save_json_safe(settings, streamName.c_str(), "tmp", "bak")) {
+			if (!ConfigManager::getInstance().saveJson(settings, streamName)) {
 				blog(LOG_WARNING, "Failed to save encoder %s", streamName.c_str());
 			}
 		} else {
-			obs_data_t* data = obs_data_create_from_json_file_safe(streamName.c_str(), "bak");
+			obs_data_t* data = ConfigManager::getInstance().loadJson(streamName);
 			obs_data_apply(settings, data);
+			obs_data_release(data);
 			streamingEncoder = obs_video_encoder_create(encoderID, "streaming_h264", settings, nullptr);
 			OBS_service::setStreamingEncoder(streamingEncoder);
 		}
@@ -2122,7 +2118,7 @@ void OBS_settings::getStandardRecordingSettings(
 		if (outputResString == NULL) {
 			outputResString = "1280x720";
 			config_set_string(config, "AdvOut", "RecRescaleRes", outputResString);
-			config_save_safe(config, "tmp", nullptr);
+			ConfigManager::getInstance().markDirty(config);
 		}
 
 		recRescaleRes.currentValue.resize(strlen(outputResString));
@@ -2198,13 +2194,13 @@ void OBS_settings::getStandardRecordingSettings(
 			recordingEncoder = obs_video_encoder_create(recEncoderCurrentValue, "recording_h264", nullptr, nullptr);
 			OBS_service::setRecordingEncoder(recordingEncoder);
 
-			if (!obs_data_save_json_safe(settings, ConfigManager::getInstance().getRecord().c_str(), "tmp", "bak")) {
+			if (!ConfigManager::getInstance().saveJson(settings, ConfigManager::getInstance().getRecord())) {
 				blog(LOG_WARNING, "Failed to save encoder %s", ConfigManager::getInstance().getRecord().c_str());
 			}
 		} else if (strcmp(recEncoderCurrentValue, "none") != 0) {
-			obs_data_t* data =
-			    obs_data_create_from_json_file_safe(ConfigManager::getInstance().getRecord().c_str(), "bak");
+			obs_data_t* data = ConfigManager::getInstance().loadJson(ConfigManager::getInstance().getRecord());
 			obs_data_apply(settings, data);
+			obs_data_release(data);
 			recordingEncoder = obs_video_encoder_create(recEncoderCurrentValue, "recording_h264", settings, nullptr);
 			OBS_service::setRecordingEncoder(recordingEncoder);
 		}
@@ -2515,6 +2511,40 @@ void OBS_settings::getReplayBufferSettings(
 		RecRBTime.push_back(std::make_pair("maxVal", ipc::value((double)21599)));
 		RecRBTime.push_back(std::make_pair("stepVal", ipc::value((double)0)));
 		entries.push_back(RecRBTime);
+
+		std::vector<std::pair<std::string, ipc::value>> RecRBDisk;
+		RecRBDisk.push_back(std::make_pair("name", ipc::value("RecRBDisk")));
+		RecRBDisk.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_BOOL")));
+		RecRBDisk.push_back(std::make_pair("description", ipc::value("Keep Older Replay On Disk (FLV)")));
+		RecRBDisk.push_back(std::make_pair("subType", ipc::value("")));
+		RecRBDisk.push_back(std::make_pair("minVal", ipc::value((double)0)));
+		RecRBDisk.push_back(std::make_pair("maxVal", ipc::value((double)0)));
+		RecRBDisk.push_back(std::make_pair("stepVal", ipc::value((double)0)));
+		entries.push_back(RecRBDisk);
+
+		bool currentRecRbDisk = config_get_bool(config, advanced ? "AdvOut" : "SimpleOutput", "RecRBDisk");
+
+		if (currentRecRbDisk) {
+			std::vector<std::pair<std::string, ipc::value>> RecRBMemSize;
+			RecRBMemSize.push_back(std::make_pair("name", ipc::value("RecRBMemSize")));
+			RecRBMemSize.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_INT")));
+			RecRBMemSize.push_back(std::make_pair("description", ipc::value("Replay Memory Budget (MB)")));
+			RecRBMemSize.push_back(std::make_pair("subType", ipc::value("")));
+			RecRBMemSize.push_back(std::make_pair("minVal", ipc::value((double)0)));
+			RecRBMemSize.push_back(std::make_pair("maxVal", ipc::value((double)65536)));
+			RecRBMemSize.push_back(std::make_pair("stepVal", ipc::value((double)0)));
+			entries.push_back(RecRBMemSize);
+
+			std::vector<std::pair<std::string, ipc::value>> RecRBDiskSize;
+			RecRBDiskSize.push_back(std::make_pair("name", ipc::value("RecRBDiskSize")));
+			RecRBDiskSize.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_INT")));
+			RecRBDiskSize.push_back(std::make_pair("description", ipc::value("Replay Disk Budget (MB)")));
+			RecRBDiskSize.push_back(std::make_pair("subType", ipc::value("")));
+			RecRBDiskSize.push_back(std::make_pair("minVal", ipc::value((double)0)));
+			RecRBDiskSize.push_back(std::make_pair("maxVal", ipc::value((double)1048576)));
+			RecRBDiskSize.push_back(std::make_pair("stepVal", ipc::value((double)0)));
+			entries.push_back(RecRBDiskSize);
+		}
 	}
 
 	if (obs_get_multiple_rendering()) {
@@ -2714,7 +2744,7 @@ void OBS_settings::saveAdvancedOutputStreamingSettings(std::vector<SubCategory>
 		config_set_bool(ConfigManager::getInstance().getBasic(), "AdvOut", "ApplyServiceSettings", true);
 #endif
 
-	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(ConfigManager::getInstance().getBasic());
 
 	if (newEncoderType) {
 		encoderSettings = obs_encoder_defaults(
@@ -2723,7 +2753,7 @@ void OBS_settings::saveAdvancedOutputStreamingSettings(std::vector<SubCategory>
 
 	obs_encoder_update(encoder, encoderSettings);
 
-	if (!obs_data_save_json_safe(encoderSettings, ConfigManager::getInstance().getStream().c_str(), "tmp", "bak")) {
+	if (!ConfigManager::getInstance().saveJson(encoderSettings, ConfigManager::getInstance().getStream())) {
 		blog(LOG_WARNING, "Failed to save encoder %s", ConfigManager::getInstance().getStream().c_str());
 	}
 }
@@ -2848,7 +2878,7 @@ void OBS_settings::saveAdvancedOutputRecordingSettings(std::vector<SubCategory>
 		}
 	}
 
-	int ret = config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(ConfigManager::getInstance().getBasic());
 
 	if (newEncoderType)
 		encoderSettings = obs_encoder_defaults(
@@ -2856,7 +2886,7 @@ void OBS_settings::saveAdvancedOutputRecordingSettings(std::vector<SubCategory>
 
 	obs_encoder_update(encoder, encoderSettings);
 
-	if (!obs_data_save_json_safe(encoderSettings, ConfigManager::getInstance().getRecord().c_str(), "tmp", "bak")) {
+	if (!ConfigManager::getInstance().saveJson(encoderSettings, ConfigManager::getInstance().getRecord())) {
 		blog(LOG_WARNING, "Failed to save encoder %s", ConfigManager::getInstance().getRecord().c_str());
 	}
 }
@@ -2900,7 +2930,7 @@ void OBS_settings::saveOutputSettings(std::vector<SubCategory> settings)
 
 	if (value_outputMode.compare(current_outputMode) != 0) {
 		config_set_string(ConfigManager::getInstance().getBasic(), "Output", "Mode", value_outputMode.c_str());
-		config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+		ConfigManager::getInstance().markDirty(ConfigManager::getInstance().getBasic());
 		return;
 	}
 
@@ -3022,7 +3052,7 @@ void OBS_settings::saveAudioSettings(std::vector<SubCategory> audioSettings)
 	std::string cv(channels.currentValue.data(), channels.currentValue.size());
 	config_set_string(ConfigManager::getInstance().getBasic(), "Audio", "ChannelSetup", cv.c_str());
 
-	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(ConfigManager::getInstance().getBasic());
 }
 
 std::vector<std::pair<uint64_t, uint64_t>> OBS_settings::getOutputResolutions(uint64_t base_cx, uint64_t base_cy)
@@ -3380,7 +3410,7 @@ void OBS_settings::saveVideoSettings(std::vector<SubCategory> videoSettings)
 		}
 	}
 
-	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(ConfigManager::getInstance().getBasic());
 }
 
 std::vector<SubCategory> OBS_settings::getAdvancedSettings()
@@ -3983,5 +4013,5 @@ void OBS_settings::saveGenericSettings(std::vector<SubCategory> genericSettings,
 			}
 		}
 	}
-	config_save_safe(config, "tmp", nullptr);
+	ConfigManager::getInstance().markDirty(config);
 }
@@ -22,6 +22,26 @@
 #include "osn-source.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
+#include <map>
+#include <mutex>
+
+// Volume changes reported by each fader's callback, the client polls them with Query.
+struct fader_changes
+{
+	uint64_t sequence = 0;
+	float    db       = 0.0f;
+};
+
+static std::mutex                        changes_mtx;
+static std::map<uint64_t, fader_changes> changes;
+
+static void fader_changed(void* param, float db)
+{
+	std::unique_lock<std::mutex> ulock(changes_mtx);
+	fader_changes&               entry = changes[(uint64_t)(uintptr_t)param];
+	entry.sequence++;
+	entry.db = db;
+}
 
 osn::Fader::Manager& osn::Fader::Manager::GetInstance()
 {
@@ -55,6 +75,7 @@ void osn::Fader::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
 	cls->register_function(
 	    std::make_shared<ipc::function>("RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
+	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{ipc::type::UInt64}, Query));
 	srv.register_collection(cls);
 }
 
@@ -66,6 +87,9 @@ void osn::Fader::ClearFaders()
     });
 
     Manager::GetInstance().clear();
+
+	std::unique_lock<std::mutex> ulock(changes_mtx);
+	changes.clear();
 }
 
 void osn::Fader::Create(
@@ -105,9 +129,15 @@ void osn::Fader::Destroy(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference , "Invalid Fader Reference.");
 	}
 
+	obs_fader_remove_callback(fader, fader_changed, (void*)(uintptr_t)uid);
 	obs_fader_destroy(fader);
 	Manager::GetInstance().free(uid);
 
+	{
+		std::unique_lock<std::mutex> ulock(changes_mtx);
+		changes.erase(uid);
+	}
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
@@ -249,7 +279,9 @@ void osn::Fader::Attach(
 		PRETTY_ERROR_RETURN(ErrorCode::Error, "Error attaching source..");
 	}
 
+	// The fader now follows the source volume, the client mirrors it from here
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(obs_fader_get_db(fader)));
 	AUTO_DEBUG;
 }
 
@@ -278,7 +310,19 @@ void osn::Fader::AddCallback(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	//!FIXME!
+	auto uid = args[0].value_union.ui64;
+
+	auto fader = Manager::GetInstance().find(uid);
+	if (!fader) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Fader Reference.");
+	}
+
+	// Adding twice would report every change twice
+	obs_fader_remove_callback(fader, fader_changed, (void*)(uintptr_t)uid);
+	obs_fader_add_callback(fader, fader_changed, (void*)(uintptr_t)uid);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
 }
 
 void osn::Fader::RemoveCallback(
@@ -287,5 +331,42 @@ void osn::Fader::RemoveCallback(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	//!FIXME!
+	auto uid = args[0].value_union.ui64;
+
+	auto fader = Manager::GetInstance().find(uid);
+	if (!fader) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Fader Reference.");
+	}
+
+	obs_fader_remove_callback(fader, fader_changed, (void*)(uintptr_t)uid);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Fader::Query(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto uid = args[0].value_union.ui64;
+
+	auto fader = Manager::GetInstance().find(uid);
+	if (!fader) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Fader Reference.");
+	}
+
+	uint64_t sequence = 0;
+	{
+		std::unique_lock<std::mutex> ulock(changes_mtx);
+		auto                         iter = changes.find(uid);
+		if (iter != changes.end())
+			sequence = iter->second.sequence;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(sequence));
+	rval.push_back(ipc::value(obs_fader_get_db(fader)));
+	AUTO_DEBUG;
 }
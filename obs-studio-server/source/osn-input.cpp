@@ -16,7 +16,7 @@
 
 ******************************************************************************/
 
-#include "osn-Input.hpp"
+#include "osn-input.hpp"
 #include <iostream>
 #include <ipc-server.hpp>
 #include <memory>
@@ -24,6 +24,7 @@
 #include "error.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
+#include "source-registry.h"
 
 void osn::Input::Register(ipc::server& srv)
 {
@@ -47,6 +48,8 @@ void osn::Input::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
 	cls->register_function(
 	    std::make_shared<ipc::function>("GetPublicSources", std::vector<ipc::type>{}, GetPublicSources));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "FindSources", std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32}, FindSources));
 
 	cls->register_function(
 	    std::make_shared<ipc::function>("Duplicate", std::vector<ipc::type>{ipc::type::UInt64}, Duplicate));
@@ -234,7 +237,7 @@ void osn::Input::FromName(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	obs_source_t* source = obs_get_source_by_name(args[0].value_str.c_str());
+	obs_source_t* source = SourceRegistry::GetInstance().findByName(args[0].value_str);
 	if (!source) {
 		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Named input could not be found.");
 	}
@@ -244,8 +247,6 @@ void osn::Input::FromName(
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Source found but not indexed.");
 	}
 
-	obs_source_release(source);
-
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
 	AUTO_DEBUG;
@@ -257,22 +258,42 @@ void osn::Input::GetPublicSources(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	std::list<uint64_t> inputs;
+	// Ids are written straight into the binary payload of the response.
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(std::vector<char>()));
 
-	// !FIXME! Optimize for zero-copy operation, can directly write to rval.
-	auto enum_cb = [](void* data, obs_source_t* source) {
+	// Same set as obs_enum_sources: public inputs and groups, newest first
+	std::vector<obs_source_t*> sources = SourceRegistry::GetInstance().enumerate("", 0, OBS_SOURCE_TYPE_INPUT, true);
+
+	std::vector<char>& ids = rval.back().value_bin;
+	ids.reserve(sources.size() * sizeof(uint64_t));
+	for (obs_source_t* source : sources) {
 		uint64_t uid = osn::Source::Manager::GetInstance().find(source);
-		if (uid != UINT64_MAX) {
-			static_cast<std::list<uint64_t>*>(data)->push_back(uid);
-		}
-		return true;
-	};
+		if (uid != UINT64_MAX)
+			utility::append_binary(ids, uid);
+	}
+	AUTO_DEBUG;
+}
 
-	obs_enum_sources(enum_cb, &inputs);
+void osn::Input::FindSources(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Public inputs of the given type id (any if empty) having every given output flag
+	std::vector<obs_source_t*> sources = SourceRegistry::GetInstance().enumerate(
+	    args[0].value_str, args[1].value_union.ui32, OBS_SOURCE_TYPE_INPUT);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	for (uint64_t uid : inputs) {
-		rval.push_back(uid);
+	rval.push_back(ipc::value(std::vector<char>()));
+
+	std::vector<char>& ids = rval.back().value_bin;
+	ids.reserve(sources.size() * sizeof(uint64_t));
+	for (obs_source_t* source : sources) {
+		uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+		if (uid != UINT64_MAX)
+			utility::append_binary(ids, uid);
 	}
 	AUTO_DEBUG;
 }
@@ -336,7 +357,7 @@ void osn::Input::SetVolume(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Input reference is not valid.");
 	}
 
-	obs_source_set_volume(input, (float_t)args[1].value_union.fp64);
+	obs_source_set_volume(input, args[1].value_union.fp32);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(obs_source_get_volume(input)));
@@ -654,16 +675,15 @@ void osn::Input::GetFilters(
 	}
 
 	auto enum_cb = [](obs_source_t* parent, obs_source_t* filter, void* data) {
-		std::vector<ipc::value>* rval = reinterpret_cast<std::vector<ipc::value>*>(data);
-
 		uint64_t id = osn::Source::Manager::GetInstance().find(filter);
 		if (id != UINT64_MAX) {
-			rval->push_back(id);
+			utility::append_binary(*reinterpret_cast<std::vector<char>*>(data), id);
 		}
 	};
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	obs_source_enum_filters(input, enum_cb, &rval);
+	rval.push_back(ipc::value(std::vector<char>()));
+	obs_source_enum_filters(input, enum_cb, &rval.back().value_bin);
 	AUTO_DEBUG;
 }
 
@@ -19,6 +19,7 @@
 #include "osn-module.hpp"
 #include "error.hpp"
 #include "shared.hpp"
+#include "encoder-registry.h"
 
 void osn::Module::Register(ipc::server& srv)
 {
@@ -101,8 +102,12 @@ void osn::Module::Initialize(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Module reference is not valid.");
 	}
 	
+	bool initialized = obs_init_module(module);
+	if (initialized)
+		EncoderRegistry::GetInstance().invalidate();
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(obs_init_module(module)));
+	rval.push_back(ipc::value(initialized));
 	AUTO_DEBUG;
 }
 
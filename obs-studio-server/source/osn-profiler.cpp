@@ -0,0 +1,96 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-profiler.hpp"
+#include "error.hpp"
+#include "shared.hpp"
+#include "source-profiler.h"
+
+void osn::Profiler::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Profiler");
+
+	cls->register_function(std::make_shared<ipc::function>("GetEnabled", std::vector<ipc::type>{}, GetEnabled));
+	cls->register_function(
+	    std::make_shared<ipc::function>("SetEnabled", std::vector<ipc::type>{ipc::type::Int32}, SetEnabled));
+	cls->register_function(
+	    std::make_shared<ipc::function>("GetSourceCosts", std::vector<ipc::type>{}, GetSourceCosts));
+	cls->register_function(std::make_shared<ipc::function>("Reset", std::vector<ipc::type>{}, Reset));
+
+	srv.register_collection(cls);
+}
+
+void osn::Profiler::GetEnabled(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(SourceProfiler::GetInstance().enabled()));
+	AUTO_DEBUG;
+}
+
+void osn::Profiler::SetEnabled(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	if (args[0].value_union.i32)
+		SourceProfiler::GetInstance().start();
+	else
+		SourceProfiler::GetInstance().stop();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Profiler::GetSourceCosts(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<source_cost> costs = SourceProfiler::GetInstance().costs();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)costs.size()));
+
+	for (auto& cost : costs) {
+		rval.push_back(ipc::value(cost.name));
+		rval.push_back(ipc::value(cost.id));
+		rval.push_back(ipc::value((uint32_t)cost.type));
+		rval.push_back(ipc::value(cost.samples));
+		rval.push_back(ipc::value(cost.min_ms));
+		rval.push_back(ipc::value(cost.avg_ms));
+		rval.push_back(ipc::value(cost.p99_ms));
+	}
+	AUTO_DEBUG;
+}
+
+void osn::Profiler::Reset(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	SourceProfiler::GetInstance().reset();
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
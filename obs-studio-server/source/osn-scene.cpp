@@ -21,6 +21,7 @@
 #include "error.hpp"
 #include "osn-sceneitem.hpp"
 #include "shared.hpp"
+#include "source-registry.h"
 
 void osn::Scene::Register(ipc::server& srv)
 {
@@ -136,13 +137,12 @@ void osn::Scene::FromName(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	obs_source_t* source = obs_get_source_by_name(args[0].value_str.c_str());
+	obs_source_t* source = SourceRegistry::GetInstance().findByName(args[0].value_str);
 	if (!source) {
 		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to get source from scene.");
 	}
 
 	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
-	obs_source_release(source);
 
 	if (uid == UINT64_MAX) {
 
@@ -603,15 +603,17 @@ void osn::Scene::GetItems(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
 	}
 
-	std::list<obs_sceneitem_t*> items;
-	auto                        cb = [](obs_scene_t* scene, obs_sceneitem_t* item, void* data) {
-        std::list<obs_sceneitem_t*>* items = reinterpret_cast<std::list<obs_sceneitem_t*>*>(data);
+	std::vector<obs_sceneitem_t*> items;
+	auto                          cb = [](obs_scene_t* scene, obs_sceneitem_t* item, void* data) {
+        std::vector<obs_sceneitem_t*>* items = reinterpret_cast<std::vector<obs_sceneitem_t*>*>(data);
         items->push_back(item);
         return true;
 	};
 	obs_scene_enum_items(scene, cb, &items);
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	// Pairs of (uid, obs item id), sent back as a single binary value.
+	std::vector<char> ids;
+	ids.reserve(items.size() * (sizeof(uint64_t) + sizeof(int64_t)));
 	for (obs_sceneitem_t* item : items) {
 		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
 		if (uid == UINT64_MAX) {
@@ -621,9 +623,13 @@ void osn::Scene::GetItems(
 			}
 			obs_sceneitem_addref(item);
 		}
-		rval.push_back(ipc::value((uint64_t)uid));
-		rval.push_back(ipc::value(obs_sceneitem_get_id(item)));
+		utility::append_binary(ids, (uint64_t)uid);
+		utility::append_binary(ids, (int64_t)obs_sceneitem_get_id(item));
 	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(std::vector<char>()));
+	rval.back().value_bin.swap(ids);
 	AUTO_DEBUG;
 }
 
@@ -0,0 +1,404 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-scenecollection.hpp"
+#include <initializer_list>
+#include <map>
+#include <string>
+#include "error.hpp"
+#include "nlohmann/json.hpp"
+#include "osn-sceneitem.hpp"
+#include "osn-source.hpp"
+#include "shared.hpp"
+
+/* Description format (all keys except "id"/"name" are optional):
+ * {
+ *   "inputs": [{ "id", "name", "settings", "hotkeys", "volume", "muted", "enabled", "syncOffset",
+ *                "audioMixers", "monitoringType", "deinterlaceMode", "deinterlaceFieldOrder", "filters" }],
+ *   "scenes": [{ "name", "filters", "items": [{ "source" or "scene", "x", "y", "scaleX", "scaleY", "rotation",
+ *                "visible", "crop": { "left", "top", "right", "bottom" }, "streamVisible", "recordingVisible" }] }]
+ * }
+ * Filters are { "id", "name", "settings", "enabled" }. Items reference a scene by name with "scene", and an
+ * input with "source". A "source" that names no input of the description falls back to its scenes.
+ * The whole description is type checked before anything is created.
+ *
+ * Packed response, a sequence of uint64_t in description order:
+ *   per input: uid, audio mixers, filter count, filter uids...
+ *   per scene: uid, filter count, filter uids..., item count, (item uid, obs item id)...
+ * Objects that failed to be created are reported as UINT64_MAX so the remaining ids stay aligned.
+ */
+
+enum class json_kind
+{
+	String,
+	Number,
+	Boolean,
+	Object,
+	Array,
+};
+
+static bool IsKind(const nlohmann::json& value, json_kind kind)
+{
+	switch (kind) {
+	case json_kind::String:
+		return value.is_string();
+	case json_kind::Number:
+		return value.is_number();
+	case json_kind::Boolean:
+		return value.is_boolean();
+	case json_kind::Object:
+		return value.is_object();
+	case json_kind::Array:
+		return value.is_array();
+	}
+	return false;
+}
+
+// True if obj is an object and every listed key it contains has the expected kind.
+static bool CheckKeys(const nlohmann::json& obj, std::initializer_list<std::pair<const char*, json_kind>> keys)
+{
+	if (!obj.is_object())
+		return false;
+
+	for (auto& key : keys) {
+		auto it = obj.find(key.first);
+		if (it != obj.end() && !IsKind(*it, key.second))
+			return false;
+	}
+	return true;
+}
+
+static bool CheckFilters(const nlohmann::json& obj)
+{
+	auto it = obj.find("filters");
+	if (it == obj.end())
+		return true;
+	if (!it->is_array())
+		return false;
+
+	for (const nlohmann::json& desc : *it) {
+		if (!CheckKeys(
+		        desc,
+		        {{"id", json_kind::String},
+		         {"name", json_kind::String},
+		         {"settings", json_kind::Object},
+		         {"enabled", json_kind::Boolean}}))
+			return false;
+	}
+	return true;
+}
+
+static bool CheckItem(const nlohmann::json& item)
+{
+	bool valid = CheckKeys(
+	    item,
+	    {{"source", json_kind::String},
+	     {"scene", json_kind::String},
+	     {"x", json_kind::Number},
+	     {"y", json_kind::Number},
+	     {"scaleX", json_kind::Number},
+	     {"scaleY", json_kind::Number},
+	     {"rotation", json_kind::Number},
+	     {"visible", json_kind::Boolean},
+	     {"crop", json_kind::Object},
+	     {"streamVisible", json_kind::Boolean},
+	     {"recordingVisible", json_kind::Boolean}});
+	if (valid && item.contains("crop")) {
+		valid = CheckKeys(
+		    item.at("crop"),
+		    {{"left", json_kind::Number},
+		     {"top", json_kind::Number},
+		     {"right", json_kind::Number},
+		     {"bottom", json_kind::Number}});
+	}
+	return valid;
+}
+
+// nlohmann::json throws on a value of the wrong type, so the description is checked before being read.
+static bool CheckDescription(const nlohmann::json& collection, std::string& error)
+{
+	if (!CheckKeys(collection, {{"inputs", json_kind::Array}, {"scenes", json_kind::Array}})) {
+		error = "Invalid scene collection description.";
+		return false;
+	}
+
+	size_t index = 0;
+	for (const nlohmann::json& desc : collection.value("inputs", nlohmann::json::array())) {
+		bool valid = CheckKeys(
+		                 desc,
+		                 {{"id", json_kind::String},
+		                  {"name", json_kind::String},
+		                  {"settings", json_kind::Object},
+		                  {"hotkeys", json_kind::Object},
+		                  {"volume", json_kind::Number},
+		                  {"muted", json_kind::Boolean},
+		                  {"enabled", json_kind::Boolean},
+		                  {"syncOffset", json_kind::Number},
+		                  {"audioMixers", json_kind::Number},
+		                  {"monitoringType", json_kind::Number},
+		                  {"deinterlaceMode", json_kind::Number},
+		                  {"deinterlaceFieldOrder", json_kind::Number}})
+		             && CheckFilters(desc);
+		if (!valid) {
+			error = "Invalid description for input " + std::to_string(index) + ".";
+			return false;
+		}
+		index++;
+	}
+
+	index = 0;
+	for (const nlohmann::json& desc : collection.value("scenes", nlohmann::json::array())) {
+		bool valid = CheckKeys(desc, {{"name", json_kind::String}, {"items", json_kind::Array}}) && CheckFilters(desc);
+		if (valid && desc.contains("items")) {
+			for (const nlohmann::json& item : desc.at("items"))
+				valid = valid && CheckItem(item);
+		}
+		if (!valid) {
+			error = "Invalid description for scene " + std::to_string(index) + ".";
+			return false;
+		}
+		index++;
+	}
+	return true;
+}
+
+static obs_source_t* FindByName(const std::map<std::string, obs_source_t*>& sources, const std::string& name)
+{
+	auto it = sources.find(name);
+	return it != sources.end() ? it->second : nullptr;
+}
+
+static obs_data_t* DataFromJson(const nlohmann::json& obj, const char* key)
+{
+	auto it = obj.find(key);
+	if (it == obj.end() || !it->is_object())
+		return nullptr;
+	return obs_data_create_from_json(it->dump().c_str());
+}
+
+static void CreateFilters(obs_source_t* parent, const nlohmann::json& obj, std::vector<uint64_t>& packed)
+{
+	auto it = obj.find("filters");
+	if (it == obj.end() || !it->is_array()) {
+		packed.push_back(0);
+		return;
+	}
+
+	packed.push_back(it->size());
+	for (const nlohmann::json& desc : *it) {
+		std::string type = desc.value("id", "");
+		std::string name = desc.value("name", "");
+
+		obs_data_t*   settings = DataFromJson(desc, "settings");
+		obs_source_t* filter   = obs_source_create_private(type.c_str(), name.c_str(), settings);
+		obs_data_release(settings);
+
+		uint64_t uid = UINT64_MAX;
+		if (filter) {
+			uid = osn::Source::Manager::GetInstance().allocate(filter);
+			osn::Source::attach_source_signals(filter);
+			obs_source_set_enabled(filter, desc.value("enabled", true));
+			if (parent)
+				obs_source_filter_add(parent, filter);
+		} else {
+			blog(LOG_WARNING, "SceneCollection::Load: failed to create filter '%s' (%s).", name.c_str(), type.c_str());
+		}
+		packed.push_back(uid);
+	}
+}
+
+static void ApplyInputState(obs_source_t* source, const nlohmann::json& desc)
+{
+	if (desc.contains("volume"))
+		obs_source_set_volume(source, desc["volume"].get<float>());
+	if (desc.contains("muted"))
+		obs_source_set_muted(source, desc["muted"].get<bool>());
+	if (desc.contains("enabled"))
+		obs_source_set_enabled(source, desc["enabled"].get<bool>());
+	if (desc.contains("syncOffset"))
+		obs_source_set_sync_offset(source, desc["syncOffset"].get<int64_t>());
+	if (desc.contains("audioMixers"))
+		obs_source_set_audio_mixers(source, desc["audioMixers"].get<uint32_t>());
+	if (desc.contains("monitoringType"))
+		obs_source_set_monitoring_type(source, (obs_monitoring_type)desc["monitoringType"].get<int32_t>());
+	if (desc.contains("deinterlaceMode"))
+		obs_source_set_deinterlace_mode(source, (obs_deinterlace_mode)desc["deinterlaceMode"].get<int32_t>());
+	if (desc.contains("deinterlaceFieldOrder"))
+		obs_source_set_deinterlace_field_order(
+		    source, (obs_deinterlace_field_order)desc["deinterlaceFieldOrder"].get<int32_t>());
+}
+
+static void ApplyItemTransform(obs_sceneitem_t* item, const nlohmann::json& desc)
+{
+	// Defer the transform recalculation until every field has been applied.
+	obs_sceneitem_defer_update_begin(item);
+
+	vec2 pos;
+	vec2_set(&pos, desc.value("x", 0.0f), desc.value("y", 0.0f));
+	obs_sceneitem_set_pos(item, &pos);
+
+	vec2 scale;
+	vec2_set(&scale, desc.value("scaleX", 1.0f), desc.value("scaleY", 1.0f));
+	obs_sceneitem_set_scale(item, &scale);
+
+	obs_sceneitem_set_rot(item, desc.value("rotation", 0.0f));
+
+	auto crop_it = desc.find("crop");
+	if (crop_it != desc.end() && crop_it->is_object()) {
+		obs_sceneitem_crop crop;
+		crop.left   = crop_it->value("left", 0);
+		crop.top    = crop_it->value("top", 0);
+		crop.right  = crop_it->value("right", 0);
+		crop.bottom = crop_it->value("bottom", 0);
+		obs_sceneitem_set_crop(item, &crop);
+	}
+
+	obs_sceneitem_set_visible(item, desc.value("visible", true));
+	obs_sceneitem_set_stream_visible(item, desc.value("streamVisible", true));
+	obs_sceneitem_set_recording_visible(item, desc.value("recordingVisible", true));
+
+	obs_sceneitem_defer_update_end(item);
+}
+
+void osn::SceneCollection::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("SceneCollection");
+	cls->register_function(std::make_shared<ipc::function>("Load", std::vector<ipc::type>{ipc::type::String}, Load));
+	srv.register_collection(cls);
+}
+
+void osn::SceneCollection::Load(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	nlohmann::json collection = nlohmann::json::parse(args[0].value_str, nullptr, false);
+	if (collection.is_discarded() || !collection.is_object()) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Invalid scene collection description.");
+	}
+
+	std::string error;
+	if (!CheckDescription(collection, error)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, error);
+	}
+
+	nlohmann::json inputs = collection.value("inputs", nlohmann::json::array());
+	nlohmann::json scenes = collection.value("scenes", nlohmann::json::array());
+
+	// Kept apart so that a scene never shadows an input with the same name.
+	std::vector<uint64_t>                packed;
+	std::map<std::string, obs_source_t*> inputsByName;
+	std::map<std::string, obs_source_t*> scenesByName;
+
+	// Inputs first, they do not depend on anything else.
+	for (const nlohmann::json& desc : inputs) {
+		std::string type = desc.value("id", "");
+		std::string name = desc.value("name", "");
+
+		obs_data_t*   settings = DataFromJson(desc, "settings");
+		obs_data_t*   hotkeys  = DataFromJson(desc, "hotkeys");
+		obs_source_t* source   = obs_source_create(type.c_str(), name.c_str(), settings, hotkeys);
+		obs_data_release(hotkeys);
+		obs_data_release(settings);
+
+		if (!source) {
+			blog(LOG_WARNING, "SceneCollection::Load: failed to create input '%s' (%s).", name.c_str(), type.c_str());
+			packed.push_back(UINT64_MAX);
+			packed.push_back(0);
+			CreateFilters(nullptr, nlohmann::json::object(), packed);
+			continue;
+		}
+
+		ApplyInputState(source, desc);
+		inputsByName[obs_source_get_name(source)] = source;
+
+		// Public sources are indexed by the global source_create handler.
+		packed.push_back(osn::Source::Manager::GetInstance().find(source));
+		packed.push_back(obs_source_get_audio_mixers(source));
+		CreateFilters(source, desc, packed);
+	}
+
+	// Scenes are created before any item is added so that nested scenes resolve regardless of order.
+	std::vector<obs_scene_t*> created;
+	created.reserve(scenes.size());
+	for (const nlohmann::json& desc : scenes) {
+		obs_scene_t* scene = obs_scene_create(desc.value("name", "").c_str());
+		created.push_back(scene);
+		if (scene) {
+			obs_source_t* source = obs_scene_get_source(scene);
+			scenesByName[obs_source_get_name(source)] = source;
+		}
+	}
+
+	for (size_t idx = 0; idx < created.size(); idx++) {
+		const nlohmann::json& desc  = scenes[idx];
+		obs_scene_t*          scene = created[idx];
+		if (!scene) {
+			blog(LOG_WARNING, "SceneCollection::Load: failed to create scene '%s'.", desc.value("name", "").c_str());
+			packed.push_back(UINT64_MAX);
+			packed.push_back(0);
+			packed.push_back(0);
+			continue;
+		}
+
+		obs_source_t* source = obs_scene_get_source(scene);
+		packed.push_back(osn::Source::Manager::GetInstance().find(source));
+		CreateFilters(source, desc, packed);
+
+		nlohmann::json items = desc.value("items", nlohmann::json::array());
+		packed.push_back(items.size());
+		for (const nlohmann::json& item_desc : items) {
+			obs_source_t* target = nullptr;
+			if (item_desc.contains("scene")) {
+				target = FindByName(scenesByName, item_desc["scene"].get<std::string>());
+			} else {
+				std::string name = item_desc.value("source", "");
+				target           = FindByName(inputsByName, name);
+				if (!target)
+					target = FindByName(scenesByName, name);
+			}
+			if (!target) {
+				packed.push_back(UINT64_MAX);
+				packed.push_back(UINT64_MAX);
+				continue;
+			}
+
+			obs_sceneitem_t* item = obs_scene_add(scene, target);
+			if (!item) {
+				packed.push_back(UINT64_MAX);
+				packed.push_back(UINT64_MAX);
+				continue;
+			}
+
+			ApplyItemTransform(item, item_desc);
+
+			utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().allocate(item);
+			if (uid != UINT64_MAX)
+				obs_sceneitem_addref(item);
+
+			packed.push_back(uid);
+			packed.push_back(uint64_t(obs_sceneitem_get_id(item)));
+		}
+	}
+
+	const char* begin = reinterpret_cast<const char*>(packed.data());
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(std::vector<char>(begin, begin + packed.size() * sizeof(uint64_t))));
+	AUTO_DEBUG;
+}
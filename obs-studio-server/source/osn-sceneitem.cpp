@@ -17,7 +17,9 @@
 ******************************************************************************/
 
 #include "osn-sceneitem.hpp"
+#include <cstring>
 #include <error.hpp>
+#include <sceneitem-transform.hpp>
 #include "osn-source.hpp"
 #include "shared.hpp"
 
@@ -100,6 +102,8 @@ void osn::SceneItem::Register(ipc::server& srv)
 	    "DeferUpdateBegin", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateBegin));
 	cls->register_function(
 	    std::make_shared<ipc::function>("DeferUpdateEnd", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateEnd));
+	cls->register_function(
+	    std::make_shared<ipc::function>("ApplyTransforms", std::vector<ipc::type>{ipc::type::Binary}, ApplyTransforms));
 	srv.register_collection(cls);
 }
 
@@ -802,6 +806,112 @@ void osn::SceneItem::DeferUpdateEnd(
 	AUTO_DEBUG;
 }
 
+static void ApplyTransform(obs_sceneitem_t* item, const sceneitem_transform::record& rec)
+{
+	if (rec.mask & sceneitem_transform::Position) {
+		vec2 pos;
+		pos.x = rec.position_x;
+		pos.y = rec.position_y;
+		obs_sceneitem_set_pos(item, &pos);
+	}
+	if (rec.mask & sceneitem_transform::Scale) {
+		vec2 scale;
+		scale.x = rec.scale_x;
+		scale.y = rec.scale_y;
+		obs_sceneitem_set_scale(item, &scale);
+	}
+	if (rec.mask & sceneitem_transform::Rotation)
+		obs_sceneitem_set_rot(item, rec.rotation);
+	if (rec.mask & sceneitem_transform::Crop) {
+		obs_sceneitem_crop crop;
+		crop.left   = rec.crop_left;
+		crop.top    = rec.crop_top;
+		crop.right  = rec.crop_right;
+		crop.bottom = rec.crop_bottom;
+		obs_sceneitem_set_crop(item, &crop);
+	}
+	if (rec.mask & sceneitem_transform::Bounds) {
+		vec2 bounds;
+		bounds.x = rec.bounds_x;
+		bounds.y = rec.bounds_y;
+		obs_sceneitem_set_bounds(item, &bounds);
+	}
+	if (rec.mask & sceneitem_transform::Alignment)
+		obs_sceneitem_set_alignment(item, rec.alignment);
+	if (rec.mask & sceneitem_transform::BoundsAlignment)
+		obs_sceneitem_set_bounds_alignment(item, rec.bounds_alignment);
+	if (rec.mask & sceneitem_transform::BoundsType)
+		obs_sceneitem_set_bounds_type(item, (obs_bounds_type)rec.bounds_type);
+}
+
+static void ResolveTransform(obs_sceneitem_t* item, sceneitem_transform::record& rec)
+{
+	obs_transform_info info;
+	obs_sceneitem_get_info(item, &info);
+	obs_sceneitem_crop crop;
+	obs_sceneitem_get_crop(item, &crop);
+
+	rec.mask             = sceneitem_transform::All;
+	rec.alignment        = info.alignment;
+	rec.position_x       = info.pos.x;
+	rec.position_y       = info.pos.y;
+	rec.scale_x          = info.scale.x;
+	rec.scale_y          = info.scale.y;
+	rec.rotation         = info.rot;
+	rec.bounds_x         = info.bounds.x;
+	rec.bounds_y         = info.bounds.y;
+	rec.bounds_alignment = info.bounds_alignment;
+	rec.bounds_type      = info.bounds_type;
+	rec.crop_left        = crop.left;
+	rec.crop_top         = crop.top;
+	rec.crop_right       = crop.right;
+	rec.crop_bottom      = crop.bottom;
+	rec.reserved         = 0;
+}
+
+void osn::SceneItem::ApplyTransforms(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	const std::vector<char>& packed = args[0].value_bin;
+	if (packed.size() % sizeof(sceneitem_transform::record) != 0) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Transform records are malformed.");
+	}
+
+	std::vector<sceneitem_transform::record> records(packed.size() / sizeof(sceneitem_transform::record));
+	if (!records.empty())
+		memcpy(records.data(), packed.data(), packed.size());
+
+	// Resolve every item first so that a stale id rejects the whole batch instead of half of it.
+	std::vector<obs_sceneitem_t*> items(records.size());
+	for (size_t idx = 0; idx < records.size(); idx++) {
+		items[idx] = osn::SceneItem::Manager::GetInstance().find(records[idx].id);
+		if (!items[idx]) {
+			PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Item reference is not valid.");
+		}
+	}
+
+	// Updates are deferred until every item is written, so a group edit lands in a single frame.
+	for (obs_sceneitem_t* item : items)
+		obs_sceneitem_defer_update_begin(item);
+	for (size_t idx = 0; idx < records.size(); idx++)
+		ApplyTransform(items[idx], records[idx]);
+	for (obs_sceneitem_t* item : items)
+		obs_sceneitem_defer_update_end(item);
+
+	for (size_t idx = 0; idx < records.size(); idx++)
+		ResolveTransform(items[idx], records[idx]);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(std::vector<char>()));
+	rval.back().value_bin.resize(records.size() * sizeof(sceneitem_transform::record));
+	if (!records.empty())
+		memcpy(rval.back().value_bin.data(), records.data(), rval.back().value_bin.size());
+	AUTO_DEBUG;
+}
+
 osn::SceneItem::Manager& osn::SceneItem::Manager::GetInstance()
 {
 	// Thread Safe since C++13 (Visual Studio 2015, GCC 4.3).
@@ -32,11 +32,13 @@
 #include "shared.hpp"
 #include "callback-manager.h"
 #include "memory-manager.h"
+#include "source-registry.h"
 
 void osn::Source::initialize_global_signals()
 {
 	signal_handler_t* sh = obs_get_signal_handler();
 	signal_handler_connect(sh, "source_create", osn::Source::global_source_create_cb, nullptr);
+	signal_handler_connect(sh, "source_rename", osn::Source::global_source_rename_cb, nullptr);
 	signal_handler_connect(sh, "source_activate", osn::Source::global_source_activate_cb, nullptr);
 	signal_handler_connect(sh, "source_deactivate", osn::Source::global_source_deactivate_cb, nullptr);
 }
@@ -45,6 +47,7 @@ void osn::Source::finalize_global_signals()
 {
 	signal_handler_t* sh = obs_get_signal_handler();
 	signal_handler_disconnect(sh, "source_create", osn::Source::global_source_create_cb, nullptr);
+	signal_handler_disconnect(sh, "source_rename", osn::Source::global_source_rename_cb, nullptr);
 }
 
 void osn::Source::attach_source_signals(obs_source_t* src)
@@ -70,6 +73,7 @@ void osn::Source::global_source_create_cb(void* ptr, calldata_t* cd)
 		throw std::runtime_error("calldata did not contain source pointer");
 	}
 
+	SourceRegistry::GetInstance().add(source);
 	osn::Source::Manager::GetInstance().allocate(source);
 	osn::Source::attach_source_signals(source);
 	CallbackManager::addSource(source);
@@ -105,6 +109,17 @@ void osn::Source::global_source_destroy_cb(void* ptr, calldata_t* cd)
 	detach_source_signals(source);
 	osn::Source::Manager::GetInstance().free(source);
 	MemoryManager::GetInstance().unregisterSource(source);
+	SourceRegistry::GetInstance().remove(source);
+}
+
+void osn::Source::global_source_rename_cb(void* ptr, calldata_t* cd)
+{
+	obs_source_t* source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source)) {
+		throw std::runtime_error("calldata did not contain source pointer");
+	}
+
+	SourceRegistry::GetInstance().rename(source, calldata_string(cd, "new_name"));
 }
 
 void osn::Source::Register(ipc::server& srv)
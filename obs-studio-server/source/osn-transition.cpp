@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "osn-transition.hpp"
+#include <cstring>
 #include <ipc-server.hpp>
 #include <memory>
 #include <obs.h>
@@ -60,10 +61,16 @@ void osn::Transition::Types(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	// Null-terminated type ids, written straight into the binary payload of the response.
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	const char* typeId = nullptr;
+	rval.push_back(ipc::value(std::vector<char>()));
+
+	std::vector<char>& types  = rval.back().value_bin;
+	const char*        typeId = nullptr;
 	for (size_t idx = 0; obs_enum_transition_types(idx, &typeId); idx++) {
-		rval.push_back(ipc::value(typeId ? typeId : ""));
+		if (typeId)
+			types.insert(types.end(), typeId, typeId + strlen(typeId));
+		types.push_back('\0');
 	}
 	AUTO_DEBUG;
 }
@@ -23,6 +23,7 @@
 #include "shared.hpp"
 #include "utility.hpp"
 #include <cmath>
+#include <thread>
 
 std::mutex mtx;
 
@@ -37,6 +38,13 @@ osn::Volmeter::Volmeter(obs_fader_type type)
 	self = obs_volmeter_create(type);
 	if (!self)
 		throw std::exception();
+
+	current_data.self = self;
+	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
+		current_data.magnitude[ch].store(0, std::memory_order_relaxed);
+		current_data.peak[ch].store(0, std::memory_order_relaxed);
+		current_data.input_peak[ch].store(0, std::memory_order_relaxed);
+	}
 }
 
 osn::Volmeter::~Volmeter()
@@ -70,10 +78,9 @@ void osn::Volmeter::ClearVolmeters()
 {
     Manager::GetInstance().for_each([](const std::shared_ptr<osn::Volmeter>& volmeter)
     {
-        if (volmeter->id2) {
-            obs_volmeter_remove_callback(volmeter->self, OBSCallback, volmeter->id2);
-            delete volmeter->id2;
-            volmeter->id2 = nullptr;
+        if (volmeter->callback_count > 0) {
+            obs_volmeter_remove_callback(volmeter->self, OBSCallback, &volmeter->current_data);
+            volmeter->callback_count = 0;
         }
     });
 
@@ -123,10 +130,9 @@ void osn::Volmeter::Destroy(
 	}
 
 	Manager::GetInstance().free(uid);
-	if (meter->id2) { // Ensure there are no more callbacks
-		obs_volmeter_remove_callback(meter->self, OBSCallback, meter->id2);
-		delete meter->id2;
-		meter->id2 = nullptr;
+	if (meter->callback_count > 0) { // Ensure there are no more callbacks
+		obs_volmeter_remove_callback(meter->self, OBSCallback, &meter->current_data);
+		meter->callback_count = 0;
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -235,11 +241,8 @@ void osn::Volmeter::AddCallback(
 	}
 
 	meter->callback_count++;
-	if (meter->callback_count == 1) {
-		meter->id2  = new uint64_t;
-		*meter->id2 = meter->id;
-		obs_volmeter_add_callback(meter->self, OBSCallback, meter->id2);
-	}
+	if (meter->callback_count == 1)
+		obs_volmeter_add_callback(meter->self, OBSCallback, &meter->current_data);
 
 	rval.push_back(ipc::value(uint64_t(ErrorCode::Ok)));
 	rval.push_back(ipc::value(uint64_t(meter->callback_count)));
@@ -260,11 +263,8 @@ void osn::Volmeter::RemoveCallback(
 	}
 
 	meter->callback_count--;
-	if (meter->callback_count == 0) {
-		obs_volmeter_remove_callback(meter->self, OBSCallback, meter->id2);
-		delete meter->id2;
-		meter->id2 = nullptr;
-	}
+	if (meter->callback_count == 0)
+		obs_volmeter_remove_callback(meter->self, OBSCallback, &meter->current_data);
 
 	rval.push_back(ipc::value(uint64_t(ErrorCode::Ok)));
 	rval.push_back(ipc::value(uint64_t(meter->callback_count)));
@@ -284,28 +284,26 @@ void osn::Volmeter::Query(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Meter reference.");
 	}
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
+	AudioSnapshot snapshot;
+	meter->current_data.read(snapshot);
+	ulockMutex.unlock();
 
-	// Reset audio data if OBSCallBack is idle
-	if (meter->current_data.lastUpdateTime != std::chrono::milliseconds(0)) {
-		if (CheckIdle(GetTime(), meter->current_data.lastUpdateTime)) {
-			meter->current_data.resetData();
+	// Report silence if OBSCallBack is idle
+	if (snapshot.lastUpdateTime != std::chrono::milliseconds(0)) {
+		if (CheckIdle(GetTime(), snapshot.lastUpdateTime)) {
+			snapshot.resetData();
 		}
 	}
-	
 
-	rval.push_back(ipc::value(meter->current_data.ch));
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(snapshot.ch));
 
-	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
-		rval.push_back(ipc::value(meter->current_data.magnitude[ch]));
-		rval.push_back(ipc::value(meter->current_data.peak[ch]));
-		rval.push_back(ipc::value(meter->current_data.input_peak[ch]));
+	for (size_t ch = 0; ch < snapshot.ch; ch++) {
+		rval.push_back(ipc::value(snapshot.magnitude[ch]));
+		rval.push_back(ipc::value(snapshot.peak[ch]));
+		rval.push_back(ipc::value(snapshot.input_peak[ch]));
 	}
 
-	ulock.unlock();
-
 	AUTO_DEBUG;
 }
 
@@ -315,28 +313,64 @@ void osn::Volmeter::OBSCallback(
     const float peak[MAX_AUDIO_CHANNELS],
     const float input_peak[MAX_AUDIO_CHANNELS])
 {
-	std::unique_lock<std::mutex> ulockMutex(mtx);
-	auto meter = Manager::GetInstance().find(*reinterpret_cast<uint64_t*>(param));
-	if (!meter) {
-		return;
-	}
+	AudioData* audio = reinterpret_cast<AudioData*>(param);
+	audio->publish(GetTime(), obs_volmeter_get_nr_channels(audio->self), magnitude, peak, input_peak);
+}
 
+void osn::Volmeter::AudioData::publish(
+    std::chrono::milliseconds time,
+    int32_t                   channels,
+    const float               new_magnitude[MAX_AUDIO_CHANNELS],
+    const float               new_peak[MAX_AUDIO_CHANNELS],
+    const float               new_input_peak[MAX_AUDIO_CHANNELS])
+{
 #define MAKE_FLOAT_SANE(db) (std::isfinite(db) ? db : (db > 0 ? 0.0f : -65535.0f))
-#define PREVIOUS_FRAME_WEIGHT
-
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
 
-	meter->current_data.lastUpdateTime = GetTime();
-	meter->current_data.ch = obs_volmeter_get_nr_channels(meter->self);
-	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
-		meter->current_data.magnitude[ch]  = MAKE_FLOAT_SANE(magnitude[ch]);
-		meter->current_data.peak[ch]       = MAKE_FLOAT_SANE(peak[ch]);
-		meter->current_data.input_peak[ch] = MAKE_FLOAT_SANE(input_peak[ch]);
+	// An odd sequence marks a write in progress.
+	uint32_t seq = sequence.load(std::memory_order_relaxed);
+	sequence.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	lastUpdateTime.store(time.count(), std::memory_order_relaxed);
+	ch.store(channels, std::memory_order_relaxed);
+	for (size_t idx = 0; idx < MAX_AUDIO_CHANNELS; idx++) {
+		magnitude[idx].store(MAKE_FLOAT_SANE(new_magnitude[idx]), std::memory_order_relaxed);
+		peak[idx].store(MAKE_FLOAT_SANE(new_peak[idx]), std::memory_order_relaxed);
+		input_peak[idx].store(MAKE_FLOAT_SANE(new_input_peak[idx]), std::memory_order_relaxed);
 	}
 
+	sequence.store(seq + 2, std::memory_order_release);
+
 #undef MAKE_FLOAT_SANE
 }
 
+void osn::Volmeter::AudioData::read(AudioSnapshot& snapshot) const
+{
+	uint32_t begin, end;
+	do {
+		begin = sequence.load(std::memory_order_acquire);
+		if (begin & 1) {
+			std::this_thread::yield();
+			end = begin + 1;
+			continue;
+		}
+
+		snapshot.lastUpdateTime = std::chrono::milliseconds(lastUpdateTime.load(std::memory_order_relaxed));
+		snapshot.ch             = ch.load(std::memory_order_relaxed);
+		for (size_t idx = 0; idx < MAX_AUDIO_CHANNELS; idx++) {
+			snapshot.magnitude[idx]  = magnitude[idx].load(std::memory_order_relaxed);
+			snapshot.peak[idx]       = peak[idx].load(std::memory_order_relaxed);
+			snapshot.input_peak[idx] = input_peak[idx].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		end = sequence.load(std::memory_order_relaxed);
+	} while (begin != end);
+
+	if (snapshot.ch < 0 || snapshot.ch > MAX_AUDIO_CHANNELS)
+		snapshot.ch = 0;
+}
+
 std::chrono::milliseconds osn::Volmeter::GetTime()
 {
 	auto currentTime   = std::chrono::high_resolution_clock::now();
@@ -21,6 +21,8 @@
 #include <memory>
 #include <queue>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include "obs.h"
 #include "utility.hpp"
 
@@ -51,9 +53,8 @@ namespace osn
 		obs_volmeter_t* self;
 		uint64_t        id;
 		size_t          callback_count = 0;
-		uint64_t*       id2            = nullptr;
 
-		struct AudioData
+		struct AudioSnapshot
 		{
 			std::array<float, MAX_AUDIO_CHANNELS> magnitude{0};
 			std::array<float, MAX_AUDIO_CHANNELS> peak{0};
@@ -70,8 +71,31 @@ namespace osn
 			}
 		};
 
+		// Levels published by the audio thread through a sequence lock. The audio thread is the
+		// only writer and never waits; readers retry while a write is in progress. It is reached
+		// through the callback parameter, so the audio thread neither takes mtx nor looks up the
+		// meter. obs_volmeter_remove_callback waits for a running callback, which makes it safe to
+		// free the meter once the callback is removed.
+		struct AudioData
+		{
+			obs_volmeter_t*                                     self = nullptr;
+			std::atomic<uint32_t>                               sequence{0};
+			std::atomic<int64_t>                                lastUpdateTime{0};
+			std::atomic<int32_t>                                ch{0};
+			std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> magnitude;
+			std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> peak;
+			std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> input_peak;
+
+			void publish(
+			    std::chrono::milliseconds time,
+			    int32_t                   channels,
+			    const float               new_magnitude[MAX_AUDIO_CHANNELS],
+			    const float               new_peak[MAX_AUDIO_CHANNELS],
+			    const float               new_input_peak[MAX_AUDIO_CHANNELS]);
+			void read(AudioSnapshot& snapshot) const;
+		};
+
 		AudioData current_data;
-		std::mutex                 current_data_mtx;
 
 		public:
 		Volmeter(obs_fader_type type);
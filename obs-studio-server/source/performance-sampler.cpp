@@ -0,0 +1,301 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "performance-sampler.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include "nodeobs_configManager.hpp"
+#include "nodeobs_service.h"
+
+static const char* NullToEmpty(const char* str)
+{
+	return str ? str : "";
+}
+
+PerformanceSampler::PerformanceSampler()
+    : cpu_info(nullptr), disk_free(0), next_disk_check(0), stopping(false), sequence(0), disk_path_changes(UINT64_MAX)
+{
+	memset(history, 0, sizeof(history));
+	for (auto& count : reconnects)
+		count = 0;
+}
+
+PerformanceSampler::~PerformanceSampler()
+{
+	stop();
+}
+
+void PerformanceSampler::start(void)
+{
+	if (worker.joinable())
+		return;
+
+	cpu_info        = os_cpu_usage_info_start();
+	next_disk_check = 0;
+	for (size_t idx = 0; idx < SAMPLER_OUTPUTS; idx++)
+		resetOutput(idx);
+	stopping        = false;
+	refreshDiskPath();
+
+	// Take the first sample right away so that a poll following the initialization has data.
+	sample();
+	worker = std::thread(&PerformanceSampler::run, this);
+}
+
+void PerformanceSampler::stop(void)
+{
+	if (!worker.joinable())
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		stopping = true;
+	}
+	cv.notify_all();
+	worker.join();
+
+	os_cpu_usage_info_destroy(cpu_info);
+	cpu_info = nullptr;
+}
+
+performance_sample PerformanceSampler::latest(void)
+{
+	refreshDiskPath();
+
+	std::unique_lock<std::mutex> lock(mtx);
+	if (sequence == 0) {
+		performance_sample empty = {};
+		return empty;
+	}
+	return history[(sequence - 1) % SAMPLER_HISTORY];
+}
+
+uint64_t PerformanceSampler::since(uint64_t last, std::vector<performance_sample>& samples)
+{
+	refreshDiskPath();
+
+	std::unique_lock<std::mutex> lock(mtx);
+
+	uint64_t first = sequence > SAMPLER_HISTORY ? sequence - SAMPLER_HISTORY + 1 : 1;
+	if (last + 1 > first)
+		first = last + 1;
+
+	for (uint64_t seq = first; seq <= sequence; seq++)
+		samples.push_back(history[(seq - 1) % SAMPLER_HISTORY]);
+
+	return sequence;
+}
+
+void PerformanceSampler::connectOutput(obs_output_t* output, sampler_output kind)
+{
+	// libobs ignores a callback that is already connected, and drops it with the output
+	if (output)
+		signal_handler_connect(obs_output_get_signal_handler(output), "reconnect", OutputReconnect, &reconnects[kind]);
+}
+
+void PerformanceSampler::OutputReconnect(void* data, calldata_t* params)
+{
+	reinterpret_cast<std::atomic<uint32_t>*>(data)->fetch_add(1);
+}
+
+void PerformanceSampler::run(void)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	while (!cv.wait_for(lock, std::chrono::milliseconds(SAMPLER_INTERVAL_MS), [this] { return stopping; })) {
+		lock.unlock();
+		sample();
+		lock.lock();
+	}
+}
+
+struct sample_context
+{
+	PerformanceSampler* sampler;
+	performance_sample* current;
+	obs_output_t*       outputs[SAMPLER_OUTPUTS];
+	bool                found[SAMPLER_OUTPUTS];
+};
+
+void PerformanceSampler::sample(void)
+{
+	performance_sample current = {};
+	current.timestamp          = os_gettime_ns();
+
+	current.cpu = std::trunc(os_cpu_usage_info_query(cpu_info) * 10) / 10;
+
+	// Outputs are replaced from the IPC thread, only read them while libobs holds its output list.
+	sample_context context = {this, &current};
+	context.outputs[SAMPLER_STREAMING]      = OBS_service::getStreamingOutput();
+	context.outputs[SAMPLER_RECORDING]      = OBS_service::getRecordingOutput();
+	context.outputs[SAMPLER_REPLAY_BUFFER]  = OBS_service::getReplayBufferOutput();
+	context.outputs[SAMPLER_VIRTUAL_WEBCAM] = OBS_service::getVirtualWebcamOutput();
+
+	obs_enum_outputs(
+	    [](void* param, obs_output_t* output) {
+		    sample_context* context = reinterpret_cast<sample_context*>(param);
+		    for (size_t idx = 0; idx < SAMPLER_OUTPUTS; idx++) {
+			    if (output != context->outputs[idx])
+				    continue;
+
+			    context->found[idx] = true;
+			    context->sampler->sampleOutput(output, idx, context->current->outputs[idx]);
+		    }
+		    return true;
+	    },
+	    &context);
+
+	// Outputs that were destroyed start over when they are created again.
+	for (size_t idx = 0; idx < SAMPLER_OUTPUTS; idx++) {
+		if (!context.found[idx])
+			resetOutput(idx);
+	}
+
+	const output_sample& streaming = current.outputs[SAMPLER_STREAMING];
+	if (streaming.active) {
+		current.dropped_frames = streaming.dropped_frames;
+		if (streaming.total_frames != 0)
+			current.dropped_frames_percent = (double)streaming.dropped_frames / streaming.total_frames * 100.0;
+	}
+
+	current.streaming_kbps = streaming.kbps;
+	current.streaming_mb   = streaming.bytes / (1024.0 * 1024.0);
+	current.recording_kbps = current.outputs[SAMPLER_RECORDING].kbps;
+	current.recording_mb   = current.outputs[SAMPLER_RECORDING].bytes / (1024.0 * 1024.0);
+
+	current.fps       = obs_get_active_fps();
+	current.render_ms = (double)obs_get_average_frame_time_ns() / 1000000.0;
+	current.memory_mb = (double)os_get_proc_resident_size() / (1024.0 * 1024.0);
+
+	if (current.timestamp >= next_disk_check) {
+		disk_free       = diskSpaceAvailable();
+		next_disk_check = current.timestamp + SAMPLER_DISK_INTERVAL_MS * 1000000ULL;
+	}
+	current.disk_free = disk_free;
+
+	std::unique_lock<std::mutex> lock(mtx);
+	current.sequence                          = ++sequence;
+	history[(sequence - 1) % SAMPLER_HISTORY] = current;
+}
+
+static video_t* OutputVideo(obs_output_t* output)
+{
+	obs_encoder_t* encoder = obs_output_get_video_encoder(output);
+	return encoder ? obs_encoder_video(encoder) : obs_output_video(output);
+}
+
+void PerformanceSampler::resetOutput(size_t kind)
+{
+	// Reconnections are counted from here, the signal is not raised while the output is stopped.
+	outputs[kind]                = output_state();
+	outputs[kind].reconnect_base = reconnects[kind];
+}
+
+void PerformanceSampler::sampleOutput(obs_output_t* output, size_t kind, output_sample& sample)
+{
+	output_state& state        = outputs[kind];
+	bool          reconnecting = obs_output_reconnecting(output);
+	if (!obs_output_active(output) && !reconnecting) {
+		resetOutput(kind);
+		return;
+	}
+
+	// Frames skipped by the encoder's video are counted from the start of the output.
+	video_t* video = OutputVideo(output);
+	if (!state.active) {
+		state.active       = true;
+		state.skipped_base = video ? video_output_get_skipped_frames(video) : 0;
+	}
+
+	uint64_t bytesSent     = obs_output_get_total_bytes(output);
+	uint64_t bytesSentTime = os_gettime_ns();
+
+	if (bytesSent < state.bytes)
+		bytesSent = 0;
+	if (bytesSent == 0)
+		state.bytes = 0;
+
+	// The first sample of an output has no reference point yet.
+	if (state.time != 0 && bytesSentTime > state.time) {
+		double timePassed = double(bytesSentTime - state.time) / 1000000000.0;
+		sample.kbps       = double((bytesSent - state.bytes) * 8) / timePassed / 1000.0;
+	}
+
+	state.bytes = bytesSent;
+	state.time  = bytesSentTime;
+
+	sample.active          = true;
+	sample.reconnecting    = reconnecting;
+	sample.bytes           = bytesSent;
+	sample.dropped_frames  = obs_output_get_frames_dropped(output);
+	sample.total_frames    = obs_output_get_total_frames(output);
+	sample.congestion      = obs_output_get_congestion(output);
+	sample.connect_time_ms = obs_output_get_connect_time_ms(output);
+	sample.reconnects      = reconnects[kind] - state.reconnect_base;
+
+	if (video) {
+		uint32_t skipped      = video_output_get_skipped_frames(video);
+		sample.skipped_frames = skipped >= state.skipped_base ? skipped - state.skipped_base : 0;
+	}
+}
+
+uint64_t PerformanceSampler::diskSpaceAvailable(void)
+{
+	std::string path;
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		path = disk_path;
+	}
+
+	if (path.empty())
+		return 0;
+
+	return os_get_free_disk_space(path.c_str());
+}
+
+void PerformanceSampler::refreshDiskPath(void)
+{
+	// Bumped by every change to basic.ini and by reloadConfig
+	uint64_t changes = ConfigManager::getInstance().getBasicChanges();
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		if (changes == disk_path_changes)
+			return;
+	}
+
+	config_t*   basic = ConfigManager::getInstance().getBasic();
+	const char* mode  = config_get_string(basic, "Output", "Mode");
+	std::string path;
+
+	if (mode && strcmp(mode, "Advanced") == 0) {
+		const char* advanced_mode = config_get_string(basic, "AdvOut", "RecType");
+
+		if (advanced_mode && strcmp(advanced_mode, "FFmpeg") == 0) {
+			path = NullToEmpty(config_get_string(basic, "AdvOut", "FFFilePath"));
+		} else {
+			path = NullToEmpty(config_get_string(basic, "AdvOut", "RecFilePath"));
+		}
+	} else {
+		path = NullToEmpty(config_get_string(basic, "SimpleOutput", "FilePath"));
+	}
+
+	std::unique_lock<std::mutex> lock(mtx);
+	disk_path         = path;
+	disk_path_changes = changes;
+}
@@ -0,0 +1,151 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <util/platform.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Cadence of the sampler, and of the metrics that are too expensive to read at that rate
+#define SAMPLER_INTERVAL_MS 500
+#define SAMPLER_DISK_INTERVAL_MS 10000
+
+// Number of samples kept, two minutes at the default cadence
+#define SAMPLER_HISTORY 240
+
+// Outputs owned by the service, in the order they are reported
+enum sampler_output
+{
+	SAMPLER_STREAMING,
+	SAMPLER_RECORDING,
+	SAMPLER_REPLAY_BUFFER,
+	SAMPLER_VIRTUAL_WEBCAM,
+	SAMPLER_OUTPUTS
+};
+
+struct output_sample
+{
+	bool     active;
+	bool     reconnecting;
+	uint64_t bytes;
+	double   kbps;
+	int32_t  dropped_frames;
+	int32_t  total_frames;
+	double   congestion;
+	int32_t  connect_time_ms;
+	uint32_t reconnects; // Reconnection attempts since the output started, counted from its "reconnect" signal
+	// Frames skipped by the video the output encodes since it started. That video is shared by every output
+	// encoding at the same resolution, usually the main one, so this is not specific to the output.
+	uint32_t skipped_frames;
+};
+
+struct performance_sample
+{
+	uint64_t sequence;
+	uint64_t timestamp;
+	double   cpu;
+	int32_t  dropped_frames;
+	double   dropped_frames_percent;
+	double   streaming_kbps;
+	double   streaming_mb;
+	double   recording_kbps;
+	double   recording_mb;
+	double   fps;
+	double   render_ms;
+	double   memory_mb;
+	uint64_t disk_free;
+
+	output_sample outputs[SAMPLER_OUTPUTS];
+};
+
+class PerformanceSampler
+{
+	public:
+	static PerformanceSampler& GetInstance()
+	{
+		static PerformanceSampler instance;
+		return instance;
+	}
+
+	private:
+	PerformanceSampler();
+	~PerformanceSampler();
+
+	public:
+	PerformanceSampler(PerformanceSampler const&) = delete;
+	void operator=(PerformanceSampler const&) = delete;
+
+	void start(void);
+	void stop(void);
+
+	// Most recent sample, zeroed if the sampler never ran.
+	performance_sample latest(void);
+
+	// Appends the retained samples newer than sequence, oldest first, and returns the latest sequence.
+	uint64_t since(uint64_t sequence, std::vector<performance_sample>& samples);
+
+	// Counts the reconnections of an output owned by the service, call it whenever the output is created.
+	void connectOutput(obs_output_t* output, sampler_output kind);
+
+	private:
+	struct output_state
+	{
+		bool     active         = false;
+		uint64_t bytes          = 0;
+		uint64_t time           = 0;
+		uint32_t reconnect_base = 0;
+		uint32_t skipped_base   = 0;
+	};
+
+	static void OutputReconnect(void* data, calldata_t* params);
+
+	void     run(void);
+	void     sample(void);
+	void     resetOutput(size_t kind);
+	void     sampleOutput(obs_output_t* output, size_t kind, output_sample& sample);
+	uint64_t diskSpaceAvailable(void);
+
+	// Copies the recording path out of basic.ini when it changed. Called from start(), latest() and since(),
+	// which run on the IPC thread where the config is safe to read; the sampler thread only uses the copy.
+	void refreshDiskPath(void);
+
+	// Only touched by the sampler thread, so every poller sees the same bitrate.
+	os_cpu_usage_info_t* cpu_info;
+	output_state         outputs[SAMPLER_OUTPUTS];
+	uint64_t             disk_free;
+	uint64_t             next_disk_check;
+
+	// Raised by the "reconnect" signal on the output threads, never reset.
+	std::atomic<uint32_t> reconnects[SAMPLER_OUTPUTS];
+
+	std::thread             worker;
+	std::condition_variable cv;
+	bool                    stopping;
+
+	// Guards the ring buffer and the recording path.
+	std::mutex         mtx;
+	performance_sample history[SAMPLER_HISTORY];
+	uint64_t           sequence;
+	std::string        disk_path;
+	uint64_t           disk_path_changes;
+};
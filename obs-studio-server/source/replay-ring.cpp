@@ -0,0 +1,299 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "replay-ring.h"
+#include <algorithm>
+#include <cstring>
+#ifdef WIN32
+#include <util/platform.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Written pages are dropped from the working set by chunks of this size
+static constexpr uint64_t RELEASE_CHUNK = 16 * 1024 * 1024;
+
+MappedRingFile::~MappedRingFile()
+{
+	close();
+}
+
+bool MappedRingFile::open(const std::string& path, uint64_t size)
+{
+	close();
+
+#ifdef WIN32
+	wchar_t* wpath = nullptr;
+	if (!os_utf8_to_wcs_ptr(path.c_str(), 0, &wpath))
+		return false;
+
+	HANDLE handle = CreateFileW(
+	    wpath,
+	    GENERIC_READ | GENERIC_WRITE,
+	    0,
+	    nullptr,
+	    CREATE_ALWAYS,
+	    FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+	    nullptr);
+	bfree(wpath);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+
+	// Creating the mapping extends the file to its full size
+	HANDLE map = CreateFileMappingW(handle, nullptr, PAGE_READWRITE, DWORD(size >> 32), DWORD(size), nullptr);
+	if (!map) {
+		CloseHandle(handle);
+		return false;
+	}
+
+	view = reinterpret_cast<uint8_t*>(MapViewOfFile(map, FILE_MAP_ALL_ACCESS, 0, 0, size_t(size)));
+	if (!view) {
+		CloseHandle(map);
+		CloseHandle(handle);
+		return false;
+	}
+	file    = handle;
+	mapping = map;
+#else
+	fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if (fd < 0)
+		return false;
+
+#ifdef __linux__
+	bool allocated = posix_fallocate(fd, 0, off_t(size)) == 0;
+#else
+	bool allocated = ftruncate(fd, off_t(size)) == 0;
+#endif
+	void* addr = allocated ? mmap(nullptr, size_t(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+	if (addr == MAP_FAILED) {
+		::close(fd);
+		unlink(path.c_str());
+		fd = -1;
+		return false;
+	}
+	view = reinterpret_cast<uint8_t*>(addr);
+#endif
+
+	this->path = path;
+	length     = size;
+	return true;
+}
+
+void MappedRingFile::close()
+{
+	if (!view)
+		return;
+
+#ifdef WIN32
+	// The file was opened with FILE_FLAG_DELETE_ON_CLOSE
+	UnmapViewOfFile(view);
+	CloseHandle(mapping);
+	CloseHandle(file);
+	mapping = nullptr;
+	file    = nullptr;
+#else
+	munmap(view, size_t(length));
+	::close(fd);
+	unlink(path.c_str());
+	fd = -1;
+#endif
+	view   = nullptr;
+	length = 0;
+}
+
+bool MappedRingFile::isOpen() const
+{
+	return view != nullptr;
+}
+
+uint64_t MappedRingFile::size() const
+{
+	return length;
+}
+
+uint8_t* MappedRingFile::data() const
+{
+	return view;
+}
+
+void MappedRingFile::release(uint64_t offset, uint64_t size)
+{
+	if (!view || !size)
+		return;
+
+#ifdef WIN32
+	// Unlocking pages that are not locked removes them from the working set
+	VirtualUnlock(view + offset, size_t(size));
+#else
+	// Only whole pages can be dropped, the partial ones are dropped with the next range
+	uint64_t page  = uint64_t(sysconf(_SC_PAGESIZE));
+	uint64_t begin = (offset + page - 1) / page * page;
+	uint64_t end   = (offset + size) / page * page;
+	if (end > begin)
+		madvise(view + begin, size_t(end - begin), MADV_DONTNEED);
+#endif
+}
+
+bool ReplayRing::open(const std::string& path, uint64_t memoryBudget, uint64_t diskBudget, int64_t windowUsec)
+{
+	close();
+
+	memory_max  = memoryBudget;
+	window_usec = windowUsec;
+	return ring.open(path, diskBudget);
+}
+
+void ReplayRing::close()
+{
+	ring.close();
+	entries.clear();
+	first_seq  = 0;
+	head_index = 0;
+	head_bytes = 0;
+	disk_bytes = 0;
+	write_pos  = 0;
+	released   = 0;
+}
+
+void ReplayRing::push(const replay_packet& packet, const uint8_t* data)
+{
+	entry e;
+	e.packet  = packet;
+	e.offset  = 0;
+	e.on_disk = false;
+	e.data.assign(data, data + packet.size);
+	entries.push_back(std::move(e));
+	head_bytes += packet.size;
+
+	trimWindow();
+
+	while (head_bytes > memory_max && head_index < entries.size())
+		spill();
+}
+
+void ReplayRing::evictFront()
+{
+	entry& front = entries.front();
+	if (front.on_disk)
+		disk_bytes -= front.packet.size;
+	else
+		head_bytes -= front.packet.size;
+
+	entries.pop_front();
+	first_seq++;
+	if (head_index > 0)
+		head_index--;
+}
+
+void ReplayRing::trimWindow()
+{
+	if (window_usec <= 0)
+		return;
+
+	int64_t newest = entries.back().packet.dts_usec;
+	while (entries.size() > 1 && newest - entries.front().packet.dts_usec > window_usec)
+		evictFront();
+}
+
+void ReplayRing::spill()
+{
+	entry&   e        = entries[head_index];
+	uint64_t size     = e.packet.size;
+	uint64_t capacity = ring.size();
+
+	if (size > capacity) {
+		// Cannot be kept on disk, the window restarts after this packet
+		for (size_t count = head_index + 1; count > 0; count--)
+			evictFront();
+		return;
+	}
+
+	if (write_pos + size > capacity) {
+		// Free the tail of the file before wrapping, it holds the oldest packets
+		while (head_index > 0 && entries.front().offset >= write_pos)
+			evictFront();
+
+		ring.release(released, capacity - released);
+		write_pos = 0;
+		released  = 0;
+	}
+
+	while (head_index > 0 && entries.front().offset < write_pos + size
+	       && entries.front().offset + entries.front().packet.size > write_pos)
+		evictFront();
+
+	entry& spilled = entries[head_index];
+	memcpy(ring.data() + write_pos, spilled.data.data(), size_t(size));
+	spilled.offset  = write_pos;
+	spilled.on_disk = true;
+	std::vector<uint8_t>().swap(spilled.data);
+
+	write_pos += size;
+	head_bytes -= size;
+	disk_bytes += size;
+	head_index++;
+
+	if (write_pos - released >= RELEASE_CHUNK) {
+		ring.release(released, write_pos - released);
+		released = write_pos;
+	}
+}
+
+uint64_t ReplayRing::firstKeyframe() const
+{
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (entries[i].packet.video && entries[i].packet.keyframe)
+			return first_seq + i;
+	}
+	return first_seq + entries.size();
+}
+
+uint64_t ReplayRing::nextSequence() const
+{
+	return first_seq + entries.size();
+}
+
+bool ReplayRing::read(uint64_t& seq, replay_packet& packet, std::vector<uint8_t>& data)
+{
+	seq = std::max(seq, first_seq);
+	if (seq >= first_seq + entries.size())
+		return false;
+
+	const entry& e = entries[size_t(seq - first_seq)];
+	packet         = e.packet;
+	if (e.on_disk)
+		data.assign(ring.data() + e.offset, ring.data() + e.offset + e.packet.size);
+	else
+		data = e.data;
+
+	seq++;
+	return true;
+}
+
+uint64_t ReplayRing::memoryUsage() const
+{
+	return head_bytes;
+}
+
+uint64_t ReplayRing::diskUsage() const
+{
+	return disk_bytes;
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+struct replay_packet
+{
+	int64_t  pts;
+	int64_t  dts;
+	int64_t  dts_usec;
+	int32_t  timebase_num;
+	int32_t  timebase_den;
+	uint32_t size;
+	uint8_t  video;
+	uint8_t  keyframe;
+	uint8_t  track;
+};
+
+/*!
+* \brief Fixed size file mapped in memory, written as a ring.
+*
+* The file is preallocated on open and removed on close. Pages that were
+* written are dropped from the working set, the data stays in the file.
+*/
+class MappedRingFile
+{
+	public:
+	MappedRingFile() {}
+	~MappedRingFile();
+
+	MappedRingFile(MappedRingFile const&) = delete;
+	void operator=(MappedRingFile const&) = delete;
+
+	bool open(const std::string& path, uint64_t size);
+	void close();
+
+	bool     isOpen() const;
+	uint64_t size() const;
+	uint8_t* data() const;
+
+	// Drop a written range from the working set of the process
+	void release(uint64_t offset, uint64_t size);
+
+	private:
+	std::string path;
+	uint64_t    length = 0;
+	uint8_t*    view   = nullptr;
+#ifdef WIN32
+	void* file    = nullptr;
+	void* mapping = nullptr;
+#else
+	int fd = -1;
+#endif
+};
+
+/*!
+* \brief Encoded packets of a replay window, newest in memory, older on disk.
+*
+* Packets enter an in-memory head. Once the head grows over its budget the
+* oldest packets spill to the ring file, where they are evicted when the
+* ring wraps over them or when they leave the replay window.
+*/
+class ReplayRing
+{
+	public:
+	bool open(const std::string& path, uint64_t memoryBudget, uint64_t diskBudget, int64_t windowUsec);
+	void close();
+
+	void push(const replay_packet& packet, const uint8_t* data);
+
+	/*!
+	* Copies the packets of the window starting at the first video
+	* keyframe, for the packet with sequence number >= seq. Returns false
+	* once no packet is left. Packets evicted in the meantime are skipped.
+	*/
+	bool read(uint64_t& seq, replay_packet& packet, std::vector<uint8_t>& data);
+
+	// Sequence number of the first video keyframe still held, or of the next packet if there is none
+	uint64_t firstKeyframe() const;
+	uint64_t nextSequence() const;
+
+	uint64_t memoryUsage() const;
+	uint64_t diskUsage() const;
+
+	private:
+	struct entry
+	{
+		replay_packet        packet;
+		uint64_t             offset;
+		bool                 on_disk;
+		std::vector<uint8_t> data;
+	};
+
+	void spill();
+	void evictFront();
+	void trimWindow();
+
+	MappedRingFile    ring;
+	std::deque<entry> entries;
+	uint64_t          first_seq = 0;
+
+	// Index in entries of the oldest packet still in memory
+	size_t   head_index  = 0;
+	uint64_t head_bytes  = 0;
+	uint64_t disk_bytes  = 0;
+	uint64_t write_pos   = 0;
+	uint64_t released    = 0;
+	uint64_t memory_max  = 0;
+	int64_t  window_usec = 0;
+};
@@ -0,0 +1,233 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#include "source-profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <util/profiler.h>
+
+// Graphics thread scopes of libobs reported as costs, they are nested below the thread's root.
+static const char* const profiled_roots    = "obs_graphics_thread";
+static const char* const profiled_scopes[] = {"tick_sources", "render_main_texture"};
+
+SourceProfiler::SourceProfiler() : running(false) {}
+
+SourceProfiler::~SourceProfiler() {}
+
+void SourceProfiler::initialize(void)
+{
+	profiler_start();
+}
+
+void SourceProfiler::finalize(void)
+{
+	profiler_stop();
+	profiler_free();
+}
+
+void SourceProfiler::start(void)
+{
+	if (running.exchange(true))
+		return;
+
+	// Scopes are reported from now on, not since libobs started.
+	reset();
+}
+
+void SourceProfiler::stop(void)
+{
+	if (!running.exchange(false))
+		return;
+
+	reset();
+}
+
+bool SourceProfiler::enabled(void)
+{
+	return running;
+}
+
+void SourceProfiler::record(obs_source_t* source, uint64_t elapsed_ns)
+{
+	if (!running || !source)
+		return;
+
+	std::unique_lock<std::mutex> lock(mtx);
+	auto                         found = entries.find(source);
+
+	// A destroyed source's address can be reused by a new one.
+	if (found != entries.end() && !obs_weak_source_references_source(found->second.weak, source)) {
+		obs_weak_source_release(found->second.weak);
+		entries.erase(found);
+		found = entries.end();
+	}
+
+	if (found == entries.end()) {
+		entry created = {};
+		created.weak  = obs_source_get_weak_source(source);
+		found         = entries.emplace(source, created).first;
+	}
+
+	entry& current = found->second;
+	current.timings[current.count % SOURCE_PROFILER_WINDOW] = uint32_t(std::min<uint64_t>(elapsed_ns, UINT32_MAX));
+	current.count++;
+}
+
+static bool CollectScopes(void* param, profiler_snapshot_entry_t* entry)
+{
+	auto*       scopes = static_cast<std::map<std::string, std::map<uint64_t, uint64_t>>*>(param);
+	const char* name   = profiler_snapshot_entry_name(entry);
+
+	for (const char* scope : profiled_scopes) {
+		if (!name || strcmp(name, scope) != 0)
+			continue;
+
+		profiler_time_entries_t*      times  = profiler_snapshot_entry_times(entry);
+		std::map<uint64_t, uint64_t>& target = (*scopes)[scope];
+		for (size_t idx = 0; times && idx < times->num; idx++)
+			target[times->array[idx].time_delta] += times->array[idx].count;
+	}
+
+	profiler_snapshot_enumerate_children(entry, CollectScopes, param);
+	return true;
+}
+
+void SourceProfiler::snapshot(std::map<std::string, histogram>& scopes)
+{
+	profiler_snapshot_t* snap = profile_snapshot_create();
+	if (!snap)
+		return;
+
+	profiler_snapshot_enumerate_roots(
+	    snap,
+	    [](void* param, profiler_snapshot_entry_t* root) {
+		    const char* name = profiler_snapshot_entry_name(root);
+		    if (name && strncmp(name, profiled_roots, strlen(profiled_roots)) == 0)
+			    profiler_snapshot_enumerate_children(root, CollectScopes, param);
+		    return true;
+	    },
+	    &scopes);
+	profile_snapshot_free(snap);
+}
+
+std::vector<source_cost> SourceProfiler::costs(void)
+{
+	std::vector<source_cost>         costs;
+	std::vector<uint32_t>            timings;
+	std::vector<obs_source_t*>       alive;
+	std::map<std::string, histogram> scopes;
+
+	if (!running)
+		return costs;
+
+	snapshot(scopes);
+
+	std::unique_lock<std::mutex> lock(mtx);
+	for (auto it = entries.begin(); it != entries.end();) {
+		entry&        current = it->second;
+		obs_source_t* source  = obs_weak_source_get_source(current.weak);
+
+		// Forget the sources that were destroyed since they were last drawn.
+		if (!source) {
+			obs_weak_source_release(current.weak);
+			it = entries.erase(it);
+			continue;
+		}
+		alive.push_back(source);
+		++it;
+
+		size_t count = std::min<size_t>(current.count, SOURCE_PROFILER_WINDOW);
+		timings.assign(current.timings, current.timings + count);
+		std::sort(timings.begin(), timings.end());
+
+		uint64_t total = 0;
+		for (uint32_t timing : timings)
+			total += timing;
+
+		size_t p99 = size_t(std::ceil(count * 0.99)) - 1;
+
+		source_cost cost;
+		cost.name    = obs_source_get_name(source);
+		cost.id      = obs_source_get_id(source);
+		cost.type    = obs_source_get_type(source);
+		cost.samples = current.count;
+		cost.min_ms  = timings.front() / 1000000.0;
+		cost.avg_ms  = double(total) / count / 1000000.0;
+		cost.p99_ms  = timings[p99] / 1000000.0;
+		costs.push_back(cost);
+	}
+
+	// The libobs histograms count every call since it started, the previous snapshot is subtracted.
+	for (auto& scope : scopes) {
+		histogram& previous = baseline[scope.first];
+		uint64_t   count = 0, total = 0;
+		for (auto& bucket : scope.second) {
+			uint64_t calls = bucket.second - std::min(bucket.second, previous[bucket.first]);
+			previous[bucket.first] = bucket.second;
+			bucket.second          = calls;
+			count += calls;
+			total += bucket.first * calls;
+		}
+		if (!count)
+			continue;
+
+		uint64_t needed = uint64_t(std::ceil(count * 0.99)), seen = 0, min = 0, p99 = 0;
+		for (auto& bucket : scope.second) {
+			if (!bucket.second)
+				continue;
+			if (!seen)
+				min = bucket.first;
+			seen += bucket.second;
+			if (seen >= needed) {
+				p99 = bucket.first;
+				break;
+			}
+		}
+
+		source_cost cost;
+		cost.name    = scope.first;
+		cost.type    = OBS_SOURCE_TYPE_SCENE;
+		cost.samples = uint32_t(std::min<uint64_t>(count, UINT32_MAX));
+		cost.min_ms  = min / 1000.0;
+		cost.avg_ms  = double(total) / count / 1000.0;
+		cost.p99_ms  = p99 / 1000.0;
+		costs.push_back(cost);
+	}
+	lock.unlock();
+
+	// Dropping the last reference destroys the source, which must not happen with the lock held.
+	for (obs_source_t* source : alive)
+		obs_source_release(source);
+
+	std::sort(costs.begin(), costs.end(), [](const source_cost& a, const source_cost& b) {
+		return a.avg_ms > b.avg_ms;
+	});
+	return costs;
+}
+
+void SourceProfiler::reset(void)
+{
+	std::map<std::string, histogram> scopes;
+	snapshot(scopes);
+
+	std::unique_lock<std::mutex> lock(mtx);
+	for (auto& item : entries)
+		obs_weak_source_release(item.second.weak);
+	entries.clear();
+	baseline = scopes;
+}
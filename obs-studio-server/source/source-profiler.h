@@ -0,0 +1,98 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+#pragma once
+#include <obs.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Number of render timings kept per source
+#define SOURCE_PROFILER_WINDOW 128
+
+// Costs are taken from the real tick and render paths, nothing is rendered twice, so the profiler stays enabled.
+// libobs 26 has no scope per source, the graphics thread scopes of its profiler give the frame wide costs:
+// tick_sources is the video_tick of every source and render_main_texture the canvas with its scenes, items
+// and filters. The sources drawn by our own displays are timed around their obs_source_video_render call.
+// Timings are taken on the graphics thread, so they measure the CPU time spent submitting draw calls, not
+// the time the GPU takes to execute them.
+struct source_cost
+{
+	std::string     name;
+	std::string     id; // Empty for the libobs scopes
+	obs_source_type type;
+	uint32_t        samples;
+	double          min_ms;
+	double          avg_ms;
+	double          p99_ms;
+};
+
+class SourceProfiler
+{
+	public:
+	static SourceProfiler& GetInstance()
+	{
+		static SourceProfiler instance;
+		return instance;
+	}
+
+	private:
+	SourceProfiler();
+	~SourceProfiler();
+
+	public:
+	SourceProfiler(SourceProfiler const&) = delete;
+	void operator=(SourceProfiler const&) = delete;
+
+	// The libobs profiler only records threads started after it, so these wrap obs_startup and obs_shutdown.
+	static void initialize(void);
+	static void finalize(void);
+
+	void start(void);
+	void stop(void);
+	bool enabled(void);
+
+	// Called by the graphics thread with the time a display took to render its source.
+	void record(obs_source_t* source, uint64_t elapsed_ns);
+
+	// Cost of every timed source and scope, most expensive first. The scopes cover the frames rendered since
+	// the previous call or reset, the sources their last SOURCE_PROFILER_WINDOW renders.
+	std::vector<source_cost> costs(void);
+	void                     reset(void);
+
+	private:
+	struct entry
+	{
+		obs_weak_source_t* weak;
+		uint32_t           timings[SOURCE_PROFILER_WINDOW];
+		uint32_t           count;
+	};
+
+	// Number of calls per duration in microseconds, as the libobs profiler stores them.
+	typedef std::map<uint64_t, uint64_t> histogram;
+
+	void snapshot(std::map<std::string, histogram>& scopes);
+
+	std::atomic<bool> running;
+
+	// Guards entries and baseline, the graphics thread only holds it to store a timing.
+	std::mutex                       mtx;
+	std::map<obs_source_t*, entry>   entries;
+	std::map<std::string, histogram> baseline;
+};
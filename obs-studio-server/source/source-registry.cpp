@@ -0,0 +1,164 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "source-registry.h"
+#include <algorithm>
+
+void SourceRegistry::add(obs_source_t* source)
+{
+	const char* id   = obs_source_get_id(source);
+	const char* name = obs_source_get_name(source);
+
+	source_entry entry;
+	entry.id    = id ? id : "";
+	entry.name  = name ? name : "";
+	entry.type  = obs_source_get_type(source);
+	entry.flags = obs_source_get_output_flags(source);
+
+	std::unique_lock<std::mutex> lock(mtx);
+	entry.order = next_order++;
+
+	by_type[entry.id].insert(source);
+	for (uint32_t flag = 1; flag <= SOURCE_REGISTRY_FLAGS; flag <<= 1) {
+		if ((SOURCE_REGISTRY_FLAGS & flag) && (entry.flags & flag))
+			by_flag[flag].insert(source);
+	}
+	if (!entry.name.empty())
+		by_name[entry.name] = source;
+
+	sources[source] = std::move(entry);
+}
+
+void SourceRegistry::remove(obs_source_t* source)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+
+	auto it = sources.find(source);
+	if (it == sources.end())
+		return;
+
+	auto type = by_type.find(it->second.id);
+	if (type != by_type.end()) {
+		type->second.erase(source);
+		if (type->second.empty())
+			by_type.erase(type);
+	}
+	for (auto& flag : by_flag)
+		flag.second.erase(source);
+
+	auto name = by_name.find(it->second.name);
+	if (name != by_name.end() && name->second == source)
+		by_name.erase(name);
+
+	sources.erase(it);
+}
+
+void SourceRegistry::rename(obs_source_t* source, const char* name)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+
+	auto it = sources.find(source);
+	if (it == sources.end())
+		return;
+
+	auto previous = by_name.find(it->second.name);
+	if (previous != by_name.end() && previous->second == source)
+		by_name.erase(previous);
+
+	it->second.name = name ? name : "";
+	if (!it->second.name.empty())
+		by_name[it->second.name] = source;
+}
+
+bool SourceRegistry::hasType(const std::string& id)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	return by_type.find(id) != by_type.end();
+}
+
+obs_source_t* SourceRegistry::findByName(const std::string& name)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+
+	auto it = by_name.find(name);
+	if (it == by_name.end() || obs_source_removed(it->second))
+		return nullptr;
+
+	return it->second;
+}
+
+std::vector<obs_source_t*>
+    SourceRegistry::enumerate(const std::string& id, uint32_t flags, int32_t type, bool groups)
+{
+	std::vector<std::pair<uint64_t, obs_source_t*>> found;
+
+	auto matches = [&](obs_source_t* source, const source_entry& entry) {
+		if ((entry.flags & flags) != flags)
+			return false;
+		if (type >= 0 && entry.type != obs_source_type(type) && !(groups && entry.id == "group"))
+			return false;
+		if (obs_source_removed(source))
+			return false;
+		return true;
+	};
+
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+
+		// Start from the smallest index the filters allow
+		const std::unordered_set<obs_source_t*>* candidates = nullptr;
+		if (!id.empty()) {
+			auto it = by_type.find(id);
+			if (it == by_type.end())
+				return {};
+			candidates = &it->second;
+		}
+		for (uint32_t flag = 1; flag <= SOURCE_REGISTRY_FLAGS; flag <<= 1) {
+			if (!(SOURCE_REGISTRY_FLAGS & flag) || !(flags & flag))
+				continue;
+			auto it = by_flag.find(flag);
+			if (it == by_flag.end())
+				return {};
+			if (!candidates || it->second.size() < candidates->size())
+				candidates = &it->second;
+		}
+
+		if (candidates) {
+			found.reserve(candidates->size());
+			for (obs_source_t* source : *candidates) {
+				const source_entry& entry = sources[source];
+				if ((id.empty() || entry.id == id) && matches(source, entry))
+					found.emplace_back(entry.order, source);
+			}
+		} else {
+			found.reserve(sources.size());
+			for (auto& source : sources) {
+				if (matches(source.first, source.second))
+					found.emplace_back(source.second.order, source.first);
+			}
+		}
+	}
+
+	std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+	std::vector<obs_source_t*> result;
+	result.reserve(found.size());
+	for (auto& source : found)
+		result.push_back(source.second);
+	return result;
+}
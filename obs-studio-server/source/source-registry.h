@@ -0,0 +1,79 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Output flags the registry keeps a separate index for
+#define SOURCE_REGISTRY_FLAGS (OBS_SOURCE_VIDEO | OBS_SOURCE_AUDIO | OBS_SOURCE_ASYNC)
+
+struct source_entry
+{
+	std::string     id;
+	std::string     name;
+	obs_source_type type;
+	uint32_t        flags;
+	uint64_t        order;
+};
+
+// Public sources indexed by type id, output flags and name. Fed from the global
+// source_create, source_rename and per-source destroy signals so lookups never
+// have to walk the libobs source list.
+class SourceRegistry
+{
+	public:
+	static SourceRegistry& GetInstance()
+	{
+		static SourceRegistry instance;
+		return instance;
+	}
+
+	private:
+	SourceRegistry(){};
+
+	public:
+	SourceRegistry(SourceRegistry const&) = delete;
+	void operator=(SourceRegistry const&) = delete;
+
+	private:
+	std::mutex                                                          mtx;
+	uint64_t                                                            next_order = 0;
+	std::unordered_map<obs_source_t*, source_entry>                     sources;
+	std::unordered_map<std::string, std::unordered_set<obs_source_t*>>  by_type;
+	std::unordered_map<uint32_t, std::unordered_set<obs_source_t*>>     by_flag;
+	std::unordered_map<std::string, obs_source_t*>                      by_name;
+
+	public:
+	void add(obs_source_t* source);
+	void remove(obs_source_t* source);
+	void rename(obs_source_t* source, const char* name);
+
+	bool          hasType(const std::string& id);
+	obs_source_t* findByName(const std::string& name);
+
+	// Sources matching every given filter, newest first like obs_enum_sources.
+	// An empty id, a zero flag mask or a negative type leave that filter out.
+	// With groups set, groups pass the type filter too. Filtering is done on the
+	// registry's copy of the source data, under its lock.
+	std::vector<obs_source_t*> enumerate(const std::string& id, uint32_t flags, int32_t type, bool groups = false);
+};
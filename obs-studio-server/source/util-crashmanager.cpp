@@ -48,6 +48,7 @@
 #endif
 
 #include "nodeobs_api.h"
+#include "nodeobs_configManager.hpp"
 #include "error.hpp"
 #include "shared.hpp"
 
@@ -411,6 +412,10 @@ void util::CrashManager::HandleCrash(std::string _crashInfo, bool callAbort) noe
 	SaveToAppStateFile();
 
 	insideCrashMethod = true;
+
+	// Write out settings still waiting on the debounce timer. This is skipped when the
+	// crashing thread is the one saving, and never waits on another thread's save.
+	ConfigManager::getInstance().flush(false);
 	annotations.clear();
 	// This will manually rewind the callstack, we will use this info to populate an
 	// crash report attribute, avoiding some cases that the memory dump is corrupted
@@ -17,11 +17,16 @@
 ******************************************************************************/
 
 #pragma once
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <list>
 #include <map>
 #include <mutex>
+#include <set>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #if defined(_MSC_VER)
 #define __PRETTY_FUNCTION__ __FUNCSIG__
@@ -75,13 +80,24 @@ namespace utility
 		std::list<range_t> allocated;
 	};
 
+	// Appends the raw bytes of a value to a binary IPC payload.
+	template<typename T>
+	inline void append_binary(std::vector<char>& buffer, const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be appended.");
+		size_t offset = buffer.size();
+		buffer.resize(offset + sizeof(T));
+		std::memcpy(buffer.data() + offset, &value, sizeof(T));
+	}
+
 	template<typename T>
 	class unique_object_manager
 	{
 		protected:
-		utility::unique_id                     id_generator;
-		std::map<utility::unique_id::id_t, T*> object_map;
-		std::recursive_mutex                   internal_mutex;
+		utility::unique_id                                         id_generator;
+		std::map<utility::unique_id::id_t, T*>                     object_map;
+		std::unordered_map<T*, std::set<utility::unique_id::id_t>> reverse_map;
+		std::recursive_mutex                                       internal_mutex;
 
 		public:
 		unique_object_manager() {}
@@ -99,6 +115,8 @@ namespace utility
 				return uid;
 			}
 			object_map.insert_or_assign(uid, obj);
+			// An object registered twice keeps all its ids, lookups return the lowest one.
+			reverse_map[obj].insert(uid);
 			return uid;
 		}
 
@@ -106,10 +124,9 @@ namespace utility
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					return kv.first;
-				}
+			auto iter = reverse_map.find(obj);
+			if (iter != reverse_map.end()) {
+				return *iter->second.begin();
 			}
 			return std::numeric_limits<utility::unique_id::id_t>::max();
 		}
@@ -128,13 +145,15 @@ namespace utility
 		{
 			std::lock_guard<std::recursive_mutex> lock(internal_mutex);
 
-			utility::unique_id::id_t uid = std::numeric_limits<utility::unique_id::id_t>::max();
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					uid = kv.first;
-					object_map.erase(kv.first);
-					break;
-				}
+			auto iter = reverse_map.find(obj);
+			if (iter == reverse_map.end()) {
+				return std::numeric_limits<utility::unique_id::id_t>::max();
+			}
+			utility::unique_id::id_t uid = *iter->second.begin();
+			object_map.erase(uid);
+			iter->second.erase(iter->second.begin());
+			if (iter->second.empty()) {
+				reverse_map.erase(iter);
 			}
 			return uid;
 		}
@@ -148,6 +167,14 @@ namespace utility
 			}
 			T* obj = iter->second;
 			object_map.erase(iter);
+
+			auto rev = reverse_map.find(obj);
+			if (rev != reverse_map.end()) {
+				rev->second.erase(id);
+				if (rev->second.empty()) {
+					reverse_map.erase(rev);
+				}
+			}
 			return obj;
 		}
 
@@ -166,6 +193,7 @@ namespace utility
         void clear()
         {
             object_map.clear();
+            reverse_map.clear();
         }
 	};
 
@@ -0,0 +1,62 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+
+// Wire format of SceneItem::ApplyTransforms, shared by the client and the server.
+// The request is a packed array of records, one per item. Only the fields flagged in
+// the mask are applied. The reply uses the same layout with every field resolved.
+namespace sceneitem_transform
+{
+	enum field : uint32_t
+	{
+		Position        = 1 << 0,
+		Scale           = 1 << 1,
+		Rotation        = 1 << 2,
+		Crop            = 1 << 3,
+		Bounds          = 1 << 4,
+		Alignment       = 1 << 5,
+		BoundsAlignment = 1 << 6,
+		BoundsType      = 1 << 7,
+
+		All = Position | Scale | Rotation | Crop | Bounds | Alignment | BoundsAlignment | BoundsType,
+	};
+
+	struct record
+	{
+		uint64_t id;
+		uint32_t mask;
+		uint32_t alignment;
+		float    position_x;
+		float    position_y;
+		float    scale_x;
+		float    scale_y;
+		float    rotation;
+		float    bounds_x;
+		float    bounds_y;
+		uint32_t bounds_alignment;
+		int32_t  bounds_type;
+		int32_t  crop_left;
+		int32_t  crop_top;
+		int32_t  crop_right;
+		int32_t  crop_bottom;
+		uint32_t reserved;
+	};
+	static_assert(sizeof(record) == 72, "sceneitem_transform::record must keep its wire size");
+} // namespace sceneitem_transform
@@ -0,0 +1,311 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "shared-frame.hpp"
+#include <algorithm>
+#include <cstring>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const size_t pixel_alignment = 64;
+
+static size_t align(size_t value)
+{
+	return (value + pixel_alignment - 1) & ~(pixel_alignment - 1);
+}
+
+size_t shared_frame::mapping_size(uint32_t max_width, uint32_t max_height)
+{
+	return align(sizeof(header)) + slot_count * align(size_t(max_width) * 4 * max_height);
+}
+
+#ifdef WIN32
+static std::wstring mapping_name(const std::string& name)
+{
+	std::string local = "Local\\" + name;
+	return std::wstring(local.begin(), local.end());
+}
+#else
+static std::string mapping_name(const std::string& name)
+{
+	return "/" + name;
+}
+#endif
+
+shared_frame::mapping::~mapping()
+{
+	close();
+}
+
+bool shared_frame::mapping::create(const std::string& new_name, size_t size)
+{
+	close();
+
+#ifdef WIN32
+	handle = CreateFileMappingW(
+	    INVALID_HANDLE_VALUE,
+	    NULL,
+	    PAGE_READWRITE,
+	    DWORD(uint64_t(size) >> 32),
+	    DWORD(size & 0xFFFFFFFF),
+	    mapping_name(new_name).c_str());
+	if (!handle || GetLastError() == ERROR_ALREADY_EXISTS) {
+		close();
+		return false;
+	}
+
+	view = static_cast<uint8_t*>(MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size));
+#else
+	int fd = shm_open(mapping_name(new_name).c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0)
+		return false;
+
+	name  = new_name;
+	owner = true;
+	if (ftruncate(fd, off_t(size)) != 0) {
+		::close(fd);
+		close();
+		return false;
+	}
+
+	void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	view = ptr != MAP_FAILED ? static_cast<uint8_t*>(ptr) : nullptr;
+#endif
+	if (!view) {
+		close();
+		return false;
+	}
+
+	name   = new_name;
+	owner  = true;
+	length = size;
+	return true;
+}
+
+bool shared_frame::mapping::open(const std::string& existing_name)
+{
+	close();
+
+#ifdef WIN32
+	handle = OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, mapping_name(existing_name).c_str());
+	if (!handle)
+		return false;
+
+	view = static_cast<uint8_t*>(MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+	MEMORY_BASIC_INFORMATION info;
+	if (view && VirtualQuery(view, &info, sizeof(info)) == sizeof(info))
+		length = info.RegionSize;
+#else
+	int fd = shm_open(mapping_name(existing_name).c_str(), O_RDWR, 0600);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) == 0 && info.st_size > 0) {
+		void* ptr = mmap(nullptr, size_t(info.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (ptr != MAP_FAILED) {
+			view   = static_cast<uint8_t*>(ptr);
+			length = size_t(info.st_size);
+		}
+	}
+	::close(fd);
+#endif
+	if (!view || length < sizeof(header) || get_header()->magic != magic || get_header()->version != version
+	    || length < mapping_size(get_header()->max_width, get_header()->max_height)) {
+		close();
+		return false;
+	}
+
+	name = existing_name;
+	return true;
+}
+
+void shared_frame::mapping::close()
+{
+#ifdef WIN32
+	if (view)
+		UnmapViewOfFile(view);
+	if (handle)
+		CloseHandle(handle);
+	handle = nullptr;
+#else
+	if (view)
+		munmap(view, length);
+	if (owner)
+		shm_unlink(mapping_name(name).c_str());
+#endif
+	view   = nullptr;
+	length = 0;
+	owner  = false;
+	name.clear();
+}
+
+shared_frame::header* shared_frame::mapping::get_header() const
+{
+	return reinterpret_cast<header*>(view);
+}
+
+uint8_t* shared_frame::mapping::data() const
+{
+	return view;
+}
+
+size_t shared_frame::mapping::size() const
+{
+	return length;
+}
+
+bool shared_frame::writer::init(mapping& memory, uint32_t max_width, uint32_t max_height)
+{
+	if (!memory.data() || memory.size() < mapping_size(max_width, max_height))
+		return false;
+
+	hdr  = memory.get_header();
+	base = memory.data();
+
+	hdr->magic       = magic;
+	hdr->format      = RGBA8;
+	hdr->max_width   = max_width;
+	hdr->max_height  = max_height;
+	hdr->slot_size   = align(size_t(max_width) * 4 * max_height);
+	hdr->reader_slot = 2;
+	hdr->state.store(0, std::memory_order_relaxed);
+	hdr->published.store(0, std::memory_order_relaxed);
+	for (uint32_t idx = 0; idx < slot_count; idx++) {
+		memset(&hdr->slots[idx], 0, sizeof(slot));
+		hdr->slots[idx].offset = align(sizeof(header)) + idx * hdr->slot_size;
+	}
+	back  = 1;
+	last  = slot_count;
+	frame = 0;
+
+	// Written last, a reader never sees a valid magic and version with half a header.
+	std::atomic_thread_fence(std::memory_order_release);
+	hdr->version = version;
+	return true;
+}
+
+void shared_frame::writer::publish(
+    const uint8_t* pixels,
+    uint32_t       linesize,
+    uint32_t       width,
+    uint32_t       height,
+    uint64_t       timestamp)
+{
+	if (!hdr)
+		return;
+
+	width  = std::min(width, hdr->max_width);
+	height = std::min(height, hdr->max_height);
+
+	slot&    target = hdr->slots[back];
+	uint8_t* dst    = base + target.offset;
+	uint32_t stride = width * 4;
+
+	// The previous frame is either the shared slot or the one the reader holds, the reader only
+	// reads it, so it can be compared while the new frame is copied.
+	const slot*    previous = last < slot_count ? &hdr->slots[last] : nullptr;
+	const uint8_t* old      = nullptr;
+	if (previous && previous->width == width && previous->height == height)
+		old = base + previous->offset;
+
+	uint32_t top = height, bottom = 0, left = width, right = 0;
+	for (uint32_t y = 0; y < height; y++) {
+		const uint8_t* src = pixels + size_t(y) * linesize;
+		uint8_t*       row = dst + size_t(y) * stride;
+
+		if (old) {
+			const uint8_t* prev = old + size_t(y) * stride;
+			if (memcmp(src, prev, stride) != 0) {
+				// Only scan as far as the columns that are not dirty yet.
+				uint32_t l = 0;
+				while (l < left && memcmp(src + l * 4, prev + l * 4, 4) == 0)
+					l++;
+				uint32_t r = width;
+				while (r > right && r > l && memcmp(src + (r - 1) * 4, prev + (r - 1) * 4, 4) == 0)
+					r--;
+
+				top    = std::min(top, y);
+				bottom = y + 1;
+				left   = std::min(left, l);
+				right  = std::max(right, r);
+			}
+		}
+
+		memcpy(row, src, stride);
+	}
+
+	rect dirty = {0, 0, width, height};
+	if (old) {
+		// Nothing changed, the reader keeps the frame it has.
+		if (top == height)
+			return;
+		dirty = {left, top, right - left, bottom - top};
+	}
+
+	target.frame     = ++frame;
+	target.timestamp = timestamp;
+	target.width     = width;
+	target.height    = height;
+	target.stride    = stride;
+	target.dirty     = dirty;
+
+	uint32_t shared = hdr->state.exchange(back | state_fresh, std::memory_order_acq_rel);
+	last            = back;
+	back            = shared & state_slot_mask;
+	hdr->published.store(frame, std::memory_order_release);
+}
+
+bool shared_frame::reader::init(mapping& memory)
+{
+	if (!memory.data())
+		return false;
+
+	hdr        = memory.get_header();
+	last_frame = 0;
+	last_w     = 0;
+	last_h     = 0;
+	return true;
+}
+
+const shared_frame::slot* shared_frame::reader::acquire(rect& dirty)
+{
+	if (!hdr || !(hdr->state.load(std::memory_order_acquire) & state_fresh))
+		return nullptr;
+
+	uint32_t shared  = hdr->state.exchange(hdr->reader_slot, std::memory_order_acq_rel);
+	hdr->reader_slot = shared & state_slot_mask;
+
+	const slot* current = &hdr->slots[hdr->reader_slot];
+	if (current->frame == last_frame + 1 && current->width == last_w && current->height == last_h)
+		dirty = current->dirty;
+	else
+		dirty = {0, 0, current->width, current->height};
+
+	last_frame = current->frame;
+	last_w     = current->width;
+	last_h     = current->height;
+	return current;
+}
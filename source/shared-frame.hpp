@@ -0,0 +1,150 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+// Frames of a display exported to shared memory. The server renders the display and publishes
+// RGBA frames into a triple buffer; the client maps the same memory and takes the newest frame
+// without any IPC call. There is one writer and at most one reader at a time.
+namespace shared_frame
+{
+	const uint32_t magic      = 0x4D52464F; // "OFRM"
+	const uint32_t version    = 1;
+	const uint32_t slot_count = 3;
+
+	// The state word holds the slot shared by both sides, and whether it holds a frame the reader
+	// has not taken yet. The writer and the reader each own one of the two other slots.
+	const uint32_t state_slot_mask = 0x3;
+	const uint32_t state_fresh     = 0x4;
+
+	enum format : uint32_t
+	{
+		RGBA8 = 0,
+	};
+
+	struct rect
+	{
+		uint32_t x;
+		uint32_t y;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	struct slot
+	{
+		uint64_t frame;     // Frame counter, starts at 1
+		uint64_t timestamp; // Render time, in nanoseconds
+		uint64_t offset;    // Of the pixels, from the start of the mapping
+		uint32_t width;
+		uint32_t height;
+		uint32_t stride;
+		uint32_t reserved;
+		rect     dirty; // Area that changed since frame - 1
+	};
+
+	struct header
+	{
+		uint32_t              magic;
+		uint32_t              version;
+		uint32_t              format;
+		uint32_t              max_width;
+		uint32_t              max_height;
+		uint32_t              reader_slot;
+		uint64_t              slot_size;
+		std::atomic<uint32_t> state;
+		uint32_t              reserved;
+		std::atomic<uint64_t> published;
+		slot                  slots[slot_count];
+	};
+	static_assert(std::atomic<uint32_t>::is_always_lock_free, "the state word is shared across processes");
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "the frame counter is shared across processes");
+
+	size_t mapping_size(uint32_t max_width, uint32_t max_height);
+
+	/*!
+	* \brief A named shared memory segment, created by the server and opened by the client.
+	*/
+	class mapping
+	{
+		public:
+		mapping() {}
+		~mapping();
+
+		mapping(mapping const&) = delete;
+		void operator=(mapping const&) = delete;
+
+		bool create(const std::string& name, size_t size);
+		bool open(const std::string& name);
+		void close();
+
+		header*  get_header() const;
+		uint8_t* data() const;
+		size_t   size() const;
+
+		private:
+		std::string name;
+		size_t      length = 0;
+		uint8_t*    view   = nullptr;
+		bool        owner  = false;
+#ifdef WIN32
+		void* handle = nullptr;
+#endif
+	};
+
+	/*!
+	* \brief Publishes frames, owns the back slot.
+	*
+	* Each frame is compared with the previous one while it is copied, so
+	* readers that follow every frame only have to upload the dirty area.
+	*/
+	class writer
+	{
+		public:
+		bool init(mapping& memory, uint32_t max_width, uint32_t max_height);
+		void publish(const uint8_t* pixels, uint32_t linesize, uint32_t width, uint32_t height, uint64_t timestamp);
+
+		private:
+		header*  hdr   = nullptr;
+		uint8_t* base  = nullptr;
+		uint32_t back  = 1;
+		uint32_t last  = slot_count;
+		uint64_t frame = 0;
+	};
+
+	/*!
+	* \brief Takes the newest frame, owns the front slot.
+	*/
+	class reader
+	{
+		public:
+		bool init(mapping& memory);
+
+		// Returns the newest frame if there is one the reader has not seen, nullptr otherwise.
+		// The dirty area covers the whole frame when frames were skipped or the size changed.
+		const slot* acquire(rect& dirty);
+
+		private:
+		header*  hdr        = nullptr;
+		uint64_t last_frame = 0;
+		uint32_t last_w = 0, last_h = 0;
+	};
+} // namespace shared_frame
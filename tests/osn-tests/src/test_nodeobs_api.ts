@@ -3,7 +3,7 @@ import { expect } from 'chai';
 import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
-import { OBSHandler, IPerformanceState, TOBSHotkey } from '../util/obs_handler';
+import { OBSHandler, IPerformanceState, IPerformanceSample, IOutputSample, TOBSHotkey } from '../util/obs_handler';
 import { showHideInputHotkeys, slideshowHotkeys, ffmpeg_sourceHotkeys,
     game_captureHotkeys, dshow_wasapitHotkeys,coreaudioHotkeys,  deleteConfigFiles } from '../util/general';
 
@@ -61,6 +61,55 @@ describe(testName, function() {
         expect(stats.diskSpaceAvailable).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetPerformanceStatistics, 'diskSpaceAvailable'));
     });
 
+    it('Get performance samples', function() {
+        // Getting every retained sample
+        const history = osn.NodeObs.OBS_API_getPerformanceSamples(0);
+        const samples: IPerformanceSample[] = history.samples;
+
+        // Checking if samples are ordered and end at the returned sequence
+        expect(samples.length).to.be.above(0, GetErrorMessage(ETestErrorMsg.GetPerformanceSamples, 'samples'));
+        expect(samples[samples.length - 1].sequence).to.equal(history.sequence, GetErrorMessage(ETestErrorMsg.GetPerformanceSamples, 'sequence'));
+        for (let i = 1; i < samples.length; i++) {
+            expect(samples[i].sequence).to.equal(samples[i - 1].sequence + 1, GetErrorMessage(ETestErrorMsg.GetPerformanceSamples, 'sequence'));
+            expect(samples[i].timestamp).to.be.at.least(samples[i - 1].timestamp, GetErrorMessage(ETestErrorMsg.GetPerformanceSamples, 'timestamp'));
+        }
+        expect(samples[0].diskSpaceAvailable).to.be.a('number', GetErrorMessage(ETestErrorMsg.GetPerformanceSamples, 'diskSpaceAvailable'));
+
+        // Nothing newer than the latest sequence
+        const latest = osn.NodeObs.OBS_API_getPerformanceSamples(history.sequence);
+        for (const sample of latest.samples) {
+            expect(sample.sequence).to.be.above(history.sequence, GetErrorMessage(ETestErrorMsg.GetPerformanceSamples, 'sequence'));
+        }
+    });
+
+    it('Get output samples', function() {
+        // Getting every retained sample
+        const history = osn.NodeObs.OBS_API_getOutputSamples(0);
+        const samples: IOutputSample[] = history.samples;
+
+        // Checking if every service output is reported, idle outputs have no traffic
+        expect(samples.length).to.be.above(0, GetErrorMessage(ETestErrorMsg.GetOutputSamples, 'samples'));
+        expect(samples[samples.length - 1].sequence).to.equal(history.sequence, GetErrorMessage(ETestErrorMsg.GetOutputSamples, 'sequence'));
+        for (const name of ['streaming', 'recording', 'replayBuffer', 'virtualWebcam']) {
+            const output = samples[samples.length - 1][name];
+            expect(output).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetOutputSamples, name));
+            expect(output.active).to.equal(false, GetErrorMessage(ETestErrorMsg.GetOutputSamples, name + '.active'));
+            expect(output.bitrate).to.equal(0, GetErrorMessage(ETestErrorMsg.GetOutputSamples, name + '.bitrate'));
+            expect(output.reconnects).to.equal(0, GetErrorMessage(ETestErrorMsg.GetOutputSamples, name + '.reconnects'));
+        }
+    });
+
+    it('Get media cache statistics', function() {
+        // Getting media cache statistics
+        const stats = osn.NodeObs.OBS_API_getMediaCacheStats();
+
+        // Checking if the cache stays within its budget
+        expect(stats.cachedSize).to.be.at.most(stats.cacheBudget, GetErrorMessage(ETestErrorMsg.GetMediaCacheStats, 'cachedSize'));
+        expect(stats.cachedSources).to.be.at.most(stats.trackedSources, GetErrorMessage(ETestErrorMsg.GetMediaCacheStats, 'cachedSources'));
+        expect(stats.evictions).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetMediaCacheStats, 'evictions'));
+        expect(stats.readmissions).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetMediaCacheStats, 'readmissions'));
+    });
+
     it('Get hotkeys of all sources and process them', function() {
         let obsHotkeys: TOBSHotkey[];
 
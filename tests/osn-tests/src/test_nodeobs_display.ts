@@ -0,0 +1,165 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles, sleep } from '../util/general';
+import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
+import { EOBSInputTypes } from '../util/obs_enums';
+
+const testName = 'nodeobs_display';
+
+describe(testName, function() {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    // Polls a shared memory display for a few seconds and checks the frames it delivers. The rate is bound by
+    // the video frame rate, the export path itself is measured by obs-studio-server/benchmark/frame-benchmark.cpp
+    async function receiveSharedMemoryFrames(width: number, height: number) {
+        const key = 'shared_display_' + height + 'p';
+        const duration = 3000;
+
+        // Creating a display rendered into shared memory
+        const buffer: ArrayBuffer = osn.NodeObs.OBS_content_createSharedMemoryDisplay(key, width, height);
+        expect(buffer).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.SharedMemoryDisplay, key));
+        osn.NodeObs.OBS_content_resizeDisplay(key, width, height);
+
+        let frames = 0;
+        let dirtyBytes = 0;
+        let lastFrame = undefined;
+        let step = 0;
+        const start = Date.now();
+
+        while (Date.now() - start < duration) {
+            // Unchanged frames are not published, so the padding color changes on every poll
+            osn.NodeObs.OBS_content_setPaddingColor(key, step++ % 256, 0, 0);
+
+            const frame = osn.NodeObs.OBS_content_acquireSharedMemoryFrame(key);
+            if (frame) {
+                // Copying the dirty area out of the mapping, as a renderer uploading it would
+                const pixels = new Uint8Array(buffer, frame.offset + frame.dirty.y * frame.stride,
+                    frame.dirty.height * frame.stride);
+                dirtyBytes += pixels.slice().length;
+                lastFrame = frame;
+                frames++;
+            }
+            await sleep(1);
+        }
+
+        const seconds = (Date.now() - start) / 1000;
+        logInfo(testName, key + ': ' + (frames / seconds).toFixed(1) + ' frames/s received, ' +
+            (dirtyBytes / seconds / 1048576).toFixed(1) + ' MB/s of dirty rows');
+
+        // Checking that frames were published at the requested size
+        expect(frames).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.SharedMemoryFrames, key));
+        expect(lastFrame.width).to.equal(width, GetErrorMessage(ETestErrorMsg.SharedMemoryFrameSize, key));
+        expect(lastFrame.height).to.equal(height, GetErrorMessage(ETestErrorMsg.SharedMemoryFrameSize, key));
+        expect(lastFrame.offset + lastFrame.stride * lastFrame.height).to.be.at.most(buffer.byteLength,
+            GetErrorMessage(ETestErrorMsg.SharedMemoryFrameSize, key));
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+    }
+
+    // Counts the frames a shared memory display publishes during duration, calling change before every poll
+    async function countFrames(key: string, duration: number, change: () => void) {
+        let frames = 0;
+        const start = Date.now();
+
+        while (Date.now() - start < duration) {
+            change();
+            if (osn.NodeObs.OBS_content_acquireSharedMemoryFrame(key)) {
+                frames++;
+            }
+            await sleep(10);
+        }
+        return frames;
+    }
+
+    it('Receive frames from a shared memory display at 720p', async function() {
+        await receiveSharedMemoryFrames(1280, 720);
+    });
+
+    it('Receive frames from a shared memory display at 1080p', async function() {
+        await receiveSharedMemoryFrames(1920, 1080);
+    });
+
+    it('Pause and resume a display', async function() {
+        const key = 'paused_display';
+        let step = 0;
+        const changePadding = () => osn.NodeObs.OBS_content_setPaddingColor(key, step++ % 256, 0, 0);
+
+        const buffer: ArrayBuffer = osn.NodeObs.OBS_content_createSharedMemoryDisplay(key, 640, 360);
+        expect(buffer).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.SharedMemoryDisplay, key));
+        osn.NodeObs.OBS_content_resizeDisplay(key, 640, 360);
+        expect(await countFrames(key, 1000, changePadding)).to.be.greaterThan(0,
+            GetErrorMessage(ETestErrorMsg.SharedMemoryFrames, key));
+
+        // Dropping the frame that may have been rendered before the pause took effect
+        osn.setDisplayPaused(key, true);
+        await countFrames(key, 200, () => {});
+
+        // Padding changes mark the display dirty, which must not override the pause
+        expect(await countFrames(key, 1000, changePadding)).to.equal(0,
+            GetErrorMessage(ETestErrorMsg.PausedDisplayFrames, key));
+
+        osn.setDisplayPaused(key, false);
+        expect(await countFrames(key, 1000, changePadding)).to.be.greaterThan(0,
+            GetErrorMessage(ETestErrorMsg.ResumedDisplayFrames, key));
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+    });
+
+    it('Redraw an unchanged source display once marked dirty', async function() {
+        const key = 'dirty_display';
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'dirty_display_color',
+            { color: 4278190335, width: 320, height: 180 });
+
+        const buffer: ArrayBuffer = osn.NodeObs.OBS_content_createSharedMemoryDisplay(key, 320, 180, 0, input.name);
+        expect(buffer).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.SharedMemoryDisplay, key));
+        osn.NodeObs.OBS_content_resizeDisplay(key, 320, 180);
+        osn.setDisplayRenderBudget(key, 0, true);
+        expect(await countFrames(key, 1000, () => {})).to.be.greaterThan(0,
+            GetErrorMessage(ETestErrorMsg.SharedMemoryFrames, key));
+
+        // Settings updates aren't observed by the display, marking it dirty redraws it before the once
+        // per second refresh of unchanged sources
+        const colors = [4278255360, 4294901760, 4278190335];
+        for (const color of colors) {
+            input.update({ color: color });
+            osn.markDisplayDirty(key);
+            expect(await countFrames(key, 300, () => {})).to.be.greaterThan(0,
+                GetErrorMessage(ETestErrorMsg.DirtyDisplayFrames, key));
+        }
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+        input.release();
+    });
+});
@@ -3,7 +3,7 @@ import { expect } from 'chai';
 import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
-import { OBSHandler, IOBSOutputSignalInfo } from '../util/obs_handler';
+import { OBSHandler, IOBSOutputSignalInfo, IPerformanceState } from '../util/obs_handler';
 import { deleteConfigFiles, sleep } from '../util/general';
 import { EOBSOutputType, EOBSOutputSignal, EOBSSettingsCategories } from '../util/obs_enums';
 
@@ -139,6 +139,56 @@ describe(testName, function() {
         expect(signalInfo.signal).to.equal(EOBSOutputSignal.Stop, GetErrorMessage(ETestErrorMsg.RecordingOutput));
     });
 
+    it('Simple mode - Start a pre-warmed recording', async function() {
+        // Preparing environment
+        obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
+        obs.setSetting(EOBSSettingsCategories.Output, 'StreamEncoder', obs.os === 'win32' ? 'x264' : 'obs_x264');
+        obs.setSetting(EOBSSettingsCategories.Output, 'FilePath', path.join(path.normalize(__dirname), '..', 'osnData'));
+
+        let signalInfo: IOBSOutputSignalInfo;
+        let stats: IPerformanceState = osn.NodeObs.OBS_API_getPerformanceStatistics();
+        const starts = stats.recordingStarts;
+        const warmStarts = stats.recordingWarmStarts;
+
+        // Keeping the output and encoders prepared before starting
+        osn.NodeObs.OBS_service_setRecordingPrewarm(true);
+
+        for (let i = 0; i < 2; i++) {
+            osn.NodeObs.OBS_service_startRecording();
+
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Start);
+
+            if (signalInfo.signal == EOBSOutputSignal.Stop) {
+                throw Error(GetErrorMessage(ETestErrorMsg.RecordOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+            }
+
+            expect(signalInfo.type).to.equal(EOBSOutputType.Recording, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+            expect(signalInfo.signal).to.equal(EOBSOutputSignal.Start, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+
+            await sleep(500);
+
+            osn.NodeObs.OBS_service_stopRecording();
+
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stopping);
+            expect(signalInfo.signal).to.equal(EOBSOutputSignal.Stopping, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stop);
+
+            if (signalInfo.code != 0) {
+                throw Error(GetErrorMessage(ETestErrorMsg.RecordOutputStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+            }
+        }
+
+        osn.NodeObs.OBS_service_setRecordingPrewarm(false);
+
+        // Both starts reused the prepared output
+        stats = osn.NodeObs.OBS_API_getPerformanceStatistics();
+        expect(stats.recordingStarts).to.equal(starts + 2, GetErrorMessage(ETestErrorMsg.RecordingStartStats, 'recordingStarts'));
+        expect(stats.recordingWarmStarts).to.equal(warmStarts + 2, GetErrorMessage(ETestErrorMsg.RecordingStartStats, 'recordingWarmStarts'));
+        expect(stats.recordingStartTime).to.be.above(0, GetErrorMessage(ETestErrorMsg.RecordingStartStats, 'recordingStartTime'));
+        expect(stats.recordingStartTimeMax).to.be.at.least(stats.recordingStartTimeAverage, GetErrorMessage(ETestErrorMsg.RecordingStartStats, 'recordingStartTimeMax'));
+    });
+
     it('Simple mode - Start replay buffer, save replay and stop', async function() {
         // Preparing environment
         obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
@@ -186,6 +236,132 @@ describe(testName, function() {
         expect(signalInfo.signal).to.equal(EOBSOutputSignal.Stop, GetErrorMessage(ETestErrorMsg.ReplayBuffer));
     });
 
+    it('Simple mode - Save a disk backed replay buffer', async function() {
+        // Preparing environment
+        obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
+        obs.setSetting(EOBSSettingsCategories.Output, 'StreamEncoder', obs.os === 'win32' ? 'x264' : 'obs_x264');
+        obs.setSetting(EOBSSettingsCategories.Output, 'FilePath', path.join(path.normalize(__dirname), '..', 'osnData'));
+        obs.setSetting(EOBSSettingsCategories.Output, 'RecRBDisk', true);
+        obs.setSetting(EOBSSettingsCategories.Output, 'RecRBMemSize', 1);
+        obs.setSetting(EOBSSettingsCategories.Output, 'RecRBDiskSize', 64);
+
+        let signalInfo: IOBSOutputSignalInfo;
+
+        osn.NodeObs.OBS_service_startReplayBuffer();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Start);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(ETestErrorMsg.ReplayBufferDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        await sleep(2000);
+
+        osn.NodeObs.OBS_service_processReplayBufferHotkey();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Writing);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Writing, GetErrorMessage(ETestErrorMsg.ReplayBuffer));
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Wrote);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Wrote, GetErrorMessage(ETestErrorMsg.ReplayBuffer));
+
+        const replay: string = osn.NodeObs.OBS_service_getLastReplay();
+        expect(replay.endsWith('.flv')).to.equal(true, GetErrorMessage(ETestErrorMsg.DiskReplayBuffer, replay));
+
+        osn.NodeObs.OBS_service_stopReplayBuffer(false);
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Stopping);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Stopping, GetErrorMessage(ETestErrorMsg.ReplayBuffer));
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Stop);
+
+        if (signalInfo.code != 0) {
+            throw Error(GetErrorMessage(ETestErrorMsg.ReplayBufferStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        obs.setSetting(EOBSSettingsCategories.Output, 'RecRBDisk', false);
+    });
+
+    it('Advanced mode - Share identical stream and record encoders', async function() {
+        // Preparing environment, a separate recording encoder with the same settings as the stream encoder.
+        // Since the recording does not use the stream encoder, only the planner can make them share it.
+        obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Advanced');
+        obs.setSetting(EOBSSettingsCategories.Output, 'Encoder', 'obs_x264');
+        obs.setSetting(EOBSSettingsCategories.Output, 'RecEncoder', 'obs_x264');
+        obs.setSetting(EOBSSettingsCategories.Output, 'RecFilePath', path.join(path.normalize(__dirname), '..', 'osnData'));
+        obs.setSetting(EOBSSettingsCategories.Output, 'rate_control', 'CBR');
+        obs.setSetting(EOBSSettingsCategories.Output, 'Recrate_control', 'CBR');
+        obs.setSetting(EOBSSettingsCategories.Output, 'bitrate', 2500);
+        obs.setSetting(EOBSSettingsCategories.Output, 'Recbitrate', 2500);
+
+        let signalInfo: IOBSOutputSignalInfo;
+
+        osn.NodeObs.OBS_service_startStreaming();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Starting);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Starting, GetErrorMessage(ETestErrorMsg.StreamOutput));
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Activate);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(ETestErrorMsg.StreamOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Start);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Start, GetErrorMessage(ETestErrorMsg.StreamOutput));
+
+        osn.NodeObs.OBS_service_startRecording();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Start);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            osn.NodeObs.OBS_service_stopStreaming(false);
+            throw Error(GetErrorMessage(ETestErrorMsg.RecordOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        // The recording must be fed by the running stream encoder rather than by its own
+        const plan = osn.NodeObs.OBS_service_getEncoderPlan();
+        const streaming = plan.find((output: any) => output.output == EOBSOutputType.Streaming);
+        const recording = plan.find((output: any) => output.output == EOBSOutputType.Recording);
+        const streamingVideo = streaming.encoders.find((encoder: any) => encoder.type == 'video');
+        const recordingVideo = recording.encoders.find((encoder: any) => encoder.type == 'video');
+
+        expect(streaming.active).to.equal(true, GetErrorMessage(ETestErrorMsg.EncoderPlan, 'streaming'));
+        expect(recording.active).to.equal(true, GetErrorMessage(ETestErrorMsg.EncoderPlan, 'recording'));
+        expect(streamingVideo).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.EncoderPlan, 'streaming'));
+        expect(recordingVideo).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.EncoderPlan, 'recording'));
+        expect(recordingVideo.fingerprint).to.equal(streamingVideo.fingerprint, GetErrorMessage(ETestErrorMsg.EncoderPlan, 'fingerprint'));
+        expect(recordingVideo.name).to.equal(streamingVideo.name, GetErrorMessage(ETestErrorMsg.EncoderPlan, 'recording'));
+
+        osn.NodeObs.OBS_service_stopRecording();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stopping);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Stopping, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stop);
+
+        if (signalInfo.code != 0) {
+            osn.NodeObs.OBS_service_stopStreaming(false);
+            throw Error(GetErrorMessage(ETestErrorMsg.RecordOutputStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        osn.NodeObs.OBS_service_stopStreaming(false);
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Stopping);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Stopping, GetErrorMessage(ETestErrorMsg.StreamOutput));
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Stop);
+
+        if (signalInfo.code != 0) {
+            throw Error(GetErrorMessage(ETestErrorMsg.StreamOutputStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Deactivate);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Deactivate, GetErrorMessage(ETestErrorMsg.StreamOutput));
+
+        obs.setSetting(EOBSSettingsCategories.Output, 'RecEncoder', 'none');
+    });
+
     it('Simple mode - Record while streaming', async function() {
         // Preparing environment
         obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
@@ -158,4 +158,44 @@ describe(testName, () => {
             expect(multiplier).to.equal(1, GetErrorMessage(ETestErrorMsg.Multiplier, faderTypeStr));
         });
     });
+
+    it('Convert fader values and follow source volume', () => {
+        // Creating audio source
+        const input = osn.InputFactory.create(EOBSInputTypes.WASAPIInput, 'input');
+
+        // Checking if input source was created correctly
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.WASAPIInput));
+
+        // Creating faders and attaching them to the same source
+        const cubicFader = osn.FaderFactory.create(osn.EFaderType.Cubic);
+        const logFader = osn.FaderFactory.create(osn.EFaderType.Log);
+        expect(cubicFader).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateFader, 'cubic'));
+        expect(logFader).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateFader, 'log'));
+        cubicFader.attach(input);
+        logFader.attach(input);
+
+        // Setting deflection, a cubic fader at half deflection is at an eighth of the volume
+        cubicFader.deflection = 0.5;
+        expect(cubicFader.mul).to.be.closeTo(0.125, 0.0001, GetErrorMessage(ETestErrorMsg.Multiplier, 'cubic'));
+        expect(cubicFader.db).to.be.closeTo(-18.0618, 0.0001, GetErrorMessage(ETestErrorMsg.Decibel, 'cubic'));
+        expect(cubicFader.deflection).to.be.closeTo(0.5, 0.0001, GetErrorMessage(ETestErrorMsg.Deflection, 'cubic'));
+
+        // Checking if the other fader attached to the source followed
+        expect(logFader.mul).to.be.closeTo(0.125, 0.0001, GetErrorMessage(ETestErrorMsg.Multiplier, 'log'));
+
+        // Checking if the log fader clamps below its range
+        logFader.db = -100;
+        expect(logFader.db).to.equal(-Infinity, GetErrorMessage(ETestErrorMsg.Decibel, 'log'));
+        expect(logFader.deflection).to.equal(0, GetErrorMessage(ETestErrorMsg.Deflection, 'log'));
+
+        // Changing the source volume directly
+        input.volume = 0.5;
+        expect(cubicFader.mul).to.be.closeTo(0.5, 0.0001, GetErrorMessage(ETestErrorMsg.Multiplier, 'cubic'));
+        expect(logFader.mul).to.be.closeTo(0.5, 0.0001, GetErrorMessage(ETestErrorMsg.Multiplier, 'log'));
+        expect(input.volume).to.be.closeTo(0.5, 0.0001, GetErrorMessage(ETestErrorMsg.Volume, EOBSInputTypes.WASAPIInput));
+
+        cubicFader.detach();
+        logFader.detach();
+        input.release();
+    });
 });
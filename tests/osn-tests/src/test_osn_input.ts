@@ -605,6 +605,40 @@ describe(testName, () => {
         input.release();
     });
 
+    it('Find inputs by type and output flags', () => {
+        // Creating a video only and an audio/video input
+        const colorInput = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'color');
+        const mediaInput = osn.InputFactory.create(EOBSInputTypes.FFMPEGSource, 'media');
+        expect(colorInput).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+        expect(mediaInput).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.FFMPEGSource));
+
+        const names = (inputs: IInput[]) => inputs.map(input => input.name);
+
+        // Filtering by type id
+        let found = names(osn.InputFactory.findSources(EOBSInputTypes.ColorSource));
+        expect(found).to.include('color', GetErrorMessage(ETestErrorMsg.FindSources, 'color'));
+        expect(found).to.not.include('media', GetErrorMessage(ETestErrorMsg.FindSources, 'media'));
+
+        // Filtering by output flags only
+        found = names(osn.InputFactory.findSources('', osn.ESourceOutputFlags.Audio));
+        expect(found).to.include('media', GetErrorMessage(ETestErrorMsg.FindSources, 'media'));
+        expect(found).to.not.include('color', GetErrorMessage(ETestErrorMsg.FindSources, 'color'));
+
+        // Both filters have to match
+        found = names(osn.InputFactory.findSources(EOBSInputTypes.ColorSource, osn.ESourceOutputFlags.Audio));
+        expect(found.length).to.equal(0, GetErrorMessage(ETestErrorMsg.FindSources, 'color'));
+
+        // Renamed inputs are found by their new name
+        colorInput.name = 'renamed';
+        expect(osn.InputFactory.fromName('renamed').name).to.equal('renamed', GetErrorMessage(ETestErrorMsg.InputFromName, 'renamed'));
+
+        colorInput.release();
+        mediaInput.release();
+
+        found = names(osn.InputFactory.findSources());
+        expect(found).to.not.include('renamed', GetErrorMessage(ETestErrorMsg.FindSources, 'renamed'));
+    });
+
     it('Fail test - Try to find an input that does not exist', () => {
         let inputFromName: IInput;
 
@@ -0,0 +1,109 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles, sleep } from '../util/general';
+import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
+import { EOBSInputTypes, EOBSFilterTypes } from '../util/obs_enums';
+
+const testName = 'osn-profiler';
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Enable and disable the profiler', () => {
+        // Enabled by default
+        expect(osn.Profiler.enabled).to.equal(true, GetErrorMessage(ETestErrorMsg.ProfilerEnabled));
+
+        osn.Profiler.enabled = false;
+        expect(osn.Profiler.enabled).to.equal(false, GetErrorMessage(ETestErrorMsg.ProfilerEnabled));
+        expect(osn.Profiler.getSourceCosts().length).to.equal(0, GetErrorMessage(ETestErrorMsg.SourceCost, 'count'));
+
+        osn.Profiler.enabled = true;
+        expect(osn.Profiler.enabled).to.equal(true, GetErrorMessage(ETestErrorMsg.ProfilerEnabled));
+    });
+
+    it('Get tick and render costs', async () => {
+        // Creating a scene with a filtered input, showing it and drawing the input in a display
+        const scene = osn.SceneFactory.create('test_osn_profiler_scene');
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'test_osn_profiler_input');
+        const filter = osn.FilterFactory.create(EOBSFilterTypes.Color, 'test_osn_profiler_filter');
+        input.addFilter(filter);
+        scene.add(input);
+        osn.Global.setOutputSource(0, scene);
+
+        const key = 'test_osn_profiler_display';
+        const buffer: ArrayBuffer = osn.NodeObs.OBS_content_createSharedMemoryDisplay(key, 320, 180, 0, input.name);
+        expect(buffer).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.SharedMemoryDisplay, key));
+        osn.NodeObs.OBS_content_resizeDisplay(key, 320, 180);
+
+        osn.Profiler.reset();
+        await sleep(2000);
+
+        const costs = osn.Profiler.getSourceCosts();
+
+        // The libobs scopes cover the tick of every source and the render of the canvas
+        for (const scope of ['tick_sources', 'render_main_texture']) {
+            const scopeCost = costs.find(cost => cost.name == scope);
+            expect(scopeCost).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.SourceCost, scope));
+            expect(scopeCost.id).to.equal('', GetErrorMessage(ETestErrorMsg.SourceCost, 'id'));
+            expect(scopeCost.samples).to.be.above(0, GetErrorMessage(ETestErrorMsg.SourceCost, 'samples'));
+            expect(scopeCost.min).to.be.at.most(scopeCost.p99, GetErrorMessage(ETestErrorMsg.SourceCost, 'min'));
+        }
+
+        // The input drawn by the display is timed on its own
+        const inputCost = costs.find(cost => cost.name == 'test_osn_profiler_input');
+        expect(inputCost).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.SourceCost, 'test_osn_profiler_input'));
+        expect(inputCost.id).to.equal(EOBSInputTypes.ColorSource, GetErrorMessage(ETestErrorMsg.SourceCost, 'id'));
+        expect(inputCost.samples).to.be.above(0, GetErrorMessage(ETestErrorMsg.SourceCost, 'samples'));
+        expect(inputCost.min).to.be.at.most(inputCost.avg, GetErrorMessage(ETestErrorMsg.SourceCost, 'min'));
+        expect(inputCost.avg).to.be.at.most(inputCost.p99, GetErrorMessage(ETestErrorMsg.SourceCost, 'avg'));
+
+        // Costs are sorted from the most expensive
+        for (let i = 1; i < costs.length; i++) {
+            expect(costs[i].avg).to.be.at.most(costs[i - 1].avg, GetErrorMessage(ETestErrorMsg.SourceCost, 'order'));
+        }
+
+        // Reset drops every timing, the display is gone so the input is not timed again
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+        osn.Profiler.reset();
+        const resetCost = osn.Profiler.getSourceCosts().find(cost => cost.name == 'test_osn_profiler_input');
+        expect(resetCost).to.equal(undefined, GetErrorMessage(ETestErrorMsg.SourceCost, 'reset'));
+
+        osn.Global.setOutputSource(0, null);
+        input.removeFilter(filter);
+        filter.release();
+        scene.release();
+        input.release();
+    });
+});
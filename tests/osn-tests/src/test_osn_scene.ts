@@ -4,7 +4,7 @@ import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { OBSHandler } from '../util/obs_handler';
 import { deleteConfigFiles } from '../util/general';
-import { EOBSInputTypes } from '../util/obs_enums';
+import { EOBSInputTypes, EOBSFilterTypes } from '../util/obs_enums';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
 
 const testName = 'osn-scene';
@@ -285,6 +285,73 @@ describe(testName, () => {
         scene.release();
     });
 
+    it('Load scene collection', () => {
+        const sceneName = 'loadCollection_scene';
+        const nestedSceneName = 'loadCollection_nested_scene';
+        const inputName = 'loadCollection_input';
+
+        // Loading a collection with a nested scene declared after the scene using it
+        const collection = osn.SceneFactory.loadCollection({
+            inputs: [{
+                id: EOBSInputTypes.ImageSource,
+                name: inputName,
+                filters: [{ id: EOBSFilterTypes.Color, name: 'loadCollection_filter' }]
+            }],
+            scenes: [{
+                name: sceneName,
+                items: [
+                    { source: inputName, x: 10, y: 20, visible: false },
+                    { source: nestedSceneName }
+                ]
+            }, {
+                name: nestedSceneName,
+                items: [{ source: inputName }]
+            }]
+        });
+
+        // Checking if every object was created
+        expect(collection).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.LoadSceneCollection));
+        expect(collection.inputs.length).to.equal(1, GetErrorMessage(ETestErrorMsg.LoadSceneCollection));
+        expect(collection.inputs[0].input.name).to.equal(inputName, GetErrorMessage(ETestErrorMsg.InputName, EOBSInputTypes.ImageSource));
+        expect(collection.inputs[0].filters.length).to.equal(1, GetErrorMessage(ETestErrorMsg.LoadSceneCollection));
+        expect(collection.inputs[0].input.filters.length).to.equal(1, GetErrorMessage(ETestErrorMsg.LoadSceneCollection));
+        expect(collection.scenes.length).to.equal(2, GetErrorMessage(ETestErrorMsg.LoadSceneCollection));
+
+        const scene = collection.scenes[0].scene;
+        const sceneItems = scene.getItems();
+        expect(scene.name).to.equal(sceneName, GetErrorMessage(ETestErrorMsg.SceneName, sceneName));
+        expect(sceneItems.length).to.equal(2, GetErrorMessage(ETestErrorMsg.GetSceneItems, sceneName));
+        expect(sceneItems[0].source.name).to.equal(inputName, ETestErrorMsg.SceneItemPosition);
+        expect(sceneItems[1].source.name).to.equal(nestedSceneName, ETestErrorMsg.SceneItemPosition);
+        expect(sceneItems[0].position.x).to.equal(10, GetErrorMessage(ETestErrorMsg.LoadSceneCollection));
+        expect(sceneItems[0].position.y).to.equal(20, GetErrorMessage(ETestErrorMsg.LoadSceneCollection));
+        expect(sceneItems[0].visible).to.equal(false, GetErrorMessage(ETestErrorMsg.LoadSceneCollection));
+        expect(collection.scenes[1].items.length).to.equal(1, GetErrorMessage(ETestErrorMsg.GetSceneItems, nestedSceneName));
+
+        collection.scenes[0].items.forEach(item => item.remove());
+        collection.scenes[1].items.forEach(item => item.remove());
+        collection.inputs[0].input.removeFilter(collection.inputs[0].filters[0]);
+        collection.inputs[0].filters[0].release();
+        collection.inputs[0].input.release();
+        collection.scenes[1].scene.release();
+        scene.release();
+    });
+
+    it('Fail test - Load scene collection with wrongly typed values', () => {
+        // Every value is type checked before anything is created
+        expect(function() {
+            osn.SceneFactory.loadCollection({ inputs: [{ id: EOBSInputTypes.ImageSource, name: 5 }] } as any);
+        }).to.throw();
+
+        expect(function() {
+            osn.SceneFactory.loadCollection({ scenes: [{ name: 'loadCollection_fail', items: [{ scene: 'x', visible: 'no' }] }] } as any);
+        }).to.throw();
+
+        expect(function() {
+            osn.SceneFactory.fromName('loadCollection_fail');
+        }).to.throw();
+    });
+
     it('Fail test - Get scene from name that don\'t exist ', () => {
         expect(function() {
             const failSceneFromName = osn.SceneFactory.fromName('does_not_exist');
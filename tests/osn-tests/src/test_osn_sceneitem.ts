@@ -359,4 +359,51 @@ describe(testName, () => {
         sceneItem.source.release();
         sceneItem.remove();
     });
+
+    it('Apply transforms to several scene items at once', () => {
+        let position: IVec2 = {x: 10, y: 20};
+        let scale: IVec2 = {x: 2, y: 3};
+        let crop: ICrop = {top: 4, bottom: 4, left: 2, right: 2};
+
+        // Getting scene
+        const scene = osn.SceneFactory.fromName(sceneName);
+
+        // Getting source
+        const source = osn.InputFactory.fromName(sourceName);
+
+        // Adding input source to scene twice to create two scene items
+        const firstItem = scene.add(source);
+        const secondItem = scene.add(source);
+
+        // Checking if input source was added to the scene correctly
+        expect(firstItem).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.AddSourceToScene, EOBSInputTypes.ImageSource, sceneName));
+        expect(secondItem).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.AddSourceToScene, EOBSInputTypes.ImageSource, sceneName));
+
+        // Moving the first item, scaling, rotating and cropping the second one in a single call
+        const resolved = osn.SceneItemFactory.applyTransforms([
+            {item: firstItem, position: position},
+            {item: secondItem, scale: scale, rotation: 90, crop: crop},
+        ]);
+
+        // Checking the resolved transforms
+        expect(resolved.length).to.equal(2, GetErrorMessage(ETestErrorMsg.ApplyTransforms, 'batch'));
+        expect(resolved[0].item.id).to.equal(firstItem.id, GetErrorMessage(ETestErrorMsg.ApplyTransforms, 'order'));
+        expect(resolved[0].position.x).to.equal(position.x, GetErrorMessage(ETestErrorMsg.PositionX));
+        expect(resolved[0].position.y).to.equal(position.y, GetErrorMessage(ETestErrorMsg.PositionY));
+        expect(resolved[0].scale.x).to.equal(1, GetErrorMessage(ETestErrorMsg.ApplyTransforms, 'first'));
+        expect(resolved[1].scale.x).to.equal(scale.x, GetErrorMessage(ETestErrorMsg.ScaleX));
+        expect(resolved[1].scale.y).to.equal(scale.y, GetErrorMessage(ETestErrorMsg.ScaleY));
+        expect(resolved[1].rotation).to.equal(90, GetErrorMessage(ETestErrorMsg.Rotation));
+        expect(resolved[1].crop.left).to.equal(crop.left, GetErrorMessage(ETestErrorMsg.CropLeft));
+        expect(resolved[1].crop.top).to.equal(crop.top, GetErrorMessage(ETestErrorMsg.CropTop));
+
+        // Checking that the items report the applied transforms
+        expect(firstItem.position.x).to.equal(position.x, GetErrorMessage(ETestErrorMsg.PositionX));
+        expect(secondItem.rotation).to.equal(90, GetErrorMessage(ETestErrorMsg.Rotation));
+        expect(secondItem.crop.bottom).to.equal(crop.bottom, GetErrorMessage(ETestErrorMsg.CropBottom));
+
+        source.release();
+        firstItem.remove();
+        secondItem.remove();
+    });
 });
@@ -266,6 +266,36 @@ describe(testName, () => {
         scene.release();
     });
 
+    it('Get cached properties of an input and iterate them', () => {
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'input');
+
+        // Checking if input source was created correctly
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+
+        // Getting properties twice, the second call is served by the client cache
+        const names: string[][] = [];
+        for (let idx = 0; idx < 2; idx++) {
+            const properties = input.properties;
+            expect(properties).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.Properties, EOBSInputTypes.ColorSource));
+
+            const walked: string[] = [];
+            let property = properties.first();
+            while (property) {
+                walked.push(property.name);
+                property = property.next();
+            }
+
+            // Checking if every property was reached
+            expect(walked.length).to.equal(properties.count(), GetErrorMessage(ETestErrorMsg.PropertiesCache, EOBSInputTypes.ColorSource));
+            names.push(walked);
+        }
+
+        // Checking if the cached snapshot matches the one received from the server
+        expect(names[1]).to.eql(names[0], GetErrorMessage(ETestErrorMsg.PropertiesCache, EOBSInputTypes.ColorSource));
+
+        input.release();
+    });
+
     it('Update settings of all inputs', () => {
         let settings: ISettings = {};
 
@@ -1,6 +1,9 @@
 export const enum ETestErrorMsg {
     // nodeobs_api
     GetPerformanceStatistics = 'Get performance statistics',
+    GetPerformanceSamples = 'Performance sample %VALUE1% is not valid',
+    GetOutputSamples = 'Output sample %VALUE1% is not valid',
+    GetMediaCacheStats = 'Media cache statistic %VALUE1% is not valid',
     ShowHideInputHotkeys = 'Show hide hotkey container is wrong',
     SlideShowHotkeys = 'Slideshow hotkey container is wrong',
     FFMPEGSourceHotkeys = 'FFMPEG source hotkey container is wrong',
@@ -12,6 +15,14 @@ export const enum ETestErrorMsg {
     CoreAudioInputHotkeys = 'Core Audio Input hotkey container is wrong',
     CoreAudioOutputHotkeys = 'Core Audio Output hotkey container is wrong',
 
+    // nodeobs_display
+    SharedMemoryDisplay = 'Failed to create shared memory display %VALUE1%',
+    SharedMemoryFrames = 'No frame was published by shared memory display %VALUE1%',
+    SharedMemoryFrameSize = 'Frame of shared memory display %VALUE1% has the wrong size',
+    PausedDisplayFrames = 'Paused display %VALUE1% published a frame',
+    ResumedDisplayFrames = 'No frame was published by display %VALUE1% after resuming it',
+    DirtyDisplayFrames = 'No frame was published by display %VALUE1% after marking it dirty',
+
     // nodeobs_autoconfig
     BandwidthTest = 'Bandwidth test',
     StreamEncoderTest = 'Stream encoder test',
@@ -38,6 +49,9 @@ export const enum ETestErrorMsg {
     RecordOutputStoppedWithError = 'Record ouput stopped with error | Error code: %VALUE1% / Error message: %VALUE2%',
     ReplayBufferDidNotStart = 'Replay buffer failed to start | Error code: %VALUE1% / Error message: %VALUE2%',
     ReplayBufferStoppedWithError = 'Replay buffer stopped with error | Error code: %VALUE1% / Error message: %VALUE2%',
+    RecordingStartStats = 'Recording start statistic %VALUE1% is not valid',
+    EncoderPlan = 'Encoder plan of output %VALUE1% is not valid',
+    DiskReplayBuffer = 'Disk backed replay was not saved as FLV: %VALUE1%',
     // nodeobs_settings
     GeneralSettings = 'One or more general settings failed to be updated',
     SingleGeneralSetting = 'Failed to update general setting %VALUE1%',
@@ -80,6 +94,7 @@ export const enum ETestErrorMsg {
     InputFromName = 'Failed to get input from name %VALUE1%',
     FromNameInputName = 'Input returned from name %VALUE% has wrong name',
     FromNameInputId = 'Input returned from name %VALUE1% has wrong id',
+    FindSources = 'Input %VALUE1% was not found by its type and output flags',
     Volume = 'Failed to update volume of input %VALUE1%',
     SyncOffset = 'Failed to update sync offset of input %VALUE1%',
     AudioMixers = 'Failed to update audio mixers of input %VALUE1%',
@@ -93,6 +108,9 @@ export const enum ETestErrorMsg {
     // osn-module
     OpenModule = 'Failed to open module %VALUE1%',
     Modules = 'Failed to get all opened modules',
+    // osn-profiler
+    ProfilerEnabled = 'Profiler enabled state is wrong',
+    SourceCost = 'Source cost %VALUE1% is not valid',
     // osn-scene
     CreateScene = 'Failed to create scene %VALUE1%',
     SceneId = 'Scene %VALUE1% id value is wrong',
@@ -113,6 +131,7 @@ export const enum ETestErrorMsg {
     GetSceneItems = 'Scene %VALUE1% does not have the right number of scene items',
     SceneItemPosition = 'Wrong position for scene item with input %VALUE1%',
     SceneItemPositionAfterMove = 'After moving, wrong position of scene item with input %VALUE1%',
+    LoadSceneCollection = 'Scene collection was not loaded correctly',
     // osn-sceneitem'
     GetSourceFromSceneItem = 'Failed to get source from scene item with id %VALUE1%',
     SourceFromSceneItemId = 'Source returned from scene item with id %VALUE1% has wrong id',
@@ -133,11 +152,13 @@ export const enum ETestErrorMsg {
     CropLeft = 'Failed to set crop left value',
     CropRight = 'Failed to set crop right value',
     SceneItemId = 'Falied to get scene item id',
+    ApplyTransforms = 'Batch transform of scene item %VALUE1% was not applied',
     // osn-source
     SourceId = 'Failed to get id of source %VALUE1%',
     SourceName = 'Failed to get name of source %VALUE1%',
     Configurable = 'Failed to get configurable value of source %VALUE1%',
     Properties = 'Failed to get properties values of source %VALUE1%',
+    PropertiesCache = 'Cached properties of source %VALUE1% do not match the original ones',
     Settings = 'Failed to get settings of source %VALUE1%',
     OutputFlags = 'Failed to get output flags of source %VALUE1%',
     SaveSettings = 'Failed to save settings of source %VALUE1%',
@@ -18,6 +18,49 @@ export interface IPerformanceState {
     averageTimeToRenderFrame: number;
     memoryUsage: number;
     diskSpaceAvailable: string;
+    recordingStarts: number;
+    recordingWarmStarts: number;
+    recordingStartTime: number;
+    recordingStartTimeAverage: number;
+    recordingStartTimeMax: number;
+}
+
+export interface IPerformanceSample {
+    sequence: number;
+    timestamp: number;
+    CPU: number;
+    numberDroppedFrames: number;
+    percentageDroppedFrames: number;
+    streamingBandwidth: number;
+    streamingDataOutput: number;
+    recordingBandwidth: number;
+    recordingDataOutput: number;
+    frameRate: number;
+    averageTimeToRenderFrame: number;
+    memoryUsage: number;
+    diskSpaceAvailable: number;
+}
+
+export interface IOutputStats {
+    active: boolean;
+    reconnecting: boolean;
+    bytes: number;
+    bitrate: number;
+    droppedFrames: number;
+    totalFrames: number;
+    congestion: number;
+    connectTime: number;
+    reconnects: number;
+    skippedFrames: number;
+}
+
+export interface IOutputSample {
+    sequence: number;
+    timestamp: number;
+    streaming: IOutputStats;
+    recording: IOutputStats;
+    replayBuffer: IOutputStats;
+    virtualWebcam: IOutputStats;
 }
 
 export interface IOBSOutputSignalInfo {